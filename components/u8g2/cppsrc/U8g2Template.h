@@ -0,0 +1,434 @@
+/*
+
+  U8g2Template.h
+
+  Compile time specialized C++ front end for the u8g2 struct and c functions
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Note:
+  The U8G2 class calls every pixel operation through the function pointers of
+  the u8g2 struct (cb->draw_l90, ll_hvline) and sends the buffer through
+  display_cb, cad_cb and byte_cb. U8G2_TEMPLATE is parameterized by
+
+    CONTROLLER	display size, C setup and the byte sequence of SendBuffer
+    LAYOUT		memory layout of the full frame buffer
+    ROTATION	U8G2_R0 ... U8G2_R3
+    TRANSPORT	start/send/end of a byte transfer
+
+  so that drawPixel, drawHLine, drawVLine, drawBox, drawFrame and sendBuffer
+  are resolved at compile time and can be inlined. The u8g2 struct is set up
+  with the matching C procedures, all other functions (fonts, circles,
+  bitmaps, init sequence, power save) use the C API through getU8g2().
+  Only full frame buffers are supported.
+
+  This file does not depend on Arduino.h.
+
+*/
+
+
+#ifndef U8G2TEMPLATE_HH
+#define U8G2TEMPLATE_HH
+
+#include <string.h>
+#include "u8g2.h"
+
+/*==========================================*/
+/* memory layout */
+
+/* bytes are vertical, lsb on top, used by SSD13xx, SH1106, UC1701, ... */
+struct U8G2_LAYOUT_VERTICAL_TOP_LSB
+{
+  static u8g2_draw_ll_hvline_cb hvlineCb(void) { return u8g2_ll_hvline_vertical_top_lsb; }
+
+  /* apply draw color 0, 1 or 2 to w bytes, same as u8g2_ll_fill_bytes() */
+  static inline void row(uint8_t *ptr, u8g2_uint_t w, uint8_t mask, uint8_t color)
+  {
+    uint8_t or_mask = color <= 1 ? mask : 0;
+    uint8_t xor_mask = color != 1 ? mask : 0;
+    uint32_t *ptr32;
+
+    if ( or_mask == 0x0ff )
+    {
+      memset(ptr, (uint8_t)~xor_mask, w);
+      return;
+    }
+    for( ; w != 0 && ((uintptr_t)ptr & 3) != 0; w-- )
+    {
+      *ptr |= or_mask;
+      *ptr++ ^= xor_mask;
+    }
+    for( ptr32 = (uint32_t *)ptr; w >= 4; w -= 4 )
+    {
+      *ptr32 |= or_mask * 0x01010101UL;
+      *ptr32++ ^= xor_mask * 0x01010101UL;
+    }
+    for( ptr = (uint8_t *)ptr32; w != 0; w-- )
+    {
+      *ptr |= or_mask;
+      *ptr++ ^= xor_mask;
+    }
+  }
+
+  /* x, y, w, h are clipped buffer coordinates */
+  template <uint16_t WIDTH>
+  static inline void box(uint8_t *buf, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+  {
+    uint8_t *ptr = buf + (uint16_t)(y >> 3) * WIDTH + x;
+    uint16_t yy = y & ~7;
+    uint16_t y1 = (uint16_t)y + h;
+    uint8_t mask = (uint8_t)(0x0ff << (y & 7));
+    for(;;)
+    {
+      if ( y1 < yy + 8 )
+	mask &= (uint8_t)(0x0ff >> (yy + 8 - y1));
+      row(ptr, w, mask, color);
+      yy += 8;
+      if ( yy >= y1 )
+	break;
+      ptr += WIDTH;
+      mask = 0x0ff;
+    }
+  }
+};
+
+/*==========================================*/
+/* rotation */
+
+/*
+  box() receives a box in user coordinates, which is already clipped
+  against the user window, and draws it in buffer coordinates.
+  WIDTH and HEIGHT are the size of the display (not the rotated size).
+*/
+struct U8G2_ROTATION_R0
+{
+  static const u8g2_cb_t *cb(void) { return U8G2_R0; }
+  template <class LAYOUT, uint16_t WIDTH, uint16_t HEIGHT>
+  static inline void box(uint8_t *buf, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+  {
+    LAYOUT::template box<WIDTH>(buf, x, y, w, h, color);
+  }
+};
+
+struct U8G2_ROTATION_R1
+{
+  static const u8g2_cb_t *cb(void) { return U8G2_R1; }
+  template <class LAYOUT, uint16_t WIDTH, uint16_t HEIGHT>
+  static inline void box(uint8_t *buf, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+  {
+    LAYOUT::template box<WIDTH>(buf, WIDTH - y - h, x, h, w, color);
+  }
+};
+
+struct U8G2_ROTATION_R2
+{
+  static const u8g2_cb_t *cb(void) { return U8G2_R2; }
+  template <class LAYOUT, uint16_t WIDTH, uint16_t HEIGHT>
+  static inline void box(uint8_t *buf, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+  {
+    LAYOUT::template box<WIDTH>(buf, WIDTH - x - w, HEIGHT - y - h, w, h, color);
+  }
+};
+
+struct U8G2_ROTATION_R3
+{
+  static const u8g2_cb_t *cb(void) { return U8G2_R3; }
+  template <class LAYOUT, uint16_t WIDTH, uint16_t HEIGHT>
+  static inline void box(uint8_t *buf, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+  {
+    LAYOUT::template box<WIDTH>(buf, y, HEIGHT - x - w, h, w, color);
+  }
+};
+
+/*==========================================*/
+/* byte transport */
+
+/*
+  direct calls to the byte and gpio procedures of a u8x8 setup,
+  e.g. U8G2_TRANSPORT_CB<u8x8_byte_arduino_hw_i2c, u8x8_gpio_and_delay_arduino>
+*/
+template <u8x8_msg_cb BYTE_CB, u8x8_msg_cb GPIO_AND_DELAY_CB>
+struct U8G2_TRANSPORT_CB
+{
+  static u8x8_msg_cb byteCb(void) { return BYTE_CB; }
+  static u8x8_msg_cb gpioAndDelayCb(void) { return GPIO_AND_DELAY_CB; }
+  static inline void start(u8x8_t *u8x8) { BYTE_CB(u8x8, U8X8_MSG_BYTE_START_TRANSFER, 0, NULL); }
+  static inline void send(u8x8_t *u8x8, uint8_t cnt, const uint8_t *data) { BYTE_CB(u8x8, U8X8_MSG_BYTE_SEND, cnt, (void *)data); }
+  static inline void end(u8x8_t *u8x8) { BYTE_CB(u8x8, U8X8_MSG_BYTE_END_TRANSFER, 0, NULL); }
+};
+
+/*==========================================*/
+/* controller */
+
+/*
+  SSD1306 128x64 in I2C mode, same init sequence and same byte stream as
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f() with u8x8_cad_ssd13xx_fast_i2c()
+*/
+struct U8G2_CONTROLLER_SSD1306_128X64_NONAME_I2C
+{
+  enum { tile_width = 16, tile_height = 8 };
+
+  static void setupDisplay(u8g2_t *u8g2, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+  {
+    u8g2_SetupDisplay(u8g2, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_fast_i2c, byte_cb, gpio_and_delay_cb);
+  }
+
+  template <class TRANSPORT>
+  static void sendBuffer(u8x8_t *u8x8, const uint8_t *buf)
+  {
+    uint8_t cmd[4];
+    uint8_t chunk, row;
+    uint16_t cnt;
+
+    /* data bytes per i2c transfer, see u8x8_i2c_data_chunk_size() */
+    chunk = 24;
+    if ( u8x8->byte_max_transfer > 1 )
+      chunk = u8x8->byte_max_transfer-1;
+
+    for( row = 0; row < tile_height; row++ )
+    {
+      cmd[0] = 0x000;		/* cmd byte for ssd13xx controller */
+      cmd[1] = 0x040;		/* set line offset to 0 */
+      TRANSPORT::start(u8x8);
+      TRANSPORT::send(u8x8, 2, cmd);
+      TRANSPORT::end(u8x8);
+
+      cmd[1] = 0x010 | (u8x8->x_offset>>4);
+      cmd[2] = u8x8->x_offset&15;
+      cmd[3] = 0x0b0 | row;
+      TRANSPORT::start(u8x8);
+      TRANSPORT::send(u8x8, 4, cmd);
+      TRANSPORT::end(u8x8);
+
+      cmd[0] = 0x040;		/* data byte for ssd13xx controller */
+      cnt = tile_width*8;
+      for(;;)
+      {
+	TRANSPORT::start(u8x8);
+	TRANSPORT::send(u8x8, 1, cmd);
+	if ( cnt <= chunk )
+	  break;
+	TRANSPORT::send(u8x8, chunk, buf);
+	TRANSPORT::end(u8x8);
+	buf += chunk;
+	cnt -= chunk;
+      }
+      TRANSPORT::send(u8x8, cnt, buf);
+      TRANSPORT::end(u8x8);
+      buf += cnt;
+    }
+  }
+};
+
+/*==========================================*/
+
+template <class CONTROLLER, class LAYOUT, class ROTATION, class TRANSPORT>
+class U8G2_TEMPLATE
+{
+  public:
+    enum { pixel_width = CONTROLLER::tile_width*8, pixel_height = CONTROLLER::tile_height*8 };
+
+  protected:
+    u8g2_t u8g2;
+    uint8_t buf[CONTROLLER::tile_width*CONTROLLER::tile_height*8];
+
+    /* same as u8g2_clip_intersection2() */
+    static inline uint8_t clip(u8g2_uint_t *ap, u8g2_uint_t *len, u8g2_uint_t c, u8g2_uint_t d)
+    {
+      u8g2_uint_t a = *ap;
+      u8g2_uint_t b = a;
+      b += *len;
+      if ( a > b )
+      {
+	if ( a < d )
+	{
+	  b = d;
+	  b--;
+	}
+	else
+	{
+	  a = c;
+	}
+      }
+      if ( a >= d )
+	return 0;
+      if ( b <= c )
+	return 0;
+      if ( a < c )
+	a = c;
+      if ( b > d )
+	b = d;
+      *ap = a;
+      b -= a;
+      *len = b;
+      return 1;
+    }
+
+    /* same as u8g2_is_intersection_decision_tree() */
+    static inline uint8_t isIntersection(u8g2_uint_t a0, u8g2_uint_t a1, u8g2_uint_t v0, u8g2_uint_t v1)
+    {
+      if ( v0 < a1 )
+	return v1 > a0 || v0 > v1;
+      return v1 > a0 && v0 > v1;
+    }
+
+    inline uint8_t isPageClipWindowIntersection(void)
+    {
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+      return u8g2.is_page_clip_window_intersection;
+#else
+      return 1;
+#endif
+    }
+
+    inline void drawUserBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+    {
+      ROTATION::template box<LAYOUT, pixel_width, pixel_height>(buf, x, y, w, h, u8g2.draw_color);
+    }
+
+    /* rows y0 to y1 (excluded) of a box, x and w are already clipped */
+    inline void drawBoxRows(u8g2_uint_t x, u8g2_uint_t w, u8g2_uint_t y0, u8g2_uint_t y1)
+    {
+      if ( y0 < u8g2.user_y0 )
+	y0 = u8g2.user_y0;
+      if ( y1 > u8g2.user_y1 )
+	y1 = u8g2.user_y1;
+      if ( y0 >= y1 )
+	return;
+      drawUserBox(x, y0, w, y1 - y0);
+    }
+
+  public:
+    U8G2_TEMPLATE(void)
+    {
+      CONTROLLER::setupDisplay(&u8g2, TRANSPORT::byteCb(), TRANSPORT::gpioAndDelayCb());
+      u8g2_SetupBuffer(&u8g2, buf, CONTROLLER::tile_height, LAYOUT::hvlineCb(), ROTATION::cb());
+    }
+
+    u8x8_t *getU8x8(void) { return u8g2_GetU8x8(&u8g2); }
+    u8g2_t *getU8g2(void) { return &u8g2; }
+    uint8_t *getBufferPtr(void) { return buf; }
+
+    u8g2_uint_t getDisplayHeight(void) { return u8g2_GetDisplayHeight(&u8g2); }
+    u8g2_uint_t getDisplayWidth(void) { return u8g2_GetDisplayWidth(&u8g2); }
+
+    void begin(void)
+    {
+      u8g2_InitDisplay(&u8g2);
+      u8g2_ClearDisplay(&u8g2);
+      u8g2_SetPowerSave(&u8g2, 0);
+    }
+    void setPowerSave(uint8_t is_enable) { u8g2_SetPowerSave(&u8g2, is_enable); }
+    void setContrast(uint8_t value) { u8g2_SetContrast(&u8g2, value); }
+
+    void clearBuffer(void) { memset(buf, 0, sizeof(buf)); }
+    void sendBuffer(void)
+    {
+      /* display RAM will differ from the shadow buffer after this, see u8g2_send_buffer() */
+      u8g2.is_shadow_buf_valid = 0;
+      CONTROLLER::template sendBuffer<TRANSPORT>(u8g2_GetU8x8(&u8g2), buf);
+    }
+
+    void setDrawColor(uint8_t color_index) { u8g2_SetDrawColor(&u8g2, color_index); }
+
+    /* same result as u8g2_DrawHVLine() for dir 0 and 1 */
+    inline void drawHVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+    {
+      if ( isPageClipWindowIntersection() == 0 || len == 0 )
+	return;
+      if ( dir == 0 )
+      {
+	if ( y < u8g2.user_y0 || y >= u8g2.user_y1 )
+	  return;
+	if ( clip(&x, &len, u8g2.user_x0, u8g2.user_x1) == 0 )
+	  return;
+	drawUserBox(x, y, len, 1);
+      }
+      else
+      {
+	if ( x < u8g2.user_x0 || x >= u8g2.user_x1 )
+	  return;
+	if ( clip(&y, &len, u8g2.user_y0, u8g2.user_y1) == 0 )
+	  return;
+	drawUserBox(x, y, 1, len);
+      }
+    }
+
+    void drawPixel(u8g2_uint_t x, u8g2_uint_t y) { drawHVLine(x, y, 1, 0); }
+    void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w) { drawHVLine(x, y, w, 0); }
+    void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h) { drawHVLine(x, y, h, 1); }
+
+    /* same result as u8g2_DrawBox() */
+    void drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+    {
+      u8g2_uint_t y1;
+      if ( isPageClipWindowIntersection() == 0 || w == 0 || h == 0 )
+	return;
+#ifdef U8G2_WITH_INTERSECTION
+      if ( isIntersection(u8g2.user_y0, u8g2.user_y1, y, y+h) == 0 || isIntersection(u8g2.user_x0, u8g2.user_x1, x, x+w) == 0 )
+	return;
+#endif /* U8G2_WITH_INTERSECTION */
+      if ( clip(&x, &w, u8g2.user_x0, u8g2.user_x1) == 0 )
+	return;
+      y1 = y;
+      y1 += h;
+      if ( y1 < y )
+      {
+	/* the box wraps around: lower part starts at 0 */
+	drawBoxRows(x, w, 0, y1);
+	y1 = u8g2.user_y1;
+      }
+      drawBoxRows(x, w, y, y1);
+    }
+
+    /* same result as u8g2_DrawFrame() */
+    void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+    {
+#ifdef U8G2_WITH_INTERSECTION
+      if ( isIntersection(u8g2.user_y0, u8g2.user_y1, y, y+h) == 0 || isIntersection(u8g2.user_x0, u8g2.user_x1, x, x+w) == 0 )
+	return;
+#endif /* U8G2_WITH_INTERSECTION */
+      drawHVLine(x, y, w, 0);
+      drawHVLine(x, y, h, 1);
+      drawHVLine(x+w-1, y, h, 1);
+      drawHVLine(x, y+h-1, w, 0);
+    }
+
+    /* text and everything else uses the C API */
+    void setFont(const uint8_t *font) { u8g2_SetFont(&u8g2, font); }
+    void setFontMode(uint8_t is_transparent) { u8g2_SetFontMode(&u8g2, is_transparent); }
+    u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char *s) { return u8g2_DrawStr(&u8g2, x, y, s); }
+    u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char *s) { return u8g2_DrawUTF8(&u8g2, x, y, s); }
+    u8g2_uint_t getStrWidth(const char *s) { return u8g2_GetStrWidth(&u8g2, s); }
+};
+
+#endif /* U8G2TEMPLATE_HH */
+
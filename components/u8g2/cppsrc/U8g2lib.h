@@ -50,6 +50,7 @@
 #include "U8x8lib.h"
 
 #include "u8g2.h"
+#include "U8g2Template.h"
 
 class U8G2 : public Print
 {
@@ -14927,6 +14928,14 @@ class U8G2_MAX7219_8X8_F_2ND_4W_HW_SPI : public U8G2 {
 
 /* Arduino constructor list end */
 
+/* compile time specialized version of U8G2_SSD1306_128X64_NONAME_F_HW_I2C, see U8g2Template.h */
+template <class ROTATION>
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C_T : public U8G2_TEMPLATE<U8G2_CONTROLLER_SSD1306_128X64_NONAME_I2C, U8G2_LAYOUT_VERTICAL_TOP_LSB, ROTATION, U8G2_TRANSPORT_CB<u8x8_byte_arduino_hw_i2c, u8x8_gpio_and_delay_arduino> > {
+  public: U8G2_SSD1306_128X64_NONAME_F_HW_I2C_T(uint8_t reset = U8X8_PIN_NONE, uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) {
+    u8x8_SetPin_HW_I2C(this->getU8x8(), reset, clock, data);
+  }
+};
+
 #endif // U8X8_USE_PINS
 
 class U8G2_BITMAP : public U8G2 {
@@ -139,6 +139,61 @@
 */
 #define U8G2_WITH_UNICODE
 
+/*
+  The following macro enables the optional glyph cache:
+    void u8g2_SetGlyphCache(u8g2_t *u8g2, u8g2_glyph_cache_t *cache, u8g2_glyph_cache_entry_t *entries, uint8_t cnt)
+  Decoded glyphs are kept in the vertical top buffer layout and copied
+  directly into the buffer, the font decoder only runs for cache misses.
+  The cache is only used for U8G2_R0, font direction 0 and the vertical top
+  memory layout (all SSD13xx and most other displays).
+  Without a call to u8g2_SetGlyphCache the cache is not used.
+*/
+#define U8G2_WITH_GLYPH_CACHE
+
+/*
+  The following macro enables a faster glyph decoder for U8G2_R0, font
+  direction 0 and the vertical top memory layout: The run length code of
+  the glyph is decoded into column bytes, which are combined with the
+  buffer, instead of drawing each run with u8g2_DrawHVLine.
+  Glyphs wider than U8G2_TILE_GLYPH_MAX_WIDTH use the generic decoder.
+*/
+#define U8G2_WITH_TILE_GLYPH_DECODE
+#define U8G2_TILE_GLYPH_MAX_WIDTH 64
+
+/*
+  The following macro enables the rotations U8G2_R1_FLUSH, U8G2_R2_FLUSH,
+  U8G2_R3_FLUSH and U8G2_MIRROR_FLUSH for the vertical top memory layout.
+  All drawing is done like U8G2_R0 into the buffer, the tiles are rotated
+  (8x8 bit transpose, bit reversal) while the buffer is sent to the display.
+  U8G2_R1_FLUSH and U8G2_R3_FLUSH require full buffer mode, pixel width and
+  height of the display must be a multiple of 8.
+  Displays wider than U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH tiles are not
+  supported, U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH*8 bytes are used on the stack.
+*/
+#define U8G2_WITH_FLUSH_ROTATION
+#define U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH 32
+
+/*
+  The following macro enables the text layout:
+    u8g2_uint_t u8g2_LayoutStr(u8g2_t *u8g2, u8g2_text_t *text, const char *str)
+    u8g2_uint_t u8g2_DrawText(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_text_t *text)
+  u8g2_LayoutStr() keeps a copy of the string, its width, extent and the
+  glyph data of each char in text. This is only done again if the string
+  or the current font differs from the last call, so a label which is drawn
+  every frame is measured and looked up once.
+  Strings with more than U8G2_TEXT_MAX_LEN bytes are measured with each call
+  and drawn with u8g2_DrawStr(), the string must stay valid until then.
+  Multi line text:
+    uint8_t u8g2_LayoutUTF8Box(u8g2_t *u8g2, u8g2_text_box_t *box, const char *str, u8g2_uint_t max_width, uint8_t max_lines)
+    void u8g2_DrawTextBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t line_height, const u8g2_text_box_t *box, uint8_t align)
+  The UTF-8 string is wrapped at spaces, after '-' and around CJK glyphs
+  into lines of max_width pixel. Words wider than a line are split with a
+  '-', text which does not fit into max_lines ends with an ellipsis.
+  Only the first U8G2_TEXT_BOX_MAX_LEN bytes of the string are used, a
+  UTF-8 sequence cut there is left out.
+*/
+#define U8G2_WITH_TEXT_LAYOUT
+
 
 
 
@@ -189,6 +244,8 @@ typedef void (*u8g2_update_dimension_cb)(u8g2_t *u8g2);
 typedef void (*u8g2_update_page_win_cb)(u8g2_t *u8g2);
 typedef void (*u8g2_draw_l90_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+/* write the display tiles for tile row src_tile_row of buf to dest, returns the display tile row */
+typedef uint8_t (*u8g2_rotate_tile_row_cb)(u8g2_t *u8g2, const uint8_t *buf, uint8_t src_tile_row, uint8_t *dest);
 
 typedef uint8_t (*u8g2_get_kerning_cb)(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 
@@ -229,6 +286,9 @@ struct _u8g2_font_info_t
 #ifdef U8G2_WITH_UNICODE  
   uint16_t start_pos_unicode;
 #endif
+
+  /* font format 3 (bdfconv -f 3), not part of the font header */
+  uint32_t glyph_index_pos;	/* position of the glyph index after the font header, 0 if the font has no glyph index */
 };
 typedef struct _u8g2_font_info_t u8g2_font_info_t;
 
@@ -266,14 +326,196 @@ struct _u8g2_kerning_t
 };
 typedef struct _u8g2_kerning_t u8g2_kerning_t;
 
+/*
+  off-screen text strip, see u8g2_strip.c
+  the strip is split into chunks which have the same width and memory layout
+  as the display buffer, so that u8g2 can render into each chunk
+*/
+struct _u8g2_strip_t
+{
+  uint8_t *buf;			/* chunk_cnt * tile_rows * chunk_width bytes */
+  uint16_t width;		/* pixel width of the rendered string */
+  u8g2_uint_t chunk_width;	/* pixel width of one chunk, equal to pixel_buf_width */
+  uint8_t chunk_cnt;
+  uint8_t tile_rows;		/* height of the strip in tile rows */
+  uint8_t ascent;		/* distance from the top of the strip to the baseline */
+};
+typedef struct _u8g2_strip_t u8g2_strip_t;
+
+/*
+  display list for the page buffer mode, see u8g2_dlist.c
+*/
+struct _u8g2_dlist_t
+{
+  uint8_t *buf;
+  uint16_t size;		/* size of buf in bytes */
+  uint16_t len;			/* number of recorded bytes */
+  uint8_t is_overflow;		/* a command did not fit into buf and is missing */
+};
+typedef struct _u8g2_dlist_t u8g2_dlist_t;
+
+/*
+  horizontal spans of a filled shape, see u8g2_span.c
+*/
+struct _u8g2_span_t
+{
+  u8g2_t *u8g2;
+  int16_t x0, x1;		/* visible columns x0..x1-1 */
+  int16_t y0, y1;		/* visible rows y0..y1-1 */
+  uint8_t is_vertical_top;	/* collect tile rows for u8g2_ll_spans_vertical_top_lsb() */
+  uint8_t row_mask;		/* rows of the current tile row with a span */
+  u8g2_uint_t tile_y;		/* first row of the current tile row in the local buffer */
+  u8g2_uint_t row_x0[8];
+  u8g2_uint_t row_x1[8];
+};
+typedef struct _u8g2_span_t u8g2_span_t;
+
+/*
+  polygon, see u8g2_polygon.c
+  the caller provides one edge for each point
+*/
+struct _u8g2_pg_edge_t
+{
+  int16_t x1, y1;		/* upper end point */
+  int16_t x2, y2;		/* lower end point, y2 > y1 */
+  /* scan line state, set when the edge is reached */
+  int16_t x;
+  int16_t x_step;
+  int16_t err;
+  int16_t err_step;
+  int16_t height;
+  int8_t x_dir;
+};
+typedef struct _u8g2_pg_edge_t u8g2_pg_edge_t;
+
+struct _u8g2_polygon_t
+{
+  u8g2_pg_edge_t *edge;
+  uint16_t max_cnt;		/* number of entries in edge */
+  uint16_t cnt;			/* number of points */
+  uint16_t edge_cnt;		/* without horizontal edges and the closing edge */
+  int16_t first_x, first_y;
+  int16_t last_x, last_y;
+};
+typedef struct _u8g2_polygon_t u8g2_polygon_t;
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+/* max bytes of a decoded glyph: glyph width * tile rows, e.g. 16x16 pixel */
+#ifndef U8G2_GLYPH_CACHE_DATA_SIZE
+#define U8G2_GLYPH_CACHE_DATA_SIZE 32
+#endif
+
+struct _u8g2_glyph_cache_entry_t
+{
+  const uint8_t *font;		/* NULL: unused entry */
+  uint16_t encoding;
+  uint16_t last_used;		/* cache clock value of the last hit */
+  int8_t x;				/* glyph offset, same as in the font data */
+  int8_t y;
+  int8_t delta_x;
+  uint8_t width;			/* glyph bitmap size in pixel */
+  uint8_t height;
+  uint8_t data[U8G2_GLYPH_CACHE_DATA_SIZE];	/* tile rows of width bytes, vertical top layout */
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+
+struct _u8g2_glyph_cache_t
+{
+  u8g2_glyph_cache_entry_t *entries;
+  uint8_t cnt;
+  uint16_t clock;
+  uint32_t hits;
+  uint32_t misses;		/* glyph decoded into the cache */
+  uint32_t bypass;		/* glyph too large or cache not usable, drawn by the decoder */
+};
+typedef struct _u8g2_glyph_cache_t u8g2_glyph_cache_t;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+#ifdef U8G2_WITH_TEXT_LAYOUT
+#ifndef U8G2_TEXT_MAX_LEN
+#define U8G2_TEXT_MAX_LEN 32
+#endif
+
+struct _u8g2_text_glyph_t
+{
+  const uint8_t *data;		/* result of u8g2_font_get_glyph_data(), NULL: no glyph in the font */
+  uint16_t encoding;
+  int8_t delta_x;
+};
+typedef struct _u8g2_text_glyph_t u8g2_text_glyph_t;
+
+struct _u8g2_text_t
+{
+  const uint8_t *font;		/* font of the layout, NULL: nothing laid out */
+  const char *long_str;		/* string longer than U8G2_TEXT_MAX_LEN, not laid out */
+  u8g2_uint_t width;		/* same as u8g2_GetStrWidth() */
+  int8_t ascent;		/* highest pixel of all glyphs above the baseline */
+  int8_t descent;		/* lowest pixel of all glyphs, negative below the baseline */
+  uint8_t cnt;			/* number of glyphs */
+  char str[U8G2_TEXT_MAX_LEN+1];
+  u8g2_text_glyph_t glyph[U8G2_TEXT_MAX_LEN];
+};
+typedef struct _u8g2_text_t u8g2_text_t;
+
+#ifndef U8G2_TEXT_BOX_MAX_LEN
+#define U8G2_TEXT_BOX_MAX_LEN 80
+#endif
+#ifndef U8G2_TEXT_BOX_MAX_LINES
+#define U8G2_TEXT_BOX_MAX_LINES 4
+#endif
+
+#define U8G2_TEXT_SUFFIX_NONE 0
+#define U8G2_TEXT_SUFFIX_HYPHEN 1
+#define U8G2_TEXT_SUFFIX_ELLIPSIS 2
+
+#define U8G2_TEXT_ALIGN_LEFT 0
+#define U8G2_TEXT_ALIGN_CENTER 1
+#define U8G2_TEXT_ALIGN_RIGHT 2
+
+struct _u8g2_text_line_t
+{
+  uint8_t start;		/* first glyph of the line */
+  uint8_t cnt;			/* number of glyphs */
+  uint8_t suffix;		/* U8G2_TEXT_SUFFIX_NONE, _HYPHEN or _ELLIPSIS */
+  u8g2_uint_t width;		/* sum of the delta x values including the suffix */
+};
+typedef struct _u8g2_text_line_t u8g2_text_line_t;
+
+struct _u8g2_text_box_t
+{
+  const uint8_t *font;		/* font of the layout, NULL: nothing laid out */
+  u8g2_uint_t max_width;
+  uint8_t max_lines;
+  uint8_t line_cnt;
+  uint8_t glyph_cnt;
+  uint8_t ellipsis_cnt;		/* 1: U+2026, 3: "...", 0: not available in the font */
+  u8g2_text_glyph_t hyphen;
+  u8g2_text_glyph_t ellipsis;
+  char str[U8G2_TEXT_BOX_MAX_LEN+1];
+  u8g2_text_glyph_t glyph[U8G2_TEXT_BOX_MAX_LEN];
+  u8g2_text_line_t line[U8G2_TEXT_BOX_MAX_LINES];
+};
+typedef struct _u8g2_text_box_t u8g2_text_box_t;
+#endif /* U8G2_WITH_TEXT_LAYOUT */
+
 
 struct u8g2_cb_struct
 {
   u8g2_update_dimension_cb update_dimension;
   u8g2_update_page_win_cb update_page_win;
   u8g2_draw_l90_cb draw_l90;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  u8g2_rotate_tile_row_cb rotate_tile_row;	/* NULL: the buffer is sent as it is */
+#endif /* U8G2_WITH_FLUSH_ROTATION */
 };
 
+/* last member of a u8g2_cb_t initializer without flush rotation */
+#ifdef U8G2_WITH_FLUSH_ROTATION
+#define U8G2_CB_NO_FLUSH_ROTATION , NULL
+#else
+#define U8G2_CB_NO_FLUSH_ROTATION
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
 typedef u8g2_uint_t (*u8g2_font_calc_vref_fnptr)(u8g2_t *u8g2);
 
 
@@ -349,6 +591,18 @@ struct u8g2_struct
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
   
+  /* dirty tile tracking for u8g2_SendBufferChanged(), full buffer mode only */
+  uint8_t *shadow_buf_ptr;	/* copy of the last frame sent to the display, same size as tile_buf_ptr, NULL if not used */
+  uint8_t is_shadow_buf_valid;	/* 0: shadow_buf_ptr does not match the display RAM, next u8g2_SendBufferChanged() will send all tiles */
+  
+  /* hardware scroll, see u8g2_StartScroll() */
+  uint8_t is_scroll_active;	/* 1: tile rows scroll_ty_start..scroll_ty_end are moved by the display */
+  uint8_t scroll_ty_start;
+  uint8_t scroll_ty_end;
+  
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2_glyph_cache_t *glyph_cache;	/* NULL if not used */
+#endif /* U8G2_WITH_GLYPH_CACHE */
 };
 
 #define u8g2_GetU8x8(u8g2) ((u8x8_t *)(u8g2))
@@ -407,6 +661,26 @@ extern const u8g2_cb_t u8g2_cb_mirror;
 #define U8G2_R2	(&u8g2_cb_r2)
 #define U8G2_R3	(&u8g2_cb_r3)
 #define U8G2_MIRROR	(&u8g2_cb_mirror)
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+extern const u8g2_cb_t u8g2_cb_r1_flush;
+extern const u8g2_cb_t u8g2_cb_r2_flush;
+extern const u8g2_cb_t u8g2_cb_r3_flush;
+extern const u8g2_cb_t u8g2_cb_mirror_flush;
+
+/* same result as U8G2_R1 ... U8G2_MIRROR, rotated while the buffer is sent */
+#define U8G2_R1_FLUSH	(&u8g2_cb_r1_flush)
+#define U8G2_R2_FLUSH	(&u8g2_cb_r2_flush)
+#define U8G2_R3_FLUSH	(&u8g2_cb_r3_flush)
+#define U8G2_MIRROR_FLUSH	(&u8g2_cb_mirror_flush)
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
+/* 
+  true if the buffer is drawn like U8G2_R0: U8G2_R0 and all U8G2_..._FLUSH rotations.
+  For U8G2_R1_FLUSH and U8G2_R3_FLUSH the buffer width (pixel_buf_width) differs 
+  from the display width.
+*/
+#define u8g2_is_r0_buffer(u8g2) ((u8g2)->cb->draw_l90 == u8g2_draw_l90_r0)
 /*
   u8g2:			A new, not yet initialized u8g2 memory areay
   buf:			Memory are of size tile_buf_height*<width of the display in pixel>
@@ -1180,6 +1454,14 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th);
 void u8g2_UpdateDisplay(u8g2_t *u8g2);
 
+void u8g2_SetShadowBufferPtr(u8g2_t *u8g2, uint8_t *buf);
+#define u8g2_InvalidateShadowBuffer(u8g2) ((u8g2)->is_shadow_buf_valid = 0)
+uint16_t u8g2_SendBufferChanged(u8g2_t *u8g2);
+uint16_t u8g2_SendFrameChanged(u8g2_t *u8g2, uint8_t *frame);
+uint8_t *u8g2_SwapBufferPtr(u8g2_t *u8g2, uint8_t *buf);
+uint8_t u8g2_StartScroll(u8g2_t *u8g2, uint8_t ty_start, uint8_t ty_end, uint8_t dir, uint8_t speed);
+void u8g2_StopScroll(u8g2_t *u8g2);
+
 void u8g2_WriteBufferPBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
 /* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
@@ -1200,6 +1482,10 @@ void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s));
 
 /* SSD13xx, UC17xx, UC16xx */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+/* filled box within the local buffer, w and h must not be 0, all clipping done */
+void u8g2_ll_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+/* horizontal spans of up to 8 rows within one tile row, all clipping done */
+void u8g2_ll_spans_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t y, uint8_t cnt, const u8g2_uint_t *x0, const u8g2_uint_t *x1);
 /* ST7920 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
@@ -1210,6 +1496,9 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
 /* u8g2_DrawHVLine does not use u8g2_IsIntersection */
 void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
+/* filled box for u8g2_is_r0_buffer() and u8g2_ll_hvline_vertical_top_lsb, clips against the user window */
+void u8g2_draw_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+
 /* the following three function will do an intersection test of this is enabled with U8G2_WITH_INTERSECTION */
 void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
 void u8g2_DrawVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
@@ -1224,6 +1513,9 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
 void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* assumes bitmap in PROGMEM */
+void u8g2_DrawTileBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* vertical top layout, (h+7)/8 rows of w bytes */
+/* bit c of row[r] becomes bit r of col[c] */
+void u8g2_transpose_8x8(const uint8_t *row, uint8_t *col);
 
 
 /*==========================================*/
@@ -1245,6 +1537,8 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
 void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
 void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
 void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+/* four quarter discs for u8g2_DrawRBox() */
+void u8g2_draw_disc_corners(u8g2_t *u8g2, u8g2_uint_t xl, u8g2_uint_t yu, u8g2_uint_t xr, u8g2_uint_t yl, u8g2_uint_t rad);
 
 /*==========================================*/
 /* u8g2_line.c */
@@ -1259,8 +1553,20 @@ void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
 void u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
 
 
+/*==========================================*/
+/* u8g2_span.c */
+void u8g2_span_init(u8g2_t *u8g2, u8g2_span_t *s);
+void u8g2_span_add(u8g2_span_t *s, int16_t y, int16_t x0, int16_t x1);
+void u8g2_span_flush(u8g2_span_t *s);
+
+
 /*==========================================*/
 /* u8g2_polygon.c */
+void u8g2_InitPolygon(u8g2_polygon_t *pg, u8g2_pg_edge_t *edge, uint16_t max_cnt);
+void u8g2_ClearPolygon(u8g2_polygon_t *pg);
+void u8g2_AddPolygonPoint(u8g2_polygon_t *pg, int16_t x, int16_t y);
+void u8g2_FillPolygon(u8g2_t *u8g2, u8g2_polygon_t *pg);
+/* shared polygon with at most 6 points, not reentrant */
 void u8g2_ClearPolygonXY(void);
 void u8g2_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
 void u8g2_DrawPolygon(u8g2_t *u8g2);
@@ -1268,8 +1574,38 @@ void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t
 
 
 
+/*==========================================*/
+/* u8g2_strip.c */
+uint8_t u8g2_GetStripTileRows(u8g2_t *u8g2);
+uint16_t u8g2_DrawStrStrip(u8g2_t *u8g2, u8g2_strip_t *strip, uint8_t *buf, uint16_t buf_size, const char *str);
+void u8g2_DrawStrip(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, const u8g2_strip_t *strip, uint16_t sx);
+
+/*==========================================*/
+/* u8g2_dlist.c */
+void u8g2_InitDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t *buf, uint16_t size);
+void u8g2_ClearDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl);
+void u8g2_DLSetDrawColor(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t color);
+void u8g2_DLSetFontMode(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t is_transparent);
+void u8g2_DLSetBitmapMode(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t is_transparent);
+void u8g2_DLSetFont(u8g2_t *u8g2, u8g2_dlist_t *dl, const uint8_t *font);
+void u8g2_DLDrawBox(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_DLDrawFrame(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_DLDrawHLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
+void u8g2_DLDrawVLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
+void u8g2_DLDrawLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2);
+void u8g2_DLDrawCircle(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+void u8g2_DLDrawDisc(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+u8g2_uint_t u8g2_DLDrawStr(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+u8g2_uint_t u8g2_DLDrawUTF8(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+void u8g2_DLDrawGlyph(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+void u8g2_DLDrawXBM(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+void u8g2_DLDrawTileBitmap(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+void u8g2_DrawDisplayList(u8g2_t *u8g2, const u8g2_dlist_t *dl);
+
 /*==========================================*/
 /* u8g2_kerning.c */
+/* first element of a sorted kerning table, see u8g2_GetKerningByTable() */
+#define U8G2_KERNING_SORTED_TABLE 0x0fffe
 //uint8_t u8g2_GetNullKerning(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 uint8_t u8g2_GetKerning(u8g2_t *u8g2, u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2);
 uint8_t u8g2_GetKerningByTable(u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2);
@@ -1290,6 +1626,10 @@ void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+#ifdef U8G2_WITH_GLYPH_CACHE
+void u8g2_SetGlyphCache(u8g2_t *u8g2, u8g2_glyph_cache_t *cache, u8g2_glyph_cache_entry_t *entries, uint8_t cnt);
+void u8g2_ClearGlyphCache(u8g2_t *u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
 int8_t u8g2_GetStrX(u8g2_t *u8g2, const char *s);	/* for u8g compatibility */
 
 void u8g2_SetFontDirection(u8g2_t *u8g2, uint8_t dir);
@@ -1297,6 +1637,17 @@ u8g2_uint_t u8g2_DrawStr(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char
 u8g2_uint_t u8g2_DrawUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str);
 u8g2_uint_t u8g2_DrawExtendedUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, u8g2_kerning_t *kerning, const char *str);
 u8g2_uint_t u8g2_DrawExtUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, const uint16_t *kerning_table, const char *str);
+#ifdef U8G2_WITH_TEXT_LAYOUT
+void u8g2_ClearText(u8g2_text_t *text);
+u8g2_uint_t u8g2_LayoutStr(u8g2_t *u8g2, u8g2_text_t *text, const char *str);
+u8g2_uint_t u8g2_DrawText(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_text_t *text);
+#define u8g2_GetTextWidth(text) ((text)->width)
+#define u8g2_GetTextAscent(text) ((text)->ascent)
+#define u8g2_GetTextDescent(text) ((text)->descent)
+void u8g2_ClearTextBox(u8g2_text_box_t *box);
+uint8_t u8g2_LayoutUTF8Box(u8g2_t *u8g2, u8g2_text_box_t *box, const char *str, u8g2_uint_t max_width, uint8_t max_lines);
+void u8g2_DrawTextBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t line_height, const u8g2_text_box_t *box, uint8_t align);
+#endif /* U8G2_WITH_TEXT_LAYOUT */
 
 #define u8g2_GetMaxCharHeight(u8g2) ((u8g2)->font_info.max_char_height)
 #define u8g2_GetMaxCharWidth(u8g2) ((u8g2)->font_info.max_char_width)
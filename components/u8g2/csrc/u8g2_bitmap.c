@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 
 void u8g2_SetBitmapMode(u8g2_t *u8g2, uint8_t is_transparent) {
@@ -104,6 +105,195 @@ void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt
 
 
 
+/*==========================================*/
+/* bitmap blit for U8G2_R0 and the vertical top memory layout (SSD13xx) */
+
+static uint8_t u8g2_is_vertical_top_r0(u8g2_t *u8g2)
+{
+  return u8g2_is_r0_buffer(u8g2) && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb;
+}
+
+/* pixel rows of tile row "dest_row" which are inside the current page and the user window */
+static uint8_t u8g2_vertical_top_row_mask(u8g2_t *u8g2, int16_t dest_row)
+{
+  int16_t lo, hi;
+  if ( dest_row < u8g2->tile_curr_row || dest_row >= u8g2->tile_curr_row + (u8g2->pixel_buf_height>>3) )
+    return 0;
+  lo = (int16_t)u8g2->user_y0 - dest_row*8;
+  if ( lo < 0 )
+    lo = 0;
+  hi = (int16_t)u8g2->user_y1 - dest_row*8;
+  if ( hi > 8 )
+    hi = 8;
+  if ( lo >= hi )
+    return 0;
+  return (uint8_t)(0xff << lo) & (uint8_t)(0xff >> (8 - hi));
+}
+
+/*
+  Combine cnt columns of an 8 pixel high band with the buffer.
+  x: position of the first column, py: position of the upper pixel row
+  col: one byte per column, bit 0 is the upper pixel
+  bbx: pixel rows of the band which belong to the bitmap
+  Set bits are drawn with the draw color, in solid mode the other pixels
+  of bbx get the background color.
+*/
+static void u8g2_draw_vertical_top_band(u8g2_t *u8g2, u8g2_uint_t x, int16_t py, const uint8_t *col, u8g2_uint_t cnt, uint8_t bbx)
+{
+  int16_t dest_row;
+  uint8_t shift, mask0, mask1, bbx0, bbx1;
+  uint8_t or_mask, xor_mask, bg_set, bg_clr;
+  uint8_t fg, bg;
+  uint8_t *dest0, *dest1;
+  u8g2_uint_t c, px;
+  
+  /* floor(py/8) */
+  if ( py >= 0 )
+    dest_row = py >> 3;
+  else
+    dest_row = -((7 - py) >> 3);
+  shift = py - dest_row*8;
+  
+  mask0 = u8g2_vertical_top_row_mask(u8g2, dest_row);
+  mask1 = 0;
+  if ( shift != 0 )
+    mask1 = u8g2_vertical_top_row_mask(u8g2, dest_row+1);
+  bbx0 = (uint8_t)(bbx << shift) & mask0;
+  bbx1 = (uint8_t)(bbx >> (8-shift)) & mask1;
+  if ( (bbx0|bbx1) == 0 )
+    return;
+  dest0 = u8g2->tile_buf_ptr + (dest_row - u8g2->tile_curr_row)*u8g2->pixel_buf_width;
+  dest1 = dest0 + u8g2->pixel_buf_width;
+  
+  /* solid copy: the bytes of the band replace the buffer */
+  if ( bbx0 == 0xff && u8g2->draw_color == 1 && u8g2->bitmap_transparency == 0 )
+  {
+    px = x + cnt;
+    if ( x >= u8g2->user_x0 && px >= x && px <= u8g2->user_x1 )
+    {
+      memcpy(dest0 + x, col, cnt);
+      return;
+    }
+  }
+  
+  or_mask = u8g2->draw_color <= 1 ? 0xff : 0;
+  xor_mask = u8g2->draw_color != 1 ? 0xff : 0;
+  bg_set = 0;
+  bg_clr = 0;
+  if ( u8g2->bitmap_transparency == 0 )
+  {
+    if ( u8g2->draw_color == 0 )
+      bg_set = 0xff;
+    else
+      bg_clr = 0xff;
+  }
+  
+  for( c = 0; c < cnt; c++ )
+  {
+    px = x + c;
+    if ( px < u8g2->user_x0 || px >= u8g2->user_x1 )
+      continue;
+    if ( bbx0 != 0 )
+    {
+      fg = (uint8_t)(col[c] << shift) & bbx0;
+      bg = bbx0 & ~fg;
+      dest0[px] |= fg & or_mask;
+      dest0[px] ^= fg & xor_mask;
+      dest0[px] |= bg & bg_set;
+      dest0[px] &= ~(bg & bg_clr);
+    }
+    if ( bbx1 != 0 )
+    {
+      fg = (uint8_t)(col[c] >> (8-shift)) & bbx1;
+      bg = bbx1 & ~fg;
+      dest1[px] |= fg & or_mask;
+      dest1[px] ^= fg & xor_mask;
+      dest1[px] |= bg & bg_set;
+      dest1[px] &= ~(bg & bg_clr);
+    }
+  }
+}
+
+/* 
+  transpose 8x8 bits: bit c of row[r] becomes bit r of col[c]
+  Hacker's Delight, transpose8, with reversed row and column order
+*/
+void u8g2_transpose_8x8(const uint8_t *row, uint8_t *col)
+{
+  uint32_t x, y, t;
+  
+  x = ((uint32_t)row[7]<<24) | ((uint32_t)row[6]<<16) | ((uint32_t)row[5]<<8) | row[4];
+  y = ((uint32_t)row[3]<<24) | ((uint32_t)row[2]<<16) | ((uint32_t)row[1]<<8) | row[0];
+  
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+  
+  col[7] = x >> 24;
+  col[6] = x >> 16;
+  col[5] = x >> 8;
+  col[4] = x;
+  col[3] = y >> 24;
+  col[2] = y >> 16;
+  col[1] = y >> 8;
+  col[0] = y;
+}
+
+/* y might be "negative": the bitmap starts above the buffer */
+static int16_t u8g2_vertical_top_start_row(u8g2_uint_t y, u8g2_uint_t h)
+{
+  int16_t ty = y;
+  if ( (u8g2_uint_t)(y + h) < y )
+    ty -= (int16_t)((u8g2_uint_t)~(u8g2_uint_t)0) + 1;
+  return ty;
+}
+
+/*
+  XBM with 8x8 bit transpose: each block of 8 rows and 8 columns of the
+  bitmap becomes 8 column bytes of the buffer
+*/
+static void u8g2_draw_xbm_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap, uint8_t is_pgm)
+{
+  uint8_t row[8], col[8];
+  uint8_t i, rows, cnt;
+  u8g2_uint_t blen, r, bx;
+  int16_t ty;
+  const uint8_t *p;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  
+  blen = w;
+  blen += 7;
+  blen >>= 3;
+  ty = u8g2_vertical_top_start_row(y, h);
+  
+  for( r = 0; r < h; r += 8 )
+  {
+    rows = h - r < 8 ? h - r : 8;
+    for( bx = 0; bx < blen; bx++ )
+    {
+      p = bitmap + r*blen + bx;
+      for( i = 0; i < 8; i++ )
+      {
+	row[i] = 0;
+	if ( i < rows )
+	  row[i] = is_pgm ? u8x8_pgm_read(p) : *p;
+	p += blen;
+      }
+      u8g2_transpose_8x8(row, col);
+      cnt = w - bx*8 < 8 ? w - bx*8 : 8;
+      u8g2_draw_vertical_top_band(u8g2, x + bx*8, ty + r, col, cnt, 0xff >> (8 - rows));
+    }
+  }
+}
+
 void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b)
 {
   uint8_t mask;
@@ -147,6 +337,12 @@ void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
     return;
 #endif /* U8G2_WITH_INTERSECTION */
   
+  if ( u8g2_is_vertical_top_r0(u8g2) )
+  {
+    u8g2_draw_xbm_vertical_top_lsb(u8g2, x, y, w, h, bitmap, 0);
+    return;
+  }
+  
   while( h > 0 )
   {
     u8g2_DrawHXBM(u8g2, x, y, w, bitmap);
@@ -206,6 +402,12 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
     return;
 #endif /* U8G2_WITH_INTERSECTION */
   
+  if ( u8g2_is_vertical_top_r0(u8g2) )
+  {
+    u8g2_draw_xbm_vertical_top_lsb(u8g2, x, y, w, h, bitmap, 1);
+    return;
+  }
+  
   while( h > 0 )
   {
     u8g2_DrawHXBMP(u8g2, x, y, w, bitmap);
@@ -216,3 +418,50 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
 }
 
 
+/*
+  Bitmap in the vertical top memory layout of the u8g2 buffer (same as u8x8 tiles):
+  (h+7)/8 rows of w bytes, each byte is a column of 8 pixels, bit 0 is the upper pixel.
+  For U8G2_R0 and SSD13xx displays the bytes are copied (or shifted for unaligned y)
+  into the buffer.
+*/
+void u8g2_DrawTileBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_uint_t r, c;
+  int16_t ty;
+  uint8_t color = u8g2->draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+  
+  if ( u8g2_is_vertical_top_r0(u8g2) )
+  {
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if ( u8g2->is_page_clip_window_intersection == 0 )
+      return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+    ty = u8g2_vertical_top_start_row(y, h);
+    for( r = 0; r < h; r += 8 )
+    {
+      u8g2_draw_vertical_top_band(u8g2, x, ty + r, bitmap, w, h - r < 8 ? 0xff >> (8 - (h - r)) : 0xff);
+      bitmap += w;
+    }
+    return;
+  }
+  
+  for( r = 0; r < h; r++ )
+  {
+    for( c = 0; c < w; c++ )
+    {
+      if ( bitmap[(r>>3)*w + c] & (1<<(r&7)) ) {
+	u8g2->draw_color = color;
+	u8g2_DrawHVLine(u8g2, x+c, y+r, 1, 0);
+      } else if ( u8g2->bitmap_transparency == 0 ) {
+	u8g2->draw_color = ncolor;
+	u8g2_DrawHVLine(u8g2, x+c, y+r, 1, 0);
+      }
+    }
+  }
+  u8g2->draw_color = color;
+}
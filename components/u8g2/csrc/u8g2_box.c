@@ -45,6 +45,11 @@ void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+  if ( u8g2_is_r0_buffer(u8g2) && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    u8g2_draw_box_vertical_top_lsb(u8g2, x, y, w, h);
+    return;
+  }
   while( h != 0 )
   { 
     u8g2_DrawHVLine(u8g2, x, y, w, 0);
@@ -82,6 +87,11 @@ void u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u
 
 
 
+/*
+  draw a filled box with rounded corners
+  the radius is reduced, if the box is smaller than 2*r+1 pixel
+  the rows of the corners are drawn once, so that XOR (draw color 2) works
+*/
 void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r)
 {
   u8g2_uint_t xl, yu;
@@ -92,6 +102,13 @@ void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
     return;
 #endif /* U8G2_WITH_INTERSECTION */
 
+  if ( w == 0 || h == 0 )
+    return;
+  if ( r > (w-1)/2 )
+    r = (w-1)/2;
+  if ( r > (h-1)/2 )
+    r = (h-1)/2;
+
   xl = x;
   xl += r;
   yu = y;
@@ -107,37 +124,12 @@ void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   yl -= r; 
   yl -= 1;
 
-  u8g2_DrawDisc(u8g2, xl, yu, r, U8G2_DRAW_UPPER_LEFT);
-  u8g2_DrawDisc(u8g2, xr, yu, r, U8G2_DRAW_UPPER_RIGHT);
-  u8g2_DrawDisc(u8g2, xl, yl, r, U8G2_DRAW_LOWER_LEFT);
-  u8g2_DrawDisc(u8g2, xr, yl, r, U8G2_DRAW_LOWER_RIGHT);
-
-  {
-    u8g2_uint_t ww, hh;
-
-    ww = w;
-    ww -= r;
-    ww -= r;
-    xl++;
-    yu++;
-    
-    if ( ww >= 3 )
-    {
-      ww -= 2;
-      u8g2_DrawBox(u8g2, xl, y, ww, r+1);
-      u8g2_DrawBox(u8g2, xl, yl, ww, r+1);
-    }
-    
-    hh = h;
-    hh -= r;
-    hh -= r;
-    //h--;
-    if ( hh >= 3 )
-    {
-      hh -= 2;
-      u8g2_DrawBox(u8g2, x, yu, w, hh);
-    }
-  }
+  /* rows y..yu and yl..y+h-1 */
+  u8g2_draw_disc_corners(u8g2, xl, yu, xr, yl, r);
+  
+  /* rows between the corners */
+  if ( h > 2*r+2 )
+    u8g2_DrawBox(u8g2, x, yu+1, w, h-2*r-2);
 }
 
 
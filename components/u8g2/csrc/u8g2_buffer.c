@@ -53,8 +53,21 @@ static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_
   uint8_t *ptr;
   uint16_t offset;
   uint8_t w;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  uint8_t rotated[U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH*8];
+#endif /* U8G2_WITH_FLUSH_ROTATION */
   
   w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( u8g2->cb->rotate_tile_row != NULL )
+  {
+    if ( w > U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH )
+      return;
+    dest_tile_row = u8g2->cb->rotate_tile_row(u8g2, u8g2->tile_buf_ptr, src_tile_row, rotated);
+    u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, rotated);
+    return;
+  }
+#endif /* U8G2_WITH_FLUSH_ROTATION */
   offset = src_tile_row;
   ptr = u8g2->tile_buf_ptr;
   offset *= w;
@@ -81,6 +94,20 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
   dest_row = u8g2->tile_curr_row;
   dest_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
   
+  /* display RAM will differ from the shadow buffer after this */
+  u8g2->is_shadow_buf_valid = 0;
+  
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( u8g2->cb->rotate_tile_row == NULL )
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+  {
+    /* all rows at once, a single transfer if the display and the byte driver support this */
+    if ( src_max > dest_max - dest_row )
+      src_max = dest_max - dest_row;
+    u8x8_DrawTileRows(u8g2_GetU8x8(u8g2), 0, dest_row, u8g2_GetU8x8(u8g2)->display_info->tile_width, src_max, u8g2->tile_buf_ptr);
+    return;
+  }
+  
   do
   {
     u8g2_send_tile_row(u8g2, src_row, dest_row);
@@ -181,6 +208,308 @@ void u8g2_UpdateDisplay(u8g2_t *u8g2)
 }
 
 
+/*============================================*/
+/*
+  Description:
+    Assign a shadow buffer for u8g2_SendBufferChanged(). The shadow buffer
+    must have the same size as the tile buffer (see u8g2_GetBufferSize()).
+    The shadow buffer is marked as invalid, so the next call to 
+    u8g2_SendBufferChanged() will send the complete buffer.
+    Use NULL to remove the shadow buffer.
+*/
+void u8g2_SetShadowBufferPtr(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->shadow_buf_ptr = buf;
+  u8g2->is_shadow_buf_valid = 0;
+}
+
+/* send the changed tiles of one tile row and update the shadow row, returns the number of tiles sent */
+static uint16_t u8g2_send_changed_tiles(u8g2_t *u8g2, uint8_t *ptr, uint8_t *shadow, uint8_t ty)
+{
+  uint16_t tile_cnt = 0;
+  uint8_t tx, tw;
+  uint8_t run_start;
+  
+  tw = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  tx = 0;
+  while( tx < tw )
+  {
+    if ( memcmp(ptr+tx*8, shadow+tx*8, 8) == 0 )
+    {
+      tx++;
+      continue;
+    }
+    /* collect all adjacent changed tiles into one run */
+    run_start = tx;
+    do
+    {
+      memcpy(shadow+tx*8, ptr+tx*8, 8);
+      tx++;
+    } while( tx < tw && memcmp(ptr+tx*8, shadow+tx*8, 8) != 0 );
+    u8x8_DrawTile( u8g2_GetU8x8(u8g2), run_start, ty, tx-run_start, ptr+run_start*8 );
+    tile_cnt += tx-run_start;
+  }
+  return tile_cnt;
+}
+
+/* 1 if the display moves the content of tile row "ty", see u8g2_StartScroll() */
+static uint8_t u8g2_is_scrolled_tile_row(u8g2_t *u8g2, uint8_t ty)
+{
+  if ( u8g2->is_scroll_active == 0 )
+    return 0;
+  return ty >= u8g2->scroll_ty_start && ty <= u8g2->scroll_ty_end;
+}
+
+/*
+  Description:
+    Send only those tiles of "frame", which have changed since the last call.
+    "frame" is a full frame in the layout of the tile buffer. It is compared 
+    against the shadow buffer, which contains a copy of the last frame sent. 
+    Changed tiles within a tile row are combined into runs and each run is 
+    sent with one u8x8_DrawTile() call.
+    If there is no valid shadow buffer, the complete frame is sent.
+    The frame does not need to be the current tile buffer. This allows 
+    sending one frame while the next frame is drawn (see u8g2_SwapBufferPtr()).
+    
+  Returns:
+    Number of tiles sent to the display, each tile is 8 bytes.
+
+  Limitations:
+    - Only works in full buffer mode, does nothing in page mode
+    - U8G2_R1, U8G2_R2, U8G2_R3 and U8G2_MIRROR are ignored (the frame is compared as is),
+      the U8G2_..._FLUSH rotations are applied, the shadow buffer has the layout of the display
+    - Only works with displays, which support U8x8 API
+    - Other procedures, which write to the display RAM (u8g2_SendBuffer(),
+      u8g2_ClearDisplay(), picture loop), will invalidate the shadow buffer.
+      u8g2_InvalidateShadowBuffer() must be called if the display RAM is 
+      modified in any other way.
+    - Tile rows under hardware scroll (u8g2_StartScroll()) are not sent, 
+      they are only copied to the shadow buffer and sent by u8g2_StopScroll()
+*/
+uint16_t u8g2_SendFrameChanged(u8g2_t *u8g2, uint8_t *frame)
+{
+  uint8_t *ptr;
+  uint8_t *shadow;
+  uint16_t page_size;
+  uint16_t tile_cnt;
+  uint8_t ty, tw, th;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  uint8_t dest_ty;
+  uint8_t rotated[U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH*8];
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+  
+  tw = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  th = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  
+  /* frames only exist in full buffer mode */
+  if ( u8g2->tile_buf_height != th )
+    return 0;
+  
+  page_size = u8g2->pixel_buf_width;  /* 8*u8g2->u8g2_GetU8x8(u8g2)->display_info->tile_width */
+  
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  /* the shadow buffer has the layout of the display, one tile row is rotated at a time */
+  if ( u8g2->cb->rotate_tile_row != NULL )
+  {
+    if ( tw > U8G2_FLUSH_ROTATION_MAX_TILE_WIDTH )
+      return 0;
+    page_size = tw*8;
+    tile_cnt = 0;
+    for( ty = 0; ty < th; ty++ )
+    {
+      dest_ty = u8g2->cb->rotate_tile_row(u8g2, frame, ty, rotated);
+      if ( u8g2_is_scrolled_tile_row(u8g2, dest_ty) )
+      {
+	if ( u8g2->shadow_buf_ptr != NULL )
+	  memcpy(u8g2->shadow_buf_ptr + dest_ty*page_size, rotated, page_size);
+	continue;
+      }
+      if ( u8g2->shadow_buf_ptr == NULL || u8g2->is_shadow_buf_valid == 0 )
+      {
+	u8x8_DrawTile( u8g2_GetU8x8(u8g2), 0, dest_ty, tw, rotated );
+	if ( u8g2->shadow_buf_ptr != NULL )
+	  memcpy(u8g2->shadow_buf_ptr + dest_ty*page_size, rotated, page_size);
+	tile_cnt += tw;
+      }
+      else
+      {
+	tile_cnt += u8g2_send_changed_tiles(u8g2, rotated, u8g2->shadow_buf_ptr + dest_ty*page_size, dest_ty);
+      }
+    }
+    if ( u8g2->shadow_buf_ptr != NULL )
+      u8g2->is_shadow_buf_valid = 1;
+    if ( tile_cnt > 0 )
+      u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    return tile_cnt;
+  }
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+  
+  /* content of the display is unknown, send everything */
+  if ( u8g2->shadow_buf_ptr == NULL || u8g2->is_shadow_buf_valid == 0 )
+  {
+    if ( u8g2->is_scroll_active == 0 )
+    {
+      u8x8_DrawTileRows( u8g2_GetU8x8(u8g2), 0, 0, tw, th, frame );
+      ty = th;
+    }
+    else
+    {
+      /* only the rows above and below the scrolled rows */
+      ty = u8g2->scroll_ty_start;
+      if ( ty > 0 )
+	u8x8_DrawTileRows( u8g2_GetU8x8(u8g2), 0, 0, tw, ty, frame );
+      if ( u8g2->scroll_ty_end+1 < th )
+	u8x8_DrawTileRows( u8g2_GetU8x8(u8g2), 0, u8g2->scroll_ty_end+1, tw, th-u8g2->scroll_ty_end-1, frame + (u8g2->scroll_ty_end+1)*page_size );
+      ty += th-u8g2->scroll_ty_end-1;
+    }
+    if ( u8g2->shadow_buf_ptr != NULL )
+    {
+      memcpy(u8g2->shadow_buf_ptr, frame, (size_t)page_size*(size_t)th);
+      u8g2->is_shadow_buf_valid = 1;
+    }
+    u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    tile_cnt = tw;
+    tile_cnt *= ty;
+    return tile_cnt;
+  }
+  
+  tile_cnt = 0;
+  ptr = frame;
+  shadow = u8g2->shadow_buf_ptr;
+  for( ty = 0; ty < th; ty++ )
+  {
+    if ( u8g2_is_scrolled_tile_row(u8g2, ty) )
+      memcpy(shadow, ptr, page_size);	/* sent by u8g2_StopScroll() */
+    else
+      tile_cnt += u8g2_send_changed_tiles(u8g2, ptr, shadow, ty);
+    ptr += page_size;
+    shadow += page_size;
+  }
+  
+  if ( tile_cnt > 0 )
+    u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+  return tile_cnt;
+}
+
+/*
+  Description:
+    Send only those tiles of the tile buffer, which have changed since the 
+    last call. See u8g2_SendFrameChanged() for details.
+    
+  Returns:
+    Number of tiles sent to the display, each tile is 8 bytes.
+
+  Limitations:
+    - Behaves like u8g2_SendBuffer() in page mode or if no shadow buffer is assigned,
+      except for the rows held back while the display scrolls (u8g2_StartScroll())
+    - See u8g2_SendFrameChanged()
+*/
+uint16_t u8g2_SendBufferChanged(u8g2_t *u8g2)
+{
+  uint16_t tile_cnt;
+  
+  /* without shadow buffer, u8g2_SendFrameChanged() is still needed to hold back the scrolled rows */
+  if ( (u8g2->shadow_buf_ptr == NULL && u8g2->is_scroll_active == 0) || u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  {
+    u8g2_SendBuffer(u8g2);
+    tile_cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    tile_cnt *= u8g2->tile_buf_height;
+    return tile_cnt;
+  }
+  return u8g2_SendFrameChanged(u8g2, u8g2->tile_buf_ptr);
+}
+
+/*
+  Description:
+    Replace the tile buffer by another memory area of the same size
+    (see u8g2_GetBufferSize()) and return the previous tile buffer.
+    Together with u8g2_SendFrameChanged() this allows double buffering:
+    The returned buffer keeps the completed frame and can be sent by another 
+    task, while the next frame is drawn into "buf".
+    The content of "buf" is not modified. It is the responsibility of the 
+    caller to ensure, that "buf" is no longer accessed by any other task.
+*/
+uint8_t *u8g2_SwapBufferPtr(u8g2_t *u8g2, uint8_t *buf)
+{
+  uint8_t *prev = u8g2->tile_buf_ptr;
+  u8g2->tile_buf_ptr = buf;
+  return prev;
+}
+
+
+/*============================================*/
+/*
+  Description:
+    Start the horizontal hardware scroll of the display tile rows 
+    ty_start..ty_end (inclusive). The content leaving the display on one 
+    side enters it again on the other side, no data is sent while the 
+    display scrolls. "dir" is U8X8_SCROLL_RIGHT or U8X8_SCROLL_LEFT (as seen 
+    with flip mode 0), "speed" is 0 (slowest) .. 7 (fastest).
+    A scroll which is already active is stopped first.
+    
+  Returns:
+    0 if the display does not support hardware scroll.
+
+  Limitations:
+    - Tile rows are rows of the display, U8G2_R1, U8G2_R2, U8G2_R3 and the
+      U8G2_..._FLUSH rotations are not applied
+    - u8g2_SendFrameChanged() and u8g2_SendBufferChanged() hold back the 
+      scrolled rows until u8g2_StopScroll(). All other procedures, which 
+      write to the display RAM (u8g2_SendBuffer(), picture loop), must not 
+      be used while the display scrolls.
+*/
+uint8_t u8g2_StartScroll(u8g2_t *u8g2, uint8_t ty_start, uint8_t ty_end, uint8_t dir, uint8_t speed)
+{
+  uint8_t th = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  
+  u8g2_StopScroll(u8g2);
+  if ( ty_end >= th )
+    ty_end = th-1;
+  if ( u8x8_StartScroll(u8g2_GetU8x8(u8g2), ty_start, ty_end, dir, speed) == 0 )
+    return 0;
+  u8g2->scroll_ty_start = ty_start;
+  u8g2->scroll_ty_end = ty_end;
+  u8g2->is_scroll_active = 1;
+  return 1;
+}
+
+/*
+  Description:
+    Stop the hardware scroll. The display RAM of the scrolled rows has 
+    been moved by the display, the rows are written again:
+    - from the shadow buffer, which also holds the rows of the frames 
+      held back by u8g2_SendFrameChanged() while the display scrolled
+    - from the tile buffer (u8g2_SendBuffer()) in full buffer mode without 
+      a shadow buffer
+    In page mode without shadow buffer, the rows must be drawn again by the
+    caller (picture loop).
+*/
+void u8g2_StopScroll(u8g2_t *u8g2)
+{
+  uint8_t tw;
+  
+  if ( u8g2->is_scroll_active == 0 )
+    return;
+  u8x8_StopScroll(u8g2_GetU8x8(u8g2));
+  u8g2->is_scroll_active = 0;
+  
+  tw = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  if ( u8g2->shadow_buf_ptr != NULL )
+  {
+    /* if invalid, the next u8g2_SendFrameChanged() sends all rows anyway */
+    if ( u8g2->is_shadow_buf_valid != 0 )
+    {
+      u8x8_DrawTileRows( u8g2_GetU8x8(u8g2), 0, u8g2->scroll_ty_start, tw, 
+	u8g2->scroll_ty_end-u8g2->scroll_ty_start+1, u8g2->shadow_buf_ptr + u8g2->scroll_ty_start*tw*8 );
+      u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    }
+  }
+  else if ( u8g2->tile_buf_height == u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  {
+    u8g2_SendBuffer(u8g2);
+  }
+}
+
 /*============================================*/
 
 /* vertical_top memory architecture */
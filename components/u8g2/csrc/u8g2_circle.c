@@ -122,76 +122,130 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
 }
 
 /*==============================================*/
-/* Disk */
-
-static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
+/* Spans of the four quadrants */
 
-static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
+/*
+  Filled shapes which are symmetric to the rows yu, yl and the columns
+  xl, xr: row yu-r covers xl-c..xr+c in the upper half and row yl+r in
+  the lower half. The left and right part are only drawn if the quadrant
+  is selected in option. Each row is drawn once with u8g2_span_add(),
+  so that the shapes also work with XOR (draw color 2).
+*/
+struct u8g2_quad_struct
 {
-    /* upper right */
-    if ( option & U8G2_DRAW_UPPER_RIGHT )
-    {
-      u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
-      u8g2_DrawVLine(u8g2, x0+y, y0-x, x+1);
-    }
-    
-    /* upper left */
-    if ( option & U8G2_DRAW_UPPER_LEFT )
-    {
-      u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
-      u8g2_DrawVLine(u8g2, x0-y, y0-x, x+1);
-    }
-    
-    /* lower right */
-    if ( option & U8G2_DRAW_LOWER_RIGHT )
-    {
-      u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
-      u8g2_DrawVLine(u8g2, x0+y, y0, x+1);
-    }
-    
-    /* lower left */
-    if ( option & U8G2_DRAW_LOWER_LEFT )
-    {
-      u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
-      u8g2_DrawVLine(u8g2, x0-y, y0, x+1);
-    }
+  u8g2_span_t upper;
+  u8g2_span_t lower;
+  int16_t xl, xr;
+  int16_t yu, yl;
+  uint8_t option;
+};
+typedef struct u8g2_quad_struct u8g2_quad_t;
+
+static void u8g2_quad_init(u8g2_t *u8g2, u8g2_quad_t *q, u8g2_uint_t xl, u8g2_uint_t yu, u8g2_uint_t xr, u8g2_uint_t yl, uint8_t option)
+{
+  u8g2_span_init(u8g2, &(q->upper));
+  u8g2_span_init(u8g2, &(q->lower));
+  q->xl = xl;
+  q->xr = xr;
+  q->yu = yu;
+  q->yl = yl;
+  q->option = option;
 }
 
-static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+static void u8g2_quad_span(u8g2_quad_t *q, u8g2_span_t *s, int16_t y, u8g2_uint_t c, uint8_t left, uint8_t right)
 {
-  u8g2_int_t f;
-  u8g2_int_t ddF_x;
-  u8g2_int_t ddF_y;
-  u8g2_uint_t x;
-  u8g2_uint_t y;
-
-  f = 1;
-  f -= rad;
-  ddF_x = 1;
-  ddF_y = 0;
-  ddF_y -= rad;
-  ddF_y *= 2;
-  x = 0;
-  y = rad;
+  int16_t x0, x1;
+  
+  if ( left == 0 && right == 0 )
+    return;
+  x0 = q->xl;
+  if ( left )
+    x0 -= c;
+  x1 = q->xr;
+  if ( right )
+    x1 += c;
+  u8g2_span_add(s, y, x0, x1+1);
+}
 
-  u8g2_draw_disc_section(u8g2, x, y, x0, y0, option);
+static void u8g2_quad_row(u8g2_quad_t *q, u8g2_uint_t r, u8g2_uint_t c) U8G2_NOINLINE;
+static void u8g2_quad_row(u8g2_quad_t *q, u8g2_uint_t r, u8g2_uint_t c)
+{
+  uint8_t option = q->option;
   
-  while ( x < y )
+  if ( r == 0 && q->yu == q->yl )
   {
-    if (f >= 0) 
+    /* center row, belongs to the upper and the lower half */
+    u8g2_quad_span(q, &(q->lower), q->yl, c, option & (U8G2_DRAW_UPPER_LEFT|U8G2_DRAW_LOWER_LEFT), option & (U8G2_DRAW_UPPER_RIGHT|U8G2_DRAW_LOWER_RIGHT));
+    return;
+  }
+  u8g2_quad_span(q, &(q->upper), q->yu - r, c, option & U8G2_DRAW_UPPER_LEFT, option & U8G2_DRAW_UPPER_RIGHT);
+  u8g2_quad_span(q, &(q->lower), q->yl + r, c, option & U8G2_DRAW_LOWER_LEFT, option & U8G2_DRAW_LOWER_RIGHT);
+}
+
+static void u8g2_quad_flush(u8g2_quad_t *q)
+{
+  u8g2_span_flush(&(q->upper));
+  u8g2_span_flush(&(q->lower));
+}
+
+/*==============================================*/
+/* Disk */
+
+/*
+  Row r of the disc covers the columns c with c*c + r*r - max(c,r) < rad*rad.
+  These are the same pixels as the vertical lines, which were drawn for
+  each step of the midpoint circle algorithm (see u8g2_draw_circle).
+*/
+static void u8g2_disc_rows(u8g2_quad_t *q, u8g2_uint_t rad)
+{
+  u8g2_long_t t;	/* rad*rad - r*r */
+  u8g2_long_t cc;
+  u8g2_uint_t r, c;
+  
+  t = rad;
+  t *= rad;
+  c = rad;
+  r = 0;
+  for(;;)
+  {
+    for(;;)
     {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
+      cc = c;
+      cc *= c;
+      cc -= c > r ? c : r;
+      if ( c == 0 || cc < t )
+	break;
+      c--;
     }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-
-    u8g2_draw_disc_section(u8g2, x, y, x0, y0, option);    
+    u8g2_quad_row(q, r, c);
+    if ( r == rad )
+      break;
+    t -= r;
+    t -= r;
+    t -= 1;
+    r++;
   }
 }
 
+static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  u8g2_quad_t q;
+  
+  u8g2_quad_init(u8g2, &q, x0, y0, x0, y0, option);
+  u8g2_disc_rows(&q, rad);
+  u8g2_quad_flush(&q);
+}
+
+/* four quarter discs with the centers xl,yu and xr,yl and the rows between them */
+void u8g2_draw_disc_corners(u8g2_t *u8g2, u8g2_uint_t xl, u8g2_uint_t yu, u8g2_uint_t xr, u8g2_uint_t yl, u8g2_uint_t rad)
+{
+  u8g2_quad_t q;
+  
+  u8g2_quad_init(u8g2, &q, xl, yu, xr, yl, U8G2_DRAW_ALL);
+  u8g2_disc_rows(&q, rad);
+  u8g2_quad_flush(&q);
+}
+
 void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
   /* check for bounding box */
@@ -346,43 +400,36 @@ void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t
 /*==============================================*/
 /* Filled Ellipse */
 
-static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
-static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
-{
-    /* upper right */
-    if ( option & U8G2_DRAW_UPPER_RIGHT )
-    {
-      u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
-    }
-    
-    /* upper left */
-    if ( option & U8G2_DRAW_UPPER_LEFT )
-    {
-      u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
-    }
-    
-    /* lower right */
-    if ( option & U8G2_DRAW_LOWER_RIGHT )
-    {
-      u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
-    }
-    
-    /* lower left */
-    if ( option & U8G2_DRAW_LOWER_LEFT )
-    {
-      u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
-    }
-}
-
+/*
+  Same steps as u8g2_draw_ellipse, the second part (top of the ellipse,
+  rows ry down to y2) is calculated first, so that the last column x2 of
+  the second part is known for the rows of the first part. Each row is
+  as wide as the widest of the vertical lines, which were drawn for the
+  steps in this row and the rows below. This also fills the columns,
+  which were skipped by the vertical lines of flat ellipses.
+*/
 static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  u8g2_quad_t q;
   u8g2_uint_t x, y;
+  u8g2_uint_t x2, y2;
   u8g2_long_t xchg, ychg;
   u8g2_long_t err;
   u8g2_long_t rxrx2;
   u8g2_long_t ryry2;
   u8g2_long_t stopx, stopy;
   
+  u8g2_quad_init(u8g2, &q, x0, y0, x0, y0, option);
+  
+  if ( rx == 0 || ry == 0 )
+  {
+    /* a line, the steps below would not terminate */
+    for( y = 0; y <= ry; y++ )
+      u8g2_quad_row(&q, y, rx);
+    u8g2_quad_flush(&q);
+    return;
+  }
+  
   rxrx2 = rx;
   rxrx2 *= rx;
   rxrx2 *= 2;
@@ -391,6 +438,47 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
   ryry2 *= ry;
   ryry2 *= 2;
   
+  x = 0;
+  y = ry;
+  
+  xchg = ry;
+  xchg *= ry;
+  
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = 0;
+
+  stopy = rxrx2;
+  stopy *= ry;
+  
+  x2 = 0;
+  y2 = ry;
+  while( stopx <= stopy )
+  {
+    /* row y2 is complete, if this step is in the next row */
+    if ( y != y2 )
+      u8g2_quad_row(&q, y2, x2);
+    x2 = x;
+    y2 = y;
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+  }
+  
   x = rx;
   y = 0;
   
@@ -411,7 +499,10 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
   
   while( stopx >= stopy )
   {
-    u8g2_draw_filled_ellipse_section(u8g2, x, y, x0, y0, option);
+    /* the first part ends at row y2 or below */
+    u8g2_quad_row(&q, y, x > x2 ? x : x2);
+    if ( y == y2 )
+      break;
     y++;
     stopy += rxrx2;
     err += ychg;
@@ -424,43 +515,18 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
       xchg += ryry2;      
     }
   }
-
-  x = 0;
-  y = ry;
-  
-  xchg = ry;
-  xchg *= ry;
-  
-  ychg = 1;
-  ychg -= ry;
-  ychg -= ry;
-  ychg *= rx;
-  ychg *= rx;
-  
-  err = 0;
   
-  stopx = 0;
-
-  stopy = rxrx2;
-  stopy *= ry;
-  
-
-  while( stopx <= stopy )
+  if ( stopx < stopy )
   {
-    u8g2_draw_filled_ellipse_section(u8g2, x, y, x0, y0, option);
-    x++;
-    stopx += ryry2;
-    err += xchg;
-    xchg += ryry2;
-    if ( 2*err+ychg > 0 )
+    /* rows between both parts, row y is not drawn yet */
+    u8g2_quad_row(&q, y, x2);
+    while( y < y2 )
     {
-      y--;
-      stopy -= rxrx2;
-      err += ychg;
-      ychg += rxrx2;
+      y++;
+      u8g2_quad_row(&q, y, x2);
     }
   }
-  
+  u8g2_quad_flush(&q);
 }
 
 void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
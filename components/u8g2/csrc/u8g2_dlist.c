@@ -0,0 +1,487 @@
+/*
+
+  u8g2_dlist.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Display list for the page buffer mode.
+
+  In page mode the complete picture is drawn once for each page. With a
+  display list, the draw procedures are called once and only recorded
+  together with their bounding box. u8g2_DrawDisplayList() replays the
+  list for the current page and skips all commands which do not
+  intersect the page. String width, layout calculation and glyph lookup
+  of the application are done only once per frame.
+
+    u8g2_InitDisplayList(&u8g2, &dl, buf, sizeof(buf));
+    u8g2_DLSetFont(&u8g2, &dl, u8g2_font_helvB08_tr);
+    u8g2_DLDrawStr(&u8g2, &dl, 0, 20, "Hello");
+    u8g2_FirstPage(&u8g2);
+    do {
+      u8g2_DrawDisplayList(&u8g2, &dl);
+    } while( u8g2_NextPage(&u8g2) );
+
+  The u8g2_DL... procedures also apply the state changes (color, font,
+  modes) to u8g2, so that string widths can be calculated while
+  recording. The state of u8g2 at u8g2_InitDisplayList() or
+  u8g2_ClearDisplayList() is recorded as start state, the state of u8g2
+  is restored at the end of u8g2_DrawDisplayList().
+  Strings are copied into the list, fonts and bitmaps are referenced.
+
+  Record format:
+    1 byte command
+    4 * sizeof(u8g2_uint_t) bounding box x0, y0, x1, y1 (not for state commands)
+    arguments
+
+  Restrictions:
+    Text bounding boxes are calculated for font direction 0, other
+    directions use the complete display as bounding box.
+    If the buffer is too small, is_overflow is set and further commands
+    are ignored.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+#define U8G2_DL_CMD_DRAW_COLOR 1
+#define U8G2_DL_CMD_FONT 2
+#define U8G2_DL_CMD_FONT_MODE 3
+#define U8G2_DL_CMD_BITMAP_MODE 4
+/* commands with bounding box */
+#define U8G2_DL_CMD_BOX 16
+#define U8G2_DL_CMD_FRAME 17
+#define U8G2_DL_CMD_HLINE 18
+#define U8G2_DL_CMD_VLINE 19
+#define U8G2_DL_CMD_LINE 20
+#define U8G2_DL_CMD_CIRCLE 21
+#define U8G2_DL_CMD_DISC 22
+#define U8G2_DL_CMD_STR 23
+#define U8G2_DL_CMD_UTF8 24
+#define U8G2_DL_CMD_GLYPH 25
+#define U8G2_DL_CMD_XBM 26
+#define U8G2_DL_CMD_TILE_BITMAP 27
+
+/*==========================================*/
+/* recording */
+
+/* reserve len bytes in the display list, returns NULL if the list is full */
+static uint8_t *u8g2_dl_alloc(u8g2_dlist_t *dl, uint16_t len)
+{
+  uint8_t *p;
+  if ( dl->is_overflow != 0 || len > dl->size - dl->len )
+  {
+    dl->is_overflow = 1;
+    return NULL;
+  }
+  p = dl->buf + dl->len;
+  dl->len += len;
+  return p;
+}
+
+static uint8_t *u8g2_dl_put_uint(uint8_t *p, u8g2_uint_t v)
+{
+  memcpy(p, &v, sizeof(u8g2_uint_t));
+  return p + sizeof(u8g2_uint_t);
+}
+
+static uint8_t *u8g2_dl_put_ptr(uint8_t *p, const void *ptr)
+{
+  memcpy(p, &ptr, sizeof(const void *));
+  return p + sizeof(const void *);
+}
+
+/* command with bounding box, returns pointer to the arguments or NULL */
+static uint8_t *u8g2_dl_add(u8g2_dlist_t *dl, uint8_t cmd, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1, uint16_t arg_len)
+{
+  uint8_t *p = u8g2_dl_alloc(dl, 1 + 4*sizeof(u8g2_uint_t) + arg_len);
+  if ( p == NULL )
+    return NULL;
+  *p++ = cmd;
+  p = u8g2_dl_put_uint(p, x0);
+  p = u8g2_dl_put_uint(p, y0);
+  p = u8g2_dl_put_uint(p, x1);
+  p = u8g2_dl_put_uint(p, y1);
+  return p;
+}
+
+static void u8g2_dl_add_state(u8g2_dlist_t *dl, uint8_t cmd, uint8_t value)
+{
+  uint8_t *p = u8g2_dl_alloc(dl, 2);
+  if ( p == NULL )
+    return;
+  p[0] = cmd;
+  p[1] = value;
+}
+
+void u8g2_DLSetDrawColor(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t color)
+{
+  u8g2_SetDrawColor(u8g2, color);
+  u8g2_dl_add_state(dl, U8G2_DL_CMD_DRAW_COLOR, u8g2->draw_color);
+}
+
+void u8g2_DLSetFontMode(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t is_transparent)
+{
+  u8g2_SetFontMode(u8g2, is_transparent);
+  u8g2_dl_add_state(dl, U8G2_DL_CMD_FONT_MODE, is_transparent);
+}
+
+void u8g2_DLSetBitmapMode(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t is_transparent)
+{
+  u8g2_SetBitmapMode(u8g2, is_transparent);
+  u8g2_dl_add_state(dl, U8G2_DL_CMD_BITMAP_MODE, is_transparent);
+}
+
+void u8g2_DLSetFont(u8g2_t *u8g2, u8g2_dlist_t *dl, const uint8_t *font)
+{
+  uint8_t *p;
+  u8g2_SetFont(u8g2, font);
+  p = u8g2_dl_alloc(dl, 1 + sizeof(const void *));
+  if ( p == NULL )
+    return;
+  *p++ = U8G2_DL_CMD_FONT;
+  u8g2_dl_put_ptr(p, font);
+}
+
+/*
+  Assign the memory for the display list and start a new recording.
+*/
+void u8g2_InitDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t *buf, uint16_t size)
+{
+  dl->buf = buf;
+  dl->size = size;
+  u8g2_ClearDisplayList(u8g2, dl);
+}
+
+/*
+  Remove all commands and start a new recording. The current draw color,
+  font and modes of u8g2 are recorded as start state of the replay.
+*/
+void u8g2_ClearDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl)
+{
+  dl->len = 0;
+  dl->is_overflow = 0;
+  u8g2_DLSetDrawColor(u8g2, dl, u8g2->draw_color);
+  u8g2_DLSetFontMode(u8g2, dl, u8g2->font_decode.is_transparent);
+  u8g2_DLSetBitmapMode(u8g2, dl, u8g2->bitmap_transparency);
+  if ( u8g2->font != NULL )
+    u8g2_DLSetFont(u8g2, dl, u8g2->font);
+}
+
+void u8g2_DLDrawBox(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_dl_add(dl, U8G2_DL_CMD_BOX, x, y, x+w, y+h, 0);
+}
+
+void u8g2_DLDrawFrame(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_dl_add(dl, U8G2_DL_CMD_FRAME, x, y, x+w, y+h, 0);
+}
+
+void u8g2_DLDrawHLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
+{
+  u8g2_dl_add(dl, U8G2_DL_CMD_HLINE, x, y, x+len, y+1, 0);
+}
+
+void u8g2_DLDrawVLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
+{
+  u8g2_dl_add(dl, U8G2_DL_CMD_VLINE, x, y, x+1, y+len, 0);
+}
+
+void u8g2_DLDrawLine(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2)
+{
+  uint8_t *p;
+  p = u8g2_dl_add(dl, U8G2_DL_CMD_LINE, 
+    x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, 
+    (x1 < x2 ? x2 : x1) + 1, (y1 < y2 ? y2 : y1) + 1, 
+    4*sizeof(u8g2_uint_t));
+  if ( p == NULL )
+    return;
+  p = u8g2_dl_put_uint(p, x1);
+  p = u8g2_dl_put_uint(p, y1);
+  p = u8g2_dl_put_uint(p, x2);
+  u8g2_dl_put_uint(p, y2);
+}
+
+static void u8g2_dl_add_circle(u8g2_dlist_t *dl, uint8_t cmd, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  uint8_t *p;
+  p = u8g2_dl_add(dl, cmd, x0-rad, y0-rad, x0+rad+1, y0+rad+1, 1);
+  if ( p == NULL )
+    return;
+  *p = option;
+}
+
+void u8g2_DLDrawCircle(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  u8g2_dl_add_circle(dl, U8G2_DL_CMD_CIRCLE, x0, y0, rad, option);
+}
+
+void u8g2_DLDrawDisc(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  u8g2_dl_add_circle(dl, U8G2_DL_CMD_DISC, x0, y0, rad, option);
+}
+
+/*
+  bounding box of text with width w at x/y, the font reference position is
+  already applied to y (baseline)
+*/
+static uint8_t *u8g2_dl_add_text(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t cmd, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, uint16_t arg_len)
+{
+  u8g2_uint_t x0, y0, x1, y1;
+  uint8_t *p;
+  
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+  {
+    x0 = 0;
+    y0 = 0;
+    x1 = u8g2->width;
+    y1 = u8g2->height;
+  }
+  else
+#endif
+  {
+    /* glyphs may extend max_char_width to the left (negative x offset) and right */
+    x0 = x - u8g2->font_info.max_char_width;
+    x1 = x + w + u8g2->font_info.max_char_width;
+    y0 = y - (u8g2->font_info.max_char_height + u8g2->font_info.y_offset);
+    y1 = y - u8g2->font_info.y_offset;
+  }
+  p = u8g2_dl_add(dl, cmd, x0, y0, x1, y1, 2*sizeof(u8g2_uint_t) + arg_len);
+  if ( p == NULL )
+    return NULL;
+  p = u8g2_dl_put_uint(p, x);
+  return u8g2_dl_put_uint(p, y);
+}
+
+static u8g2_uint_t u8g2_dl_add_string(u8g2_t *u8g2, u8g2_dlist_t *dl, uint8_t cmd, u8g2_uint_t x, u8g2_uint_t y, const char *str, u8g2_uint_t w)
+{
+  uint16_t len = strlen(str) + 1;
+  uint8_t *p;
+  
+  p = u8g2_dl_add_text(u8g2, dl, cmd, x, y + u8g2->font_calc_vref(u8g2), w, len);
+  if ( p != NULL )
+    memcpy(p, str, len);
+  return w;
+}
+
+/* returns the width of the string like u8g2_DrawStr() */
+u8g2_uint_t u8g2_DLDrawStr(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, const char *str)
+{
+  return u8g2_dl_add_string(u8g2, dl, U8G2_DL_CMD_STR, x, y, str, u8g2_GetStrWidth(u8g2, str));
+}
+
+u8g2_uint_t u8g2_DLDrawUTF8(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, const char *str)
+{
+  return u8g2_dl_add_string(u8g2, dl, U8G2_DL_CMD_UTF8, x, y, str, u8g2_GetUTF8Width(u8g2, str));
+}
+
+void u8g2_DLDrawGlyph(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
+{
+  uint8_t *p;
+  p = u8g2_dl_add_text(u8g2, dl, U8G2_DL_CMD_GLYPH, x, y + u8g2->font_calc_vref(u8g2), u8g2->font_info.max_char_width, 2);
+  if ( p == NULL )
+    return;
+  memcpy(p, &encoding, 2);
+}
+
+static void u8g2_dl_add_bitmap(u8g2_dlist_t *dl, uint8_t cmd, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  uint8_t *p;
+  p = u8g2_dl_add(dl, cmd, x, y, x+w, y+h, sizeof(const void *));
+  if ( p == NULL )
+    return;
+  u8g2_dl_put_ptr(p, bitmap);
+}
+
+void u8g2_DLDrawXBM(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_dl_add_bitmap(dl, U8G2_DL_CMD_XBM, x, y, w, h, bitmap);
+}
+
+void u8g2_DLDrawTileBitmap(u8g2_t *u8g2, u8g2_dlist_t *dl, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_dl_add_bitmap(dl, U8G2_DL_CMD_TILE_BITMAP, x, y, w, h, bitmap);
+}
+
+/*==========================================*/
+/* replay */
+
+static const uint8_t *u8g2_dl_get_uint(const uint8_t *p, u8g2_uint_t *v)
+{
+  memcpy(v, p, sizeof(u8g2_uint_t));
+  return p + sizeof(u8g2_uint_t);
+}
+
+static const uint8_t *u8g2_dl_get_ptr(const uint8_t *p, const uint8_t **ptr)
+{
+  memcpy(ptr, p, sizeof(const uint8_t *));
+  return p + sizeof(const uint8_t *);
+}
+
+/* length of the arguments of a command with bounding box */
+static uint16_t u8g2_dl_get_arg_len(uint8_t cmd, const uint8_t *p)
+{
+  switch(cmd)
+  {
+    case U8G2_DL_CMD_LINE:
+      return 4*sizeof(u8g2_uint_t);
+    case U8G2_DL_CMD_CIRCLE:
+    case U8G2_DL_CMD_DISC:
+      return 1;
+    case U8G2_DL_CMD_STR:
+    case U8G2_DL_CMD_UTF8:
+      return 2*sizeof(u8g2_uint_t) + strlen((const char *)p + 2*sizeof(u8g2_uint_t)) + 1;
+    case U8G2_DL_CMD_GLYPH:
+      return 2*sizeof(u8g2_uint_t) + 2;
+    case U8G2_DL_CMD_XBM:
+    case U8G2_DL_CMD_TILE_BITMAP:
+      return sizeof(const void *);
+  }
+  return 0;
+}
+
+static void u8g2_dl_draw(u8g2_t *u8g2, uint8_t cmd, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1, const uint8_t *p)
+{
+  u8g2_uint_t a, b, c, d;
+  const uint8_t *ptr;
+  uint16_t encoding;
+  
+  switch(cmd)
+  {
+    case U8G2_DL_CMD_BOX:
+      u8g2_DrawBox(u8g2, x0, y0, x1-x0, y1-y0);
+      break;
+    case U8G2_DL_CMD_FRAME:
+      u8g2_DrawFrame(u8g2, x0, y0, x1-x0, y1-y0);
+      break;
+    case U8G2_DL_CMD_HLINE:
+      u8g2_DrawHLine(u8g2, x0, y0, x1-x0);
+      break;
+    case U8G2_DL_CMD_VLINE:
+      u8g2_DrawVLine(u8g2, x0, y0, y1-y0);
+      break;
+    case U8G2_DL_CMD_LINE:
+      p = u8g2_dl_get_uint(p, &a);
+      p = u8g2_dl_get_uint(p, &b);
+      p = u8g2_dl_get_uint(p, &c);
+      u8g2_dl_get_uint(p, &d);
+      u8g2_DrawLine(u8g2, a, b, c, d);
+      break;
+    case U8G2_DL_CMD_CIRCLE:
+      u8g2_DrawCircle(u8g2, x0 + (x1-x0)/2, y0 + (y1-y0)/2, (x1-x0)/2, *p);
+      break;
+    case U8G2_DL_CMD_DISC:
+      u8g2_DrawDisc(u8g2, x0 + (x1-x0)/2, y0 + (y1-y0)/2, (x1-x0)/2, *p);
+      break;
+    case U8G2_DL_CMD_STR:
+    case U8G2_DL_CMD_UTF8:
+    case U8G2_DL_CMD_GLYPH:
+      p = u8g2_dl_get_uint(p, &a);
+      p = u8g2_dl_get_uint(p, &b);
+      if ( cmd == U8G2_DL_CMD_STR )
+	u8g2_DrawStr(u8g2, a, b, (const char *)p);
+      else if ( cmd == U8G2_DL_CMD_UTF8 )
+	u8g2_DrawUTF8(u8g2, a, b, (const char *)p);
+      else
+      {
+	memcpy(&encoding, p, 2);
+	u8g2_DrawGlyph(u8g2, a, b, encoding);
+      }
+      break;
+    case U8G2_DL_CMD_XBM:
+      u8g2_dl_get_ptr(p, &ptr);
+      u8g2_DrawXBM(u8g2, x0, y0, x1-x0, y1-y0, ptr);
+      break;
+    case U8G2_DL_CMD_TILE_BITMAP:
+      u8g2_dl_get_ptr(p, &ptr);
+      u8g2_DrawTileBitmap(u8g2, x0, y0, x1-x0, y1-y0, ptr);
+      break;
+  }
+}
+
+/*
+  Draw all commands of the display list which intersect the current page.
+  Call this once for each page between u8g2_FirstPage() and u8g2_NextPage().
+*/
+void u8g2_DrawDisplayList(u8g2_t *u8g2, const u8g2_dlist_t *dl)
+{
+  const uint8_t *p = dl->buf;
+  const uint8_t *end = dl->buf + dl->len;
+  const uint8_t *font = u8g2->font;
+  const uint8_t *ptr;
+  u8g2_font_calc_vref_fnptr font_calc_vref = u8g2->font_calc_vref;
+  uint8_t draw_color = u8g2->draw_color;
+  uint8_t font_mode = u8g2->font_decode.is_transparent;
+  uint8_t bitmap_mode = u8g2->bitmap_transparency;
+  u8g2_uint_t x0, y0, x1, y1;
+  uint8_t cmd;
+  
+  /* text positions are recorded as baseline */
+  u8g2_SetFontPosBaseline(u8g2);
+  
+  while( p < end )
+  {
+    cmd = *p++;
+    switch(cmd)
+    {
+      case U8G2_DL_CMD_DRAW_COLOR:
+	u8g2_SetDrawColor(u8g2, *p++);
+	break;
+      case U8G2_DL_CMD_FONT_MODE:
+	u8g2_SetFontMode(u8g2, *p++);
+	break;
+      case U8G2_DL_CMD_BITMAP_MODE:
+	u8g2_SetBitmapMode(u8g2, *p++);
+	break;
+      case U8G2_DL_CMD_FONT:
+	p = u8g2_dl_get_ptr(p, &ptr);
+	u8g2_SetFont(u8g2, ptr);
+	break;
+      default:
+	p = u8g2_dl_get_uint(p, &x0);
+	p = u8g2_dl_get_uint(p, &y0);
+	p = u8g2_dl_get_uint(p, &x1);
+	p = u8g2_dl_get_uint(p, &y1);
+	if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) != 0 )
+	  u8g2_dl_draw(u8g2, cmd, x0, y0, x1, y1, p);
+	p += u8g2_dl_get_arg_len(cmd, p);
+	break;
+    }
+  }
+  
+  if ( font != NULL )
+    u8g2_SetFont(u8g2, font);
+  u8g2->font_calc_vref = font_calc_vref;
+  u8g2_SetDrawColor(u8g2, draw_color);
+  u8g2_SetFontMode(u8g2, font_mode);
+  u8g2_SetBitmapMode(u8g2, bitmap_mode);
+}
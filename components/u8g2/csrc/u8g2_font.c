@@ -34,11 +34,15 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
 #define U8G2_FONT_DATA_STRUCT_SIZE 23
 
+/* bbx_mode flag of fonts with glyph index */
+#define U8G2_FONT_BBX_MODE_GLYPH_INDEX 0x80
+
 /*
   font data:
 
@@ -73,6 +77,19 @@
   21		1		start pos unicode high byte
   22		1		start pos unicode low byte
 
+  Glyph index (bdfconv -f 3):
+    bbx_mode has bit 7 (U8G2_FONT_BBX_MODE_GLYPH_INDEX) set. The first glyph
+    record has encoding 0 and size 5, which is skipped by the linear search.
+    Its 3 data bytes are the position of the glyph index (high byte first).
+    The glyph index is appended after the unicode glyphs:
+    0		1		first ASCII encoding
+    1		1		last ASCII encoding (less than first if there are no ASCII glyphs)
+    2		2*n		position of each ASCII glyph from first to last, 0 if missing
+    ...		2		number of unicode glyphs m
+    ...		3*m		position of each unicode glyph, sorted by encoding
+    All positions are relative to the end of the font header. Fonts without
+    glyph index are still searched as before.
+
   Font build mode, 0: proportional, 1: common height, 2: monospace, 3: multiple of 8
 
   Font build mode 0:		
@@ -163,6 +180,17 @@ void u8g2_read_font_info(u8g2_font_info_t *font_info, const uint8_t *font)
 #ifdef U8G2_WITH_UNICODE
   font_info->start_pos_unicode = u8g2_font_get_word(font, 21); 
 #endif
+
+  /* glyph index position is stored in the first (dummy) glyph record */
+  font_info->glyph_index_pos = 0;
+  if ( font_info->bbx_mode & U8G2_FONT_BBX_MODE_GLYPH_INDEX )
+  {
+    font_info->glyph_index_pos = u8g2_font_get_byte(font, U8G2_FONT_DATA_STRUCT_SIZE+2);
+    font_info->glyph_index_pos <<= 8;
+    font_info->glyph_index_pos |= u8g2_font_get_byte(font, U8G2_FONT_DATA_STRUCT_SIZE+3);
+    font_info->glyph_index_pos <<= 8;
+    font_info->glyph_index_pos |= u8g2_font_get_byte(font, U8G2_FONT_DATA_STRUCT_SIZE+4);
+  }
 }
 
 
@@ -173,6 +201,26 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg)
   const uint8_t *font = font_arg;
   font += U8G2_FONT_DATA_STRUCT_SIZE;
   
+  /* the glyph index is the last part of the font */
+  if ( u8x8_pgm_read( font_arg + 1 ) & U8G2_FONT_BBX_MODE_GLYPH_INDEX )
+  {
+    uint32_t pos;
+    uint8_t first, last;
+    pos = u8x8_pgm_read( font + 2 );
+    pos <<= 8;
+    pos |= u8x8_pgm_read( font + 3 );
+    pos <<= 8;
+    pos |= u8x8_pgm_read( font + 4 );
+    font += pos;
+    first = u8x8_pgm_read( font );
+    last = u8x8_pgm_read( font + 1 );
+    font += 2;
+    if ( first <= last )
+      font += ((uint16_t)(last - first) + 1)*2;
+    font += u8g2_font_get_word(font, 0)*(size_t)3 + 2;
+    return font - font_arg;
+  }
+  
   for(;;)
   {
     if ( u8x8_pgm_read( font + 1 ) == 0 )
@@ -470,6 +518,192 @@ static void u8g2_font_setup_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
 }
 
 
+#if defined(U8G2_WITH_GLYPH_CACHE) || defined(U8G2_WITH_TILE_GLYPH_DECODE)
+
+/* combine one byte of the glyph into the buffer, fg and bbx are already shifted and masked */
+static void u8g2_font_tile_put_byte(u8g2_t *u8g2, uint8_t *dest, uint8_t fg, uint8_t bbx)
+{
+  uint8_t bg;
+  switch( u8g2->draw_color )
+  {
+    case 0:
+      *dest &= ~fg;
+      break;
+    case 1:
+      *dest |= fg;
+      break;
+    default:
+      *dest ^= fg;
+      break;
+  }
+  if ( u8g2->font_decode.is_transparent == 0 )
+  {
+    bg = bbx & ~fg;
+    if ( u8g2->draw_color == 0 )
+      *dest |= bg;
+    else
+      *dest &= ~bg;
+  }
+}
+
+/* pixel rows of tile row "dest_row" which are inside the current window */
+static uint8_t u8g2_font_tile_row_mask(u8g2_t *u8g2, int16_t dest_row)
+{
+  uint8_t mask = 0, b;
+  int16_t py = dest_row*8;
+  for( b = 0; b < 8; b++, py++ )
+    if ( py >= (int16_t)u8g2->user_y0 && py < (int16_t)u8g2->user_y1 )
+      mask |= 1<<b;
+  return mask;
+}
+
+#endif /* U8G2_WITH_GLYPH_CACHE || U8G2_WITH_TILE_GLYPH_DECODE */
+
+#ifdef U8G2_WITH_TILE_GLYPH_DECODE
+
+/*
+  combine the decoded pixel rows of one tile row with the buffer
+  py: screen y position of the first pixel row of the tile row (multiple of 8)
+  col: foreground bits of each glyph column, rows: glyph pixel rows within this tile row
+*/
+static void u8g2_font_tile_put_row(u8g2_t *u8g2, const uint8_t *col, uint8_t cx0, uint8_t cx1, int16_t tx, int16_t py, uint8_t rows)
+{
+  int16_t dest_row = (py+256)/8 - 32;		/* floor(py/8) for py >= -256 */
+  uint8_t mask, c;
+  uint8_t *dest;
+
+  if ( dest_row < u8g2->tile_curr_row || dest_row >= u8g2->tile_curr_row + (u8g2->pixel_buf_height>>3) )
+    return;
+  mask = u8g2_font_tile_row_mask(u8g2, dest_row) & rows;
+  if ( mask == 0 )
+    return;
+  dest = u8g2->tile_buf_ptr + (dest_row - u8g2->tile_curr_row)*u8g2->pixel_buf_width;
+  for( c = cx0; c < cx1; c++ )
+    u8g2_font_tile_put_byte(u8g2, dest + (tx + c), col[c] & mask, mask);
+}
+
+/*
+  Decode the glyph directly into the tile buffer. Same result as the
+  u8g2_font_decode_len() loop in u8g2_font_decode_glyph().
+  Clipping is done once for the glyph: Only columns inside the user window
+  are written, pixel rows are masked when the column bytes are stored.
+  returns 0 if the glyph has to be decoded with u8g2_font_decode_len()
+*/
+static uint8_t u8g2_font_decode_glyph_tile(u8g2_t *u8g2)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t col[U8G2_TILE_GLYPH_MAX_WIDTH];
+  uint8_t a, b, w, h, lx, ly, cnt, rem, current, bit, rows;
+  uint8_t cx0, cx1;
+  int16_t tx, ty, py;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( decode->dir != 0 )
+    return 0;
+#endif
+  if ( u8g2_is_r0_buffer(u8g2) == 0 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  w = decode->glyph_width;
+  h = decode->glyph_height;
+  if ( w > U8G2_TILE_GLYPH_MAX_WIDTH )
+    return 0;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  /* target position might be "negative": glyph starts left of or above the buffer */
+  tx = decode->target_x;
+  if ( (u8g2_uint_t)(decode->target_x + w) < decode->target_x )
+    tx -= (int16_t)((u8g2_uint_t)~(u8g2_uint_t)0) + 1;
+  ty = decode->target_y;
+  if ( (u8g2_uint_t)(decode->target_y + h) < decode->target_y )
+    ty -= (int16_t)((u8g2_uint_t)~(u8g2_uint_t)0) + 1;
+
+  /* visible glyph columns */
+  cx0 = 0;
+  if ( tx < (int16_t)u8g2->user_x0 )
+    cx0 = (int16_t)u8g2->user_x0 - tx < w ? (int16_t)u8g2->user_x0 - tx : w;
+  cx1 = w;
+  if ( tx + w > (int16_t)u8g2->user_x1 )
+    cx1 = (int16_t)u8g2->user_x1 - tx > cx0 ? (int16_t)u8g2->user_x1 - tx : cx0;
+
+  memset(col, 0, w);
+  lx = 0;
+  ly = 0;
+  py = ty;
+  bit = 1 << ((py+256) & 7);
+  rows = h > 0 ? bit : 0;
+  for(;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+    do
+    {
+      /* background run: only advance the position */
+      cnt = a;
+      for(;;)
+      {
+	rem = w - lx;
+	if ( cnt < rem )
+	  break;
+	cnt -= rem;
+	lx = 0;
+	ly++;
+	py++;
+	bit <<= 1;
+	if ( bit == 0 )
+	{
+	  u8g2_font_tile_put_row(u8g2, col, cx0, cx1, tx, py-8, rows);
+	  memset(col, 0, w);
+	  bit = 1;
+	  rows = 0;
+	}
+	if ( ly < h )
+	  rows |= bit;
+      }
+      lx += cnt;
+
+      /* foreground run: set the bit of the current pixel row in each column */
+      cnt = b;
+      for(;;)
+      {
+	rem = w - lx;
+	current = cnt < rem ? cnt : rem;
+	if ( ly < h )
+	  for( ; current > 0; current--, lx++ )
+	    col[lx] |= bit;
+	else
+	  lx += current;
+	if ( cnt < rem )
+	  break;
+	cnt -= rem;
+	lx = 0;
+	ly++;
+	py++;
+	bit <<= 1;
+	if ( bit == 0 )
+	{
+	  u8g2_font_tile_put_row(u8g2, col, cx0, cx1, tx, py-8, rows);
+	  memset(col, 0, w);
+	  bit = 1;
+	  rows = 0;
+	}
+	if ( ly < h )
+	  rows |= bit;
+      }
+    } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+    if ( ly >= h )
+      break;
+  }
+  if ( rows != 0 )
+    u8g2_font_tile_put_row(u8g2, col, cx0, cx1, tx, py - ((py+256) & 7), rows);
+  return 1;
+}
+
+#endif /* U8G2_WITH_TILE_GLYPH_DECODE */
+
 /*
   Description:
     Decode and draw a glyph.
@@ -556,6 +790,11 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
     }
 #endif /* U8G2_WITH_INTERSECTION */
    
+#ifdef U8G2_WITH_TILE_GLYPH_DECODE
+    if ( u8g2_font_decode_glyph_tile(u8g2) != 0 )
+      return d;
+#endif /* U8G2_WITH_TILE_GLYPH_DECODE */
+
     /* reset local x/y position */
     decode->x = 0;
     decode->y = 0;
@@ -589,11 +828,71 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   Return:
     Address of the glyph data or NULL, if the encoding is not avialable in the font.
 */
+static const uint8_t *u8g2_font_get_indexed_glyph_data(u8g2_t *u8g2, uint16_t encoding)
+{
+  const uint8_t *font = u8g2->font;
+  const uint8_t *index;
+  uint16_t pos;
+  uint8_t first, last;
+  
+  font += U8G2_FONT_DATA_STRUCT_SIZE;
+  index = font + u8g2->font_info.glyph_index_pos;
+  first = u8x8_pgm_read( index );
+  last = u8x8_pgm_read( index + 1 );
+  index += 2;
+  
+  if ( encoding <= 255 )
+  {
+    /* direct lookup */
+    if ( encoding < first || encoding > last )
+      return NULL;
+    pos = u8g2_font_get_word(index + (encoding - first)*2, 0);
+    if ( pos == 0 )
+      return NULL;
+    return font + pos + 2;	/* skip encoding and glyph size */
+  }
+#ifdef U8G2_WITH_UNICODE
+  else
+  {
+    uint16_t lo, hi, mid, e;
+    uint32_t p;
+    const uint8_t *glyph;
+    
+    /* binary search in the sorted unicode positions */
+    if ( first <= last )
+      index += ((uint16_t)(last - first) + 1)*2;
+    lo = 0;
+    hi = u8g2_font_get_word(index, 0);
+    index += 2;
+    while( lo < hi )
+    {
+      mid = lo + (hi - lo)/2;
+      p = u8x8_pgm_read( index + mid*3 );
+      p <<= 8;
+      p |= u8x8_pgm_read( index + mid*3 + 1 );
+      p <<= 8;
+      p |= u8x8_pgm_read( index + mid*3 + 2 );
+      glyph = font + p;
+      e = u8g2_font_get_word(glyph, 0);
+      if ( e == encoding )
+	return glyph+3;	/* skip encoding and glyph size */
+      if ( e < encoding )
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  }
+#endif
+  return NULL;
+}
+
 const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
 {
   const uint8_t *font = u8g2->font;
   font += U8G2_FONT_DATA_STRUCT_SIZE;
 
+  if ( u8g2->font_info.glyph_index_pos != 0 )
+    return u8g2_font_get_indexed_glyph_data(u8g2, encoding);
   
   if ( encoding <= 255 )
   {
@@ -676,6 +975,235 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
   return NULL;
 }
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+
+/*
+  Description:
+    Enable the glyph cache. entries is an array of cnt entries, the memory
+    is owned by the caller. Use cnt = 0 or cache = NULL to disable the cache.
+*/
+void u8g2_SetGlyphCache(u8g2_t *u8g2, u8g2_glyph_cache_t *cache, u8g2_glyph_cache_entry_t *entries, uint8_t cnt)
+{
+  u8g2->glyph_cache = NULL;
+  if ( cache == NULL || cnt == 0 )
+    return;
+  cache->entries = entries;
+  cache->cnt = cnt;
+  u8g2->glyph_cache = cache;
+  u8g2_ClearGlyphCache(u8g2);
+}
+
+/* remove all glyphs and reset the statistics */
+void u8g2_ClearGlyphCache(u8g2_t *u8g2)
+{
+  u8g2_glyph_cache_t *cache = u8g2->glyph_cache;
+  uint8_t i;
+  if ( cache == NULL )
+    return;
+  for( i = 0; i < cache->cnt; i++ )
+    cache->entries[i].font = NULL;
+  cache->clock = 0;
+  cache->hits = 0;
+  cache->misses = 0;
+  cache->bypass = 0;
+}
+
+/*
+  decode the glyph into the cache entry (vertical top layout, no rotation)
+  returns 0 if the glyph does not fit into the entry
+*/
+static uint8_t u8g2_font_decode_to_cache(u8g2_t *u8g2, const uint8_t *glyph_data, u8g2_glyph_cache_entry_t *e)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t a, b, lx, ly, cnt, w, h;
+  uint8_t is_foreground;
+  uint8_t *p;
+
+  u8g2_font_setup_decode(u8g2, glyph_data);
+  w = decode->glyph_width;
+  h = decode->glyph_height;
+  if ( (uint16_t)w * (uint16_t)((h+7)/8) > U8G2_GLYPH_CACHE_DATA_SIZE )
+    return 0;
+
+  e->width = w;
+  e->height = h;
+  e->x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  e->y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  e->delta_x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  memset(e->data, 0, U8G2_GLYPH_CACHE_DATA_SIZE);
+  if ( w == 0 )
+    return 1;
+
+  /* same run length decoding as u8g2_font_decode_glyph(), but into memory */
+  lx = 0;
+  ly = 0;
+  for(;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+    do
+    {
+      for( is_foreground = 0; is_foreground < 2; is_foreground++ )
+      {
+	cnt = is_foreground ? b : a;
+	while( cnt > 0 )
+	{
+	  if ( is_foreground && ly < h )
+	  {
+	    p = e->data + (ly>>3)*w + lx;
+	    *p |= 1<<(ly&7);
+	  }
+	  cnt--;
+	  lx++;
+	  if ( lx >= w )
+	  {
+	    lx = 0;
+	    ly++;
+	  }
+	}
+      }
+    } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+    if ( ly >= h )
+      break;
+  }
+  return 1;
+}
+
+/* find the glyph in the cache, decode it into the least recently used entry if missing */
+static u8g2_glyph_cache_entry_t *u8g2_font_get_cache_entry(u8g2_t *u8g2, uint16_t encoding)
+{
+  u8g2_glyph_cache_t *cache = u8g2->glyph_cache;
+  u8g2_glyph_cache_entry_t *e = cache->entries;
+  u8g2_glyph_cache_entry_t *victim = e;
+  const uint8_t *glyph_data;
+  uint8_t i;
+
+  cache->clock++;
+  for( i = 0; i < cache->cnt; i++, e++ )
+  {
+    if ( e->font == u8g2->font && e->encoding == encoding )
+    {
+      e->last_used = cache->clock;
+      cache->hits++;
+      return e;
+    }
+    /* unused entries first, otherwise the oldest entry */
+    if ( victim->font != NULL && ( e->font == NULL || (uint16_t)(cache->clock - e->last_used) > (uint16_t)(cache->clock - victim->last_used) ) )
+      victim = e;
+  }
+
+  glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
+  if ( glyph_data == NULL || u8g2_font_decode_to_cache(u8g2, glyph_data, victim) == 0 )
+  {
+    cache->bypass++;
+    return NULL;
+  }
+  victim->font = u8g2->font;
+  victim->encoding = encoding;
+  victim->last_used = cache->clock;
+  cache->misses++;
+  return victim;
+}
+
+/*
+  copy a cached glyph into the buffer, x/y: target position of the upper left corner
+  same result as u8g2_font_decode_glyph() for font direction 0
+*/
+static void u8g2_font_draw_cache_entry(u8g2_t *u8g2, const u8g2_glyph_cache_entry_t *e, u8g2_uint_t x, u8g2_uint_t y)
+{
+  int16_t ty, py, dest_row;
+  uint8_t r, c, rows, shift, bbx, mask0, mask1, fg;
+  u8g2_uint_t px;
+  uint8_t *dest;
+  const uint8_t *src;
+
+  /* y might be "negative": glyph starts above the buffer */
+  ty = y;
+  if ( (u8g2_uint_t)(y + e->height) < y )
+    ty -= (int16_t)((u8g2_uint_t)~(u8g2_uint_t)0) + 1;
+
+  rows = (e->height+7)/8;
+  for( r = 0; r < rows; r++ )
+  {
+    bbx = 0xff;
+    if ( e->height - r*8 < 8 )
+      bbx = (1<<(e->height - r*8))-1;
+
+    py = ty + r*8;
+    dest_row = (py+256)/8 - 32;		/* floor(py/8) for py >= -256 */
+    shift = py - dest_row*8;
+
+    /* the glyph row covers dest_row and dest_row+1 */
+    mask0 = 0;
+    mask1 = 0;
+    if ( dest_row >= u8g2->tile_curr_row && dest_row < u8g2->tile_curr_row + (u8g2->pixel_buf_height>>3) )
+      mask0 = u8g2_font_tile_row_mask(u8g2, dest_row);
+    if ( shift != 0 && dest_row+1 >= u8g2->tile_curr_row && dest_row+1 < u8g2->tile_curr_row + (u8g2->pixel_buf_height>>3) )
+      mask1 = u8g2_font_tile_row_mask(u8g2, dest_row+1);
+    if ( (mask0|mask1) == 0 )
+      continue;
+
+    src = e->data + r*e->width;
+    for( c = 0; c < e->width; c++ )
+    {
+      px = x + c;
+      if ( px < u8g2->user_x0 || px >= u8g2->user_x1 )
+	continue;
+      fg = src[c];
+      dest = u8g2->tile_buf_ptr + (dest_row - u8g2->tile_curr_row)*u8g2->pixel_buf_width + px;
+      if ( mask0 != 0 )
+	u8g2_font_tile_put_byte(u8g2, dest, (uint8_t)(fg << shift) & mask0, (uint8_t)(bbx << shift) & mask0);
+      if ( mask1 != 0 )
+      {
+	dest += u8g2->pixel_buf_width;
+	u8g2_font_tile_put_byte(u8g2, dest, (uint8_t)(fg >> (8-shift)) & mask1, (uint8_t)(bbx >> (8-shift)) & mask1);
+      }
+    }
+  }
+}
+
+/*
+  draw the glyph from the cache
+  returns 0 if the cache can not be used, the glyph has to be decoded as usual
+*/
+static uint8_t u8g2_font_draw_cached_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding, u8g2_uint_t *dx)
+{
+  const u8g2_glyph_cache_entry_t *e;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+    return 0;
+#endif
+  if ( u8g2_is_r0_buffer(u8g2) == 0 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+
+  e = u8g2_font_get_cache_entry(u8g2, encoding);
+  if ( e == NULL )
+    return 0;
+
+  *dx = e->delta_x;
+  if ( e->width == 0 )
+    return 1;
+
+  x += e->x;
+  y -= e->height + e->y;
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x + e->width, y + e->height) == 0 )
+    return 1;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  u8g2_font_draw_cache_entry(u8g2, e, x, y);
+  return 1;
+}
+
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
   u8g2_uint_t dx = 0;
@@ -683,6 +1211,10 @@ static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
   u8g2->font_decode.target_y = y;
   //u8g2->font_decode.is_transparent = is_transparent; this is already set
   //u8g2->font_decode.dir = dir;
+#ifdef U8G2_WITH_GLYPH_CACHE
+  if ( u8g2->glyph_cache != NULL && u8g2_font_draw_cached_glyph(u8g2, x, y, encoding, &dx) != 0 )
+    return dx;
+#endif /* U8G2_WITH_GLYPH_CACHE */
   const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
   if ( glyph_data != NULL )
   {
@@ -1237,6 +1769,432 @@ u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str)
   return u8g2_string_width(u8g2, str);
 }
 
+#ifdef U8G2_WITH_TEXT_LAYOUT
+
+/*===============================================*/
+/* text layout */
+
+void u8g2_ClearText(u8g2_text_t *text)
+{
+  text->font = NULL;
+  text->long_str = NULL;
+  text->width = 0;
+  text->ascent = 0;
+  text->descent = 0;
+  text->cnt = 0;
+  text->str[0] = '\0';
+}
+
+/*
+  measure str with the current font and keep the glyph data in text,
+  nothing is done if str and the font did not change since the last call
+  returns the width of str, same as u8g2_GetStrWidth()
+*/
+u8g2_uint_t u8g2_LayoutStr(u8g2_t *u8g2, u8g2_text_t *text, const char *str)
+{
+  u8g2_text_glyph_t *g;
+  uint16_t e;
+  size_t len;
+  u8g2_uint_t w, dx;
+  uint8_t glyph_width;		/* width of the last glyph found in the font */
+  int8_t x_offset, y_offset, top;
+  uint8_t is_extent;
+  
+  if ( text->font == u8g2->font && text->long_str == NULL && strcmp(text->str, str) == 0 )
+    return text->width;
+  
+  u8g2_ClearText(text);
+  len = strlen(str);
+  if ( len > U8G2_TEXT_MAX_LEN )
+  {
+    text->long_str = str;
+    text->width = u8g2_GetStrWidth(u8g2, str);
+    return text->width;
+  }
+  memcpy(text->str, str, len+1);
+  text->font = u8g2->font;
+  
+  u8g2->u8x8.next_cb = u8x8_ascii_next;
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  w = 0;
+  dx = 0;
+  glyph_width = 0;
+  x_offset = 0;
+  is_extent = 0;
+  for(;;)
+  {
+    e = u8g2->u8x8.next_cb(u8g2_GetU8x8(u8g2), (uint8_t)*str);
+    if ( e == 0x0ffff )
+      break;
+    str++;
+    if ( e == 0x0fffe )
+      continue;
+    g = text->glyph + text->cnt;
+    text->cnt++;
+    g->encoding = e;
+    g->delta_x = 0;
+    g->data = u8g2_font_get_glyph_data(u8g2, e);
+    dx = 0;
+    if ( g->data == NULL )
+      continue;
+    
+    u8g2_font_setup_decode(u8g2, g->data);
+    glyph_width = u8g2->font_decode.glyph_width;
+    x_offset = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_x);
+    y_offset = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_y);
+    g->delta_x = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_delta_x);
+    dx = (u8g2_uint_t)g->delta_x;
+    w += dx;
+    
+    /* extent of all glyphs with pixels */
+    if ( glyph_width != 0 && u8g2->font_decode.glyph_height != 0 )
+    {
+      top = y_offset + u8g2->font_decode.glyph_height;
+      if ( is_extent == 0 || top > text->ascent )
+	text->ascent = top;
+      if ( is_extent == 0 || y_offset < text->descent )
+	text->descent = y_offset;
+      is_extent = 1;
+    }
+  }
+  
+  /* same adjustment of the last glyph as in u8g2_string_width() */
+  if ( glyph_width != 0 )
+  {
+    w -= dx;
+    w += glyph_width;
+    w += x_offset;
+  }
+  text->width = w;
+  return w;
+}
+
+/* add the reference point offset of the current font, see u8g2_DrawGlyph() */
+static void u8g2_text_add_vref(u8g2_t *u8g2, u8g2_uint_t *x, u8g2_uint_t *y)
+{
+#ifdef U8G2_WITH_FONT_ROTATION
+  switch(u8g2->font_decode.dir)
+  {
+    case 0:
+      *y += u8g2->font_calc_vref(u8g2);
+      break;
+    case 1:
+      *x -= u8g2->font_calc_vref(u8g2);
+      break;
+    case 2:
+      *y -= u8g2->font_calc_vref(u8g2);
+      break;
+    case 3:
+      *x += u8g2->font_calc_vref(u8g2);
+      break;
+  }
+#else
+  *y += u8g2->font_calc_vref(u8g2);
+#endif
+}
+
+/* draw cnt laid out glyphs, x/y already include the reference point offset */
+static u8g2_uint_t u8g2_draw_text_glyphs(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_text_glyph_t *g, uint8_t cnt)
+{
+  u8g2_uint_t delta, sum;
+  
+  sum = 0;
+  for( ; cnt > 0; cnt--, g++ )
+  {
+    if ( g->data == NULL )
+      continue;
+    u8g2->font_decode.target_x = x;
+    u8g2->font_decode.target_y = y;
+#ifdef U8G2_WITH_GLYPH_CACHE
+    if ( u8g2->glyph_cache == NULL || u8g2_font_draw_cached_glyph(u8g2, x, y, g->encoding, &delta) == 0 )
+#endif /* U8G2_WITH_GLYPH_CACHE */
+      delta = u8g2_font_decode_glyph(u8g2, g->data);
+    
+#ifdef U8G2_WITH_FONT_ROTATION
+    switch(u8g2->font_decode.dir)
+    {
+      case 0:
+	x += delta;
+	break;
+      case 1:
+	y += delta;
+	break;
+      case 2:
+	x -= delta;
+	break;
+      case 3:
+	y -= delta;
+	break;
+    }
+#else
+    x += delta;
+#endif
+    sum += delta;
+  }
+  return sum;
+}
+
+/*
+  draw the string of u8g2_LayoutStr() with the font of the layout
+  returns the sum of the delta x values like u8g2_DrawStr()
+*/
+u8g2_uint_t u8g2_DrawText(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_text_t *text)
+{
+  if ( text->long_str != NULL )
+    return u8g2_DrawStr(u8g2, x, y, text->long_str);
+  if ( text->font == NULL )
+    return 0;
+  u8g2_SetFont(u8g2, text->font);
+  u8g2_text_add_vref(u8g2, &x, &y);
+  return u8g2_draw_text_glyphs(u8g2, x, y, text->glyph, text->cnt);
+}
+
+/*===============================================*/
+/* multi line text */
+
+static void u8g2_text_set_glyph(u8g2_t *u8g2, u8g2_text_glyph_t *g, uint16_t encoding)
+{
+  g->encoding = encoding;
+  g->delta_x = 0;
+  g->data = u8g2_font_get_glyph_data(u8g2, encoding);
+  if ( g->data == NULL )
+    return;
+  u8g2_font_setup_decode(u8g2, g->data);
+  u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_x);
+  u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_y);
+  g->delta_x = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_delta_x);
+}
+
+/* CJK text has no spaces, a line may break before and after each of these glyphs */
+static uint8_t u8g2_text_is_cjk(uint16_t e)
+{
+  if ( e >= 0x2e80 && e < 0xa000 )
+    return 1;	/* radicals, punctuation, kana, ideographs */
+  if ( e >= 0xf900 && e < 0xfb00 )
+    return 1;	/* compatibility ideographs */
+  if ( e >= 0xff00 && e < 0xfff0 )
+    return 1;	/* halfwidth and fullwidth forms */
+  return 0;
+}
+
+void u8g2_ClearTextBox(u8g2_text_box_t *box)
+{
+  box->font = NULL;
+  box->line_cnt = 0;
+  box->glyph_cnt = 0;
+  box->ellipsis_cnt = 0;
+  box->str[0] = '\0';
+}
+
+/*
+  bytes of str used by a text box: at most U8G2_TEXT_BOX_MAX_LEN, if this
+  cuts a UTF-8 sequence, its lead byte and the continuation bytes
+  (0x80..0xbf) before the cut are left out
+*/
+static uint16_t u8g2_text_box_len(const char *str)
+{
+  uint16_t len = 0;
+  while( len < U8G2_TEXT_BOX_MAX_LEN && str[len] != '\0' )
+    len++;
+  /* the byte after the cut continues a sequence: back off to its lead byte */
+  while( len > 0 && ((uint8_t)str[len] & 0xc0) == 0x80 )
+    len--;
+  return len;
+}
+
+/*
+  wrap the UTF-8 string str with the current font into at most max_lines
+  lines of max_width pixel, nothing is done if str, font, max_width and 
+  max_lines did not change since the last call
+  returns the number of lines
+*/
+uint8_t u8g2_LayoutUTF8Box(u8g2_t *u8g2, u8g2_text_box_t *box, const char *str, u8g2_uint_t max_width, uint8_t max_lines)
+{
+  const char *s;
+  u8g2_text_glyph_t *glyph = box->glyph;
+  u8g2_text_line_t *line;
+  uint16_t e;
+  uint16_t w, brk_w, hyphen_w, ellipsis_w;	/* 16 bit, sums may exceed u8g2_uint_t */
+  uint8_t i, j, start, end, brk, cnt;
+  uint16_t len = u8g2_text_box_len(str);
+  
+  if ( box->font == u8g2->font && box->max_width == max_width && box->max_lines == max_lines 
+      && memcmp(box->str, str, len) == 0 && box->str[len] == '\0' )
+    return box->line_cnt;
+  
+  u8g2_ClearTextBox(box);
+  memcpy(box->str, str, len);
+  box->str[len] = '\0';
+  box->font = u8g2->font;
+  box->max_width = max_width;
+  box->max_lines = max_lines;
+  if ( max_lines > U8G2_TEXT_BOX_MAX_LINES )
+    max_lines = U8G2_TEXT_BOX_MAX_LINES;
+  
+  /* look up the glyphs once, lines only refer to them */
+  u8g2->u8x8.next_cb = u8x8_utf8_next;
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  for( s = box->str; ; s++ )
+  {
+    e = u8g2->u8x8.next_cb(u8g2_GetU8x8(u8g2), (uint8_t)*s);
+    if ( e == 0x0ffff )
+      break;
+    if ( e != 0x0fffe )
+    {
+      u8g2_text_set_glyph(u8g2, glyph + box->glyph_cnt, e);
+      box->glyph_cnt++;
+    }
+  }
+  cnt = box->glyph_cnt;
+  
+  u8g2_text_set_glyph(u8g2, &(box->hyphen), '-');
+  hyphen_w = box->hyphen.delta_x;
+  u8g2_text_set_glyph(u8g2, &(box->ellipsis), 0x2026);
+  box->ellipsis_cnt = 1;
+  if ( box->ellipsis.data == NULL )
+  {
+    u8g2_text_set_glyph(u8g2, &(box->ellipsis), '.');
+    box->ellipsis_cnt = box->ellipsis.data != NULL ? 3 : 0;
+  }
+  ellipsis_w = box->ellipsis_cnt * box->ellipsis.delta_x;
+  
+  i = 0;
+  while( box->line_cnt < max_lines )
+  {
+    while( i < cnt && glyph[i].encoding == ' ' )
+      i++;
+    if ( i >= cnt )
+      break;
+    line = box->line + box->line_cnt;
+    box->line_cnt++;
+    line->suffix = U8G2_TEXT_SUFFIX_NONE;
+    
+    /* add glyphs until the line is full, remember the last break position */
+    start = i;
+    w = 0;
+    brk = start;
+    brk_w = 0;
+    while( i < cnt )
+    {
+      e = glyph[i].encoding;
+      if ( i > start && ( e == ' ' || u8g2_text_is_cjk(e) ) )
+      {
+	brk = i;
+	brk_w = w;
+      }
+      if ( w + glyph[i].delta_x > max_width )
+	break;
+      w += glyph[i].delta_x;
+      i++;
+      if ( e == '-' || u8g2_text_is_cjk(e) )
+      {
+	brk = i;
+	brk_w = w;
+      }
+    }
+    end = i;
+    
+    for( j = i; j < cnt && glyph[j].encoding == ' '; j++ )
+      ;
+    if ( j < cnt )
+    {
+      if ( box->line_cnt == max_lines )
+      {
+	/* last line: remove glyphs until the ellipsis fits */
+	while( end > start && w + ellipsis_w > max_width )
+	{
+	  end--;
+	  w -= glyph[end].delta_x;
+	}
+	if ( box->ellipsis_cnt != 0 )
+	  line->suffix = U8G2_TEXT_SUFFIX_ELLIPSIS;
+	i = cnt;
+      }
+      else if ( brk > start )
+      {
+	end = brk;
+	w = brk_w;
+	i = brk;
+      }
+      else
+      {
+	/* the word is wider than the line: split it with a hyphen */
+	if ( box->hyphen.data != NULL )
+	{
+	  while( end > start + 1 && w + hyphen_w > max_width )
+	  {
+	    end--;
+	    w -= glyph[end].delta_x;
+	  }
+	  line->suffix = U8G2_TEXT_SUFFIX_HYPHEN;
+	}
+	if ( end == start )
+	{
+	  /* a single glyph wider than the line */
+	  w = glyph[start].delta_x;
+	  end = start + 1;
+	}
+	i = end;
+      }
+    }
+    
+    while( end > start && glyph[end-1].encoding == ' ' )
+    {
+      end--;
+      w -= glyph[end].delta_x;
+    }
+    if ( line->suffix == U8G2_TEXT_SUFFIX_HYPHEN )
+      w += hyphen_w;
+    else if ( line->suffix == U8G2_TEXT_SUFFIX_ELLIPSIS )
+      w += ellipsis_w;
+    line->start = start;
+    line->cnt = end - start;
+    line->width = w;
+  }
+  return box->line_cnt;
+}
+
+/*
+  draw the lines of u8g2_LayoutUTF8Box(), y is the reference point of the 
+  first line, the next lines follow line_height pixel below (font direction 0),
+  align is one of U8G2_TEXT_ALIGN_LEFT, _CENTER and _RIGHT within max_width
+*/
+void u8g2_DrawTextBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t line_height, const u8g2_text_box_t *box, uint8_t align)
+{
+  const u8g2_text_line_t *line;
+  u8g2_uint_t lx;
+  uint8_t i, j;
+  
+  if ( box->font == NULL )
+    return;
+  u8g2_SetFont(u8g2, box->font);
+  u8g2_text_add_vref(u8g2, &x, &y);
+  for( i = 0, line = box->line; i < box->line_cnt; i++, line++ )
+  {
+    lx = x;
+    if ( line->width < box->max_width )
+    {
+      if ( align == U8G2_TEXT_ALIGN_CENTER )
+	lx += (box->max_width - line->width) / 2;
+      else if ( align == U8G2_TEXT_ALIGN_RIGHT )
+	lx += box->max_width - line->width;
+    }
+    lx += u8g2_draw_text_glyphs(u8g2, lx, y, box->glyph + line->start, line->cnt);
+    if ( line->suffix == U8G2_TEXT_SUFFIX_HYPHEN )
+    {
+      u8g2_draw_text_glyphs(u8g2, lx, y, &(box->hyphen), 1);
+    }
+    else if ( line->suffix == U8G2_TEXT_SUFFIX_ELLIPSIS )
+    {
+      for( j = 0; j < box->ellipsis_cnt; j++ )
+	lx += u8g2_draw_text_glyphs(u8g2, lx, y, &(box->ellipsis), 1);
+    }
+    y += line_height;
+  }
+}
+
+#endif /* U8G2_WITH_TEXT_LAYOUT */
+
 
 
 void u8g2_SetFontDirection(u8g2_t *u8g2, uint8_t dir)
@@ -200,6 +200,49 @@ void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len
     }
 }
 
+/*
+  Draw a filled box with u8g2_ll_box_vertical_top_lsb(). Only valid for
+  U8G2_R0 and the vertical top memory layout. The box is clipped once
+  against the user window, the result is the same as drawing h horizontal
+  lines with u8g2_DrawHVLine().
+*/
+static void u8g2_draw_box_rows_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t w, u8g2_uint_t y0, u8g2_uint_t y1)
+{
+  if ( y0 < u8g2->user_y0 )
+    y0 = u8g2->user_y0;
+  if ( y1 > u8g2->user_y1 )
+    y1 = u8g2->user_y1;
+  if ( y0 >= y1 )
+    return;
+  
+  /* transform to pixel buffer coordinates */
+  u8g2_ll_box_vertical_top_lsb(u8g2, x, y0 - u8g2->pixel_curr_row, w, y1 - y0);
+}
+
+void u8g2_draw_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_uint_t y1;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  if ( w == 0 || h == 0 )
+    return;
+  if ( u8g2_clip_intersection2(&x, &w, u8g2->user_x0, u8g2->user_x1) == 0 )
+    return;
+  
+  y1 = y;
+  y1 += h;
+  if ( y1 < y )
+  {
+    /* the box wraps around: lower part starts at 0 */
+    u8g2_draw_box_rows_vertical_top_lsb(u8g2, x, w, 0, y1);
+    y1 = u8g2->user_y1;
+  }
+  u8g2_draw_box_rows_vertical_top_lsb(u8g2, x, w, y, y1);
+}
+
 void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 {
 // #ifdef U8G2_WITH_INTERSECTION
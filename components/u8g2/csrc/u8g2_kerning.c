@@ -43,7 +43,32 @@ uint8_t u8g2_GetNullKerning(u8g2_t *u8g2, uint16_t e1, uint16_t e2)
 }
 */
 
-/* this function is used as "u8g2_get_kerning_cb" */
+/*
+  binary search for e in the ascending table a[lo..hi-1]
+  returns the index of e or hi if e is not part of the table
+*/
+static uint16_t u8g2_kerning_find(const uint16_t *a, uint16_t lo, uint16_t hi, uint16_t e)
+{
+  uint16_t end = hi;
+  uint16_t mid;
+  while( lo < hi )
+  {
+    mid = lo + ((hi - lo) >> 1);
+    if ( a[mid] < e )
+      lo = mid + 1;
+    else if ( a[mid] > e )
+      hi = mid;
+    else
+      return mid;
+  }
+  return end;
+}
+
+/* 
+  this function is used as "u8g2_get_kerning_cb" 
+  first_encoding_table and each range of second_encoding_table must be sorted
+  in ascending order (bdfconv writes them this way)
+*/
 uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2)
 {
   uint16_t i1, i2, cnt, end;
@@ -52,35 +77,56 @@ uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint1
   
   /* search for the encoding in the first table */
   cnt = kerning->first_table_cnt;
+  if ( cnt == 0 )
+    return 0;
   cnt--;	/* ignore the last element of the table, which is 0x0ffff */
-  for( i1 = 0; i1 < cnt; i1++ )
-  {
-    if ( kerning->first_encoding_table[i1] == e1 )
-      break;
-  }
+  i1 = u8g2_kerning_find(kerning->first_encoding_table, 0, cnt, e1);
   if ( i1 >= cnt )
     return 0;	/* e1 not part of the kerning table, return 0 */
 
   /* get the upper index for i2 */
   end = kerning->index_to_second_table[i1+1];
-  for( i2 = kerning->index_to_second_table[i1]; i2 < end; i2++ )
-  {
-    if ( kerning->second_encoding_table[i2] == e2 )
-      break;
-  }
-  
+  i2 = u8g2_kerning_find(kerning->second_encoding_table, kerning->index_to_second_table[i1], end, e2);
   if ( i2 >= end )
     return 0;	/* e2 not part of any pair with e1, return 0 */
   
   return kerning->kerning_values[i2];
 }
 
+/*
+  kt is a list of triples (first encoding, second encoding, kerning value), 
+  terminated by 0x0ffff.
+  If kt starts with U8G2_KERNING_SORTED_TABLE, the next element is the number
+  of triples, which follow sorted by first and then by second encoding
+  (bdfconv -k writes this table as <fontname>_kt). The pair is found by 
+  binary search, otherwise all triples are compared.
+*/
 uint8_t u8g2_GetKerningByTable(U8X8_UNUSED u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2)
 {
   uint16_t i;
+  uint16_t lo, hi;
+  const uint16_t *p;
   i = 0;
   if ( kt == NULL )
     return 0;
+  if ( kt[0] == U8G2_KERNING_SORTED_TABLE )
+  {
+    lo = 0;
+    hi = kt[1];
+    kt += 2;
+    while( lo < hi )
+    {
+      i = lo + ((hi - lo) >> 1);
+      p = kt + 3*(uint32_t)i;
+      if ( p[0] < e1 || ( p[0] == e1 && p[1] < e2 ) )
+	lo = i + 1;
+      else if ( p[0] == e1 && p[1] == e2 )
+	return p[2];
+      else
+	hi = i;
+    }
+    return 0;
+  }
   for(;;)
   {
     if ( kt[i] == 0x0ffff )
@@ -91,4 +137,3 @@ uint8_t u8g2_GetKerningByTable(U8X8_UNUSED u8g2_t *u8g2, const uint16_t *kt, uin
   }
   return 0;
 }
-
@@ -50,6 +50,7 @@
 
 #include "u8g2.h"
 #include <assert.h>
+#include <string.h>
 
 /*=================================================*/
 /*
@@ -61,6 +62,67 @@
 
 #ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
 
+/*
+  The tile buffer is uint8_t, so u8g2_ll_fill_bytes() reads and writes
+  words with memcpy, a uint32_t pointer would break the strict aliasing
+  rule. The pointer is 4 byte aligned there, with GCC each memcpy is one
+  aligned load or store, also on targets without unaligned access.
+*/
+#ifdef __GNUC__
+#  define U8G2_ASSUME_ALIGNED4(p) __builtin_assume_aligned((p), 4)
+#else
+#  define U8G2_ASSUME_ALIGNED4(p) (p)
+#endif
+
+/*
+  apply or_mask and xor_mask to len bytes, the aligned part is processed
+  with 32 bit access, complete bytes with memset
+*/
+static void u8g2_ll_fill_bytes(uint8_t *ptr, u8g2_uint_t len, uint8_t or_mask, uint8_t xor_mask)
+{
+  uint8_t *word_ptr;
+  uint32_t word, or_mask32, xor_mask32;
+  
+  if ( or_mask == 0xff )
+  {
+    memset(ptr, (uint8_t)~xor_mask, len);
+    return;
+  }
+  
+  while( len != 0 && ((uintptr_t)ptr & 3) != 0 )
+  {
+    *ptr |= or_mask;
+    *ptr ^= xor_mask;
+    ptr++;
+    len--;
+  }
+  
+  if ( len >= 4 )
+  {
+    or_mask32 = or_mask * 0x01010101UL;
+    xor_mask32 = xor_mask * 0x01010101UL;
+    word_ptr = U8G2_ASSUME_ALIGNED4(ptr);
+    do
+    {
+      memcpy(&word, word_ptr, 4);
+      word |= or_mask32;
+      word ^= xor_mask32;
+      memcpy(word_ptr, &word, 4);
+      word_ptr += 4;
+      len -= 4;
+    } while( len >= 4 );
+    ptr = word_ptr;
+  }
+  
+  while( len != 0 )
+  {
+    *ptr |= or_mask;
+    *ptr ^= xor_mask;
+    ptr++;
+    len--;
+  }
+}
+
 /*
   x,y		Upper left position of the line within the local buffer (not the display!)
   len		length of the line in pixel, len must not be 0
@@ -99,24 +161,18 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 
 
   offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
-  offset &= ~7;
-  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset >>= 3;
+  offset *= u8g2->pixel_buf_width;	/* not the display width for U8G2_R1_FLUSH and U8G2_R3_FLUSH */
   ptr = u8g2->tile_buf_ptr;
   ptr += offset;
   ptr += x;
   
   if ( dir == 0 )
   {
-      do
-      {
 #ifdef __unix
-	assert(ptr < max_ptr);
+    assert(ptr + len <= max_ptr);
 #endif
-	*ptr |= or_mask;
-	*ptr ^= xor_mask;
-	ptr++;
-	len--;
-      } while( len != 0 );
+    u8g2_ll_fill_bytes(ptr, len, or_mask, xor_mask);
   }
   else
   {    
@@ -151,6 +207,173 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
   }
 }
 
+/*
+  x,y		Upper left position of the box within the local buffer (not the display!)
+  w,h		size of the box, w and h must not be 0
+  asumption: 
+    all clipping done
+  The masks for the upper and lower partial tile row are calculated once,
+  each tile row is filled with u8g2_ll_fill_bytes().
+*/
+void u8g2_ll_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t offset;
+  uint8_t *ptr;
+  uint8_t mask, last_mask;
+  uint8_t tile_rows;
+  uint16_t y_end;
+#ifdef __unix
+  uint8_t *max_ptr = u8g2->tile_buf_ptr + u8g2_GetU8x8(u8g2)->display_info->tile_width*u8g2->tile_buf_height*8;
+#endif
+
+  y_end = y;		/* 16 bit, y+h might overflow */
+  y_end += h;
+  mask = 0xff << (y & 7);
+  last_mask = 0xff >> ((8 - (y_end & 7)) & 7);
+  tile_rows = ((y_end - 1) >> 3) - (y >> 3);
+  
+  offset = y;
+  offset >>= 3;
+  offset *= u8g2->pixel_buf_width;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  ptr += x;
+  
+  for(;;)
+  {
+    if ( tile_rows == 0 )
+      mask &= last_mask;
+#ifdef __unix
+    assert(ptr + w <= max_ptr);
+#endif
+    u8g2_ll_fill_bytes(ptr, w, u8g2->draw_color <= 1 ? mask : 0, u8g2->draw_color != 1 ? mask : 0);
+    if ( tile_rows == 0 )
+      break;
+    tile_rows--;
+    ptr += u8g2->pixel_buf_width;
+    mask = 0xff;
+  }
+}
+
+/* sort n positions and their row bits, insertion sort */
+static void u8g2_ll_sort_pos(u8g2_uint_t *pos, uint8_t *bit, uint8_t n)
+{
+  u8g2_uint_t p;
+  uint8_t b, i, j;
+  
+  /* the rows of a polygon edge are usually sorted in one direction */
+  if ( n > 1 && pos[0] > pos[n-1] )
+  {
+    for( i = 0, j = n-1; i < j; i++, j-- )
+    {
+      p = pos[i]; pos[i] = pos[j]; pos[j] = p;
+      b = bit[i]; bit[i] = bit[j]; bit[j] = b;
+    }
+  }
+  for( i = 1; i < n; i++ )
+  {
+    p = pos[i];
+    b = bit[i];
+    for( j = i; j > 0 && pos[j-1] > p; j-- )
+    {
+      pos[j] = pos[j-1];
+      bit[j] = bit[j-1];
+    }
+    pos[j] = p;
+    bit[j] = b;
+  }
+}
+
+/*
+  y		first row within the local buffer (not the display!)
+  cnt		number of rows, 1..8, all rows are in the same tile row
+  x0, x1	row y+i covers x0[i]..x1[i]-1, nothing if x0[i] >= x1[i]
+  asumption: 
+    all clipping done
+  The start and the end of a row toggle the bit of the row. Between two
+  of these positions all bytes get the same mask, so each byte of the 
+  tile row is written once.
+*/
+void u8g2_ll_spans_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t y, uint8_t cnt, const u8g2_uint_t *x0, const u8g2_uint_t *x1)
+{
+  uint16_t offset;
+  uint8_t *ptr;
+  u8g2_uint_t start[8], end[8];
+  uint8_t start_bit[8], end_bit[8];
+  u8g2_uint_t p, last;
+  uint8_t b, i, j, n, mask;
+  uint8_t or_mask, xor_mask;
+#ifdef __unix
+  uint8_t *max_ptr = u8g2->tile_buf_ptr + u8g2_GetU8x8(u8g2)->display_info->tile_width*u8g2->tile_buf_height*8;
+#endif
+
+  offset = y;
+  offset >>= 3;
+  offset *= u8g2->pixel_buf_width;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  
+  n = 0;
+  b = 1 << (y & 7);
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( x0[i] < x1[i] )
+    {
+      start[n] = x0[i];
+      end[n] = x1[i];
+      start_bit[n] = b;
+      end_bit[n] = b;
+      n++;
+    }
+    b <<= 1;
+  }
+  u8g2_ll_sort_pos(start, start_bit, n);
+  u8g2_ll_sort_pos(end, end_bit, n);
+  
+  /* merge both lists, a start is never behind the end of its row */
+  mask = 0;
+  last = 0;
+  i = 0;
+  j = 0;
+  while( j < n )
+  {
+    if ( i < n && start[i] <= end[j] )
+    {
+      p = start[i];
+      b = start_bit[i++];
+    }
+    else
+    {
+      p = end[j];
+      b = end_bit[j++];
+    }
+    if ( mask != 0 && p > last )
+    {
+#ifdef __unix
+      assert(ptr + p <= max_ptr);
+#endif
+      or_mask = u8g2->draw_color <= 1 ? mask : 0;
+      xor_mask = u8g2->draw_color != 1 ? mask : 0;
+      if ( p - last >= 8 )
+      {
+	u8g2_ll_fill_bytes(ptr + last, p - last, or_mask, xor_mask);
+      }
+      else
+      {
+	/* the runs at the edges of a polygon are short */
+	do
+	{
+	  ptr[last] |= or_mask;
+	  ptr[last] ^= xor_mask;
+	  last++;
+	} while( last != p );
+      }
+    }
+    mask ^= b;
+    last = p;
+  }
+}
+
 
 
 #else /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
@@ -176,8 +399,8 @@ static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_u
   mask <<= bit_pos;
 
   offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
-  offset &= ~7;
-  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset >>= 3;
+  offset *= u8g2->pixel_buf_width;	/* not the display width for U8G2_R1_FLUSH and U8G2_R3_FLUSH */
   ptr = u8g2->tile_buf_ptr;
   ptr += offset;
   ptr += x;
@@ -221,6 +444,33 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 }
 
 
+/*
+  x,y		Upper left position of the box within the local buffer (not the display!)
+  w,h		size of the box, w and h must not be 0
+*/
+void u8g2_ll_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  do
+  {
+    u8g2_ll_hvline_vertical_top_lsb(u8g2, x, y, w, 0);
+    y++;
+    h--;
+  } while( h != 0 );
+}
+
+/*
+  y		first row within the local buffer (not the display!)
+  cnt		number of rows, 1..8, all rows are in the same tile row
+  x0, x1	row y+i covers x0[i]..x1[i]-1, nothing if x0[i] >= x1[i]
+*/
+void u8g2_ll_spans_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t y, uint8_t cnt, const u8g2_uint_t *x0, const u8g2_uint_t *x1)
+{
+  uint8_t i;
+  for( i = 0; i < cnt; i++ )
+    if ( x0[i] < x1[i] )
+      u8g2_ll_hvline_vertical_top_lsb(u8g2, x0[i], y+i, x1[i]-x0[i], 0);
+}
+
 #endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
 
 /*=================================================*/
@@ -2,345 +2,277 @@
 
   u8g22_polygon.c
 
-*/	
-
-
-#include "u8g2.h"
-
-
+  Scan line polygon fill with an edge table.
 
+  All state is in a u8g2_polygon_t and the edge memory of the caller,
+  so that several displays or tasks can draw polygons at the same time.
+  There is no limit for the number of points except the size of the
+  edge memory. Self intersecting and concave polygons are filled with
+  the even-odd rule.
 
-/*===========================================*/
-/* local definitions */
-
-typedef int16_t pg_word_t;
-
+  Pixel rules (same as the previous convex polygon algorithm):
+    an edge from (x1,y1) to (x2,y2) with y1 < y2 covers the scan lines
+    y1..y2-1, the x position on scan line y is
+      x1 + ceil((y-y1)*(x2-x1)/(y2-y1))
+    a span between two edges at x0 < x1 covers x0..x1-1
 
-struct pg_point_struct
-{
-  pg_word_t x;
-  pg_word_t y;
-};
+*/	
 
-typedef struct _pg_struct pg_struct;	/* forward declaration */
 
-struct pg_edge_struct
-{
-  pg_word_t x_direction;	/* 1, if x2 is greater than x1, -1 otherwise */
-  pg_word_t height;
-  pg_word_t current_x_offset;
-  pg_word_t error_offset;
-  
-  /* --- line loop --- */
-  pg_word_t current_y;
-  pg_word_t max_y;
-  pg_word_t current_x;
-  pg_word_t error;
+#include "u8g2.h"
 
-  /* --- outer loop --- */
-  uint8_t (*next_idx_fn)(pg_struct *pg, uint8_t i);
-  uint8_t curr_idx;
-};
 
-/* maximum number of points in the polygon */
-/* can be redefined, but highest possible value is 254 */
+/* number of points of the polygon for u8g2_AddPolygonXY() */
+/* can be redefined */
+#ifndef PG_MAX_POINTS
 #define PG_MAX_POINTS 6
-
-/* index numbers for the pge structures below */
-#define PG_LEFT 0
-#define PG_RIGHT 1
-
-
-struct _pg_struct
-{
-  struct pg_point_struct list[PG_MAX_POINTS];
-  uint8_t cnt;
-  uint8_t is_min_y_not_flat;
-  pg_word_t total_scan_line_cnt;
-  struct pg_edge_struct pge[2];	/* left and right line draw structures */
-};
-
-
-/*===========================================*/
-/* procedures, which should not be inlined (save as much flash ROM as possible */
-
-#define PG_NOINLINE U8G2_NOINLINE
-
-static uint8_t pge_Next(struct pg_edge_struct *pge) PG_NOINLINE;
-static uint8_t pg_inc(pg_struct *pg, uint8_t i) PG_NOINLINE;
-static uint8_t pg_dec(pg_struct *pg, uint8_t i) PG_NOINLINE;
-static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx) PG_NOINLINE;
-static void pg_line_init(pg_struct * const pg, uint8_t pge_index) PG_NOINLINE;
+#endif
 
 /*===========================================*/
-/* line draw algorithm */
+/* span output */
 
-static uint8_t pge_Next(struct pg_edge_struct *pge)
+/* edge[0..cnt-1] are sorted by x, draw the spans of scan line y */
+static void pg_span_row(u8g2_span_t *s, int16_t y, const u8g2_pg_edge_t *edge, uint16_t cnt)
 {
-  if ( pge->current_y >= pge->max_y )
-    return 0;
+  uint16_t i;
   
-  pge->current_x += pge->current_x_offset;
-  pge->error += pge->error_offset;
-  if ( pge->error > 0 )
-  {
-    pge->current_x += pge->x_direction;
-    pge->error -= pge->height;
-  }  
-  
-  pge->current_y++;
-  return 1;
+  for( i = 1; i < cnt; i += 2 )
+    u8g2_span_add(s, y, edge[i-1].x, edge[i].x);
 }
 
-/* assumes y2 > y1 */
-static void pge_Init(struct pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_word_t x2, pg_word_t y2)
-{
-  pg_word_t dx = x2 - x1;
-  pg_word_t width;
+/*===========================================*/
+/* edge table */
 
-  pge->height = y2 - y1;
-  pge->max_y = y2;
-  pge->current_y = y1;
-  pge->current_x = x1;
+/* scan line y1 of the edge */
+static void pg_edge_start(u8g2_pg_edge_t *e)
+{
+  int16_t dx = e->x2 - e->x1;
+  int16_t width;
 
+  e->height = e->y2 - e->y1;
+  e->x = e->x1;
   if ( dx >= 0 )
   {
-    pge->x_direction = 1;
+    e->x_dir = 1;
     width = dx;
-    pge->error = 0;
+    e->err = 0;
   }
   else
   {
-    pge->x_direction = -1;
+    e->x_dir = -1;
     width = -dx;
-    pge->error = 1 - pge->height;
+    e->err = 1 - e->height;
   }
-  
-  pge->current_x_offset = dx / pge->height;
-  pge->error_offset = width % pge->height;
+  e->x_step = dx / e->height;
+  e->err_step = width % e->height;
 }
 
-/*===========================================*/
-/* convex polygon algorithm */
-
-static uint8_t pg_inc(pg_struct *pg, uint8_t i)
-{
-    i++;
-    if ( i >= pg->cnt )
-      i = 0;
-    return i;
-}
-
-static uint8_t pg_dec(pg_struct *pg, uint8_t i)
+static void pg_edge_next(u8g2_pg_edge_t *e)
 {
-    i--;
-    if ( i >= pg->cnt )
-      i = pg->cnt-1;
-    return i;
-}
-
-static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx)
-{
-  uint8_t i = pg->pge[pge_idx].curr_idx;
-  for(;;)
+  e->x += e->x_step;
+  e->err += e->err_step;
+  if ( e->err > 0 )
   {
-    i = pg->pge[pge_idx].next_idx_fn(pg, i);
-    if ( pg->list[i].y != min_y )
-      break;	
-    pg->pge[pge_idx].curr_idx = i;
+    e->x += e->x_dir;
+    e->err -= e->height;
   }
 }
 
-static uint8_t pg_prepare(pg_struct *pg)
+static void pg_edge_swap(u8g2_pg_edge_t *a, u8g2_pg_edge_t *b)
 {
-  pg_word_t max_y;
-  pg_word_t min_y;
-  uint8_t i;
+  u8g2_pg_edge_t tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
 
-  /* setup the next index procedures */
-  pg->pge[PG_RIGHT].next_idx_fn = pg_inc;
-  pg->pge[PG_LEFT].next_idx_fn = pg_dec;
+/*
+  edge[a..b-1] are the active edges, edge[b..cnt-1] start below the
+  current scan line, edges which are done are moved to edge[0..a-1]
+*/
+static void pg_fill(u8g2_t *u8g2, u8g2_pg_edge_t *edge, uint16_t cnt)
+{
+  u8g2_span_t s;
+  u8g2_pg_edge_t *l, *r;
+  uint16_t a, b, i, j;
+  int16_t y, y_end;
   
-  /* search for highest and lowest point */
-  max_y = pg->list[0].y;
-  min_y = pg->list[0].y;
-  pg->pge[PG_LEFT].curr_idx = 0;
-  for( i = 1; i < pg->cnt; i++ )
+  /* sort by the upper end point, insertion sort */
+  for( i = 1; i < cnt; i++ )
+    for( j = i; j > 0 && edge[j-1].y1 > edge[j].y1; j-- )
+      pg_edge_swap(edge+j-1, edge+j);
+  
+  u8g2_span_init(u8g2, &s);
+  a = 0;
+  b = 0;
+  y = edge[0].y1;
+  for(;;)
   {
-    if ( max_y < pg->list[i].y )
+    if ( y >= s.y1 )
+      break;
+    
+    while( b < cnt && edge[b].y1 == y )
     {
-      max_y = pg->list[i].y;
+      pg_edge_start(edge+b);
+      b++;
     }
-    if ( min_y > pg->list[i].y )
+    for( i = a; i < b; i++ )
     {
-      pg->pge[PG_LEFT].curr_idx = i;
-      min_y = pg->list[i].y;
+      if ( edge[i].y2 <= y )
+      {
+	pg_edge_swap(edge+a, edge+i);
+	a++;
+      }
     }
+    if ( a == b )
+    {
+      /* gap between two parts of the polygon */
+      if ( b == cnt )
+	break;
+      y = edge[b].y1;
+      continue;
+    }
+    
+    if ( b - a == 2 )
+    {
+      /* the usual case: two edges until the next point is reached */
+      y_end = s.y1;
+      if ( b < cnt && y_end > edge[b].y1 )
+	y_end = edge[b].y1;
+      l = edge+a;
+      r = l+1;
+      if ( y_end > l->y2 )
+	y_end = l->y2;
+      if ( y_end > r->y2 )
+	y_end = r->y2;
+      do
+      {
+	u8g2_span_add(&s, y, l->x, r->x);
+	pg_edge_next(l);
+	pg_edge_next(r);
+	y++;
+      } while( y < y_end );
+      continue;
+    }
+    
+    /* the order of the active edges changes only at intersections */
+    for( i = a+1; i < b; i++ )
+      for( j = i; j > a && edge[j-1].x > edge[j].x; j-- )
+	pg_edge_swap(edge+j-1, edge+j);
+    
+    if ( y >= s.y0 )
+      pg_span_row(&s, y, edge+a, b-a);
+    
+    for( i = a; i < b; i++ )
+      pg_edge_next(edge+i);
+    y++;
   }
+  u8g2_span_flush(&s);
+}
 
-  /* calculate total number of scan lines */
-  pg->total_scan_line_cnt = max_y;
-  pg->total_scan_line_cnt -= min_y;
-  
-  /* exit if polygon height is zero */
-  if ( pg->total_scan_line_cnt == 0 )
-    return 0;
-  
-  /* if the minimum y side is flat, try to find the lowest and highest x points */
-  pg->pge[PG_RIGHT].curr_idx = pg->pge[PG_LEFT].curr_idx;  
-  pg_expand_min_y(pg, min_y, PG_RIGHT);
-  pg_expand_min_y(pg, min_y, PG_LEFT);
-  
-  /* check if the min side is really flat (depends on the x values) */
-  pg->is_min_y_not_flat = 1;
-  if ( pg->list[pg->pge[PG_LEFT].curr_idx].x != pg->list[pg->pge[PG_RIGHT].curr_idx].x )
-  {
-    pg->is_min_y_not_flat = 0;
-  }
-  else
-  {
-    pg->total_scan_line_cnt--;
-    if ( pg->total_scan_line_cnt == 0 )
-      return 0;
-  }
+/*===========================================*/
+/* API procedures */
 
-  return 1;
+void u8g2_InitPolygon(u8g2_polygon_t *pg, u8g2_pg_edge_t *edge, uint16_t max_cnt)
+{
+  pg->edge = edge;
+  pg->max_cnt = max_cnt;
+  u8g2_ClearPolygon(pg);
+}
+
+void u8g2_ClearPolygon(u8g2_polygon_t *pg)
+{
+  pg->cnt = 0;
+  pg->edge_cnt = 0;
 }
 
-static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
+/* horizontal edges are not stored, there is one entry for each point */
+static void pg_add_edge(u8g2_polygon_t *pg, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  pg_word_t x1, x2, y;
-  x1 = pg->pge[PG_LEFT].current_x;
-  x2 = pg->pge[PG_RIGHT].current_x;
-  y = pg->pge[PG_RIGHT].current_y;
+  u8g2_pg_edge_t *e;
   
-  if ( y < 0 )
-    return;
-  if ( y >= u8g2_GetDisplayHeight(u8g2) )  // does not work for 256x64 display???
+  if ( y1 == y2 )
     return;
-  if ( x1 < x2 )
+  e = pg->edge + pg->edge_cnt;
+  pg->edge_cnt++;
+  if ( y1 < y2 )
   {
-    if ( x2 < 0 )
-      return;
-    if ( x1 >= u8g2_GetDisplayWidth(u8g2) )
-      return;
-    if ( x1 < 0 )
-      x1 = 0;
-    if ( x2 >= u8g2_GetDisplayWidth(u8g2) )
-      x2 = u8g2_GetDisplayWidth(u8g2);
-    u8g2_DrawHLine(u8g2, x1, y, x2 - x1);
+    e->x1 = x1;
+    e->y1 = y1;
+    e->x2 = x2;
+    e->y2 = y2;
   }
   else
   {
-    if ( x1 < 0 )
-      return;
-    if ( x2 >= u8g2_GetDisplayWidth(u8g2) )
-      return;
-    if ( x2 < 0 )
-      x1 = 0;
-    if ( x1 >= u8g2_GetDisplayWidth(u8g2) )
-      x1 = u8g2_GetDisplayWidth(u8g2);
-    u8g2_DrawHLine(u8g2, x2, y, x1 - x2);
+    e->x1 = x2;
+    e->y1 = y2;
+    e->x2 = x1;
+    e->y2 = y1;
   }
 }
 
-static void pg_line_init(pg_struct * const pg, uint8_t pge_index)
-{
-  struct pg_edge_struct  *pge = pg->pge+pge_index;
-  uint8_t idx;  
-  pg_word_t x1;
-  pg_word_t y1;
-  pg_word_t x2;
-  pg_word_t y2;
-
-  idx = pge->curr_idx;  
-  y1 = pg->list[idx].y;
-  x1 = pg->list[idx].x;
-  idx = pge->next_idx_fn(pg, idx);
-  y2 = pg->list[idx].y;
-  x2 = pg->list[idx].x; 
-  pge->curr_idx = idx;
-  
-  pge_Init(pge, x1, y1, x2, y2);
-}
-
-static void pg_exec(pg_struct *pg, u8g2_t *u8g2)
+void u8g2_AddPolygonPoint(u8g2_polygon_t *pg, int16_t x, int16_t y)
 {
-  pg_word_t i = pg->total_scan_line_cnt;
-
-  /* first line is skipped if the min y line is not flat */
-  pg_line_init(pg, PG_LEFT);		
-  pg_line_init(pg, PG_RIGHT);
-  
-  if ( pg->is_min_y_not_flat != 0 )
+  if ( pg->cnt >= pg->max_cnt )
+    return;
+  if ( pg->cnt == 0 )
   {
-    pge_Next(&(pg->pge[PG_LEFT])); 
-    pge_Next(&(pg->pge[PG_RIGHT]));
+    pg->first_x = x;
+    pg->first_y = y;
   }
-
-  do
-  {
-    pg_hline(pg, u8g2);
-    while ( pge_Next(&(pg->pge[PG_LEFT])) == 0 )
-    {
-      pg_line_init(pg, PG_LEFT);
-    }
-    while ( pge_Next(&(pg->pge[PG_RIGHT])) == 0 )
-    {
-      pg_line_init(pg, PG_RIGHT);
-    }
-    i--;
-  } while( i > 0 );
-}
-
-/*===========================================*/
-/* API procedures */
-
-static void pg_ClearPolygonXY(pg_struct *pg)
-{
-  pg->cnt = 0;
-}
-
-static void pg_AddPolygonXY(pg_struct *pg, int16_t x, int16_t y)
-{
-  if ( pg->cnt < PG_MAX_POINTS )
+  else
   {
-    pg->list[pg->cnt].x = x;
-    pg->list[pg->cnt].y = y;
-    pg->cnt++;
+    pg_add_edge(pg, pg->last_x, pg->last_y, x, y);
   }
+  pg->last_x = x;
+  pg->last_y = y;
+  pg->cnt++;
 }
 
-static void pg_DrawPolygon(pg_struct *pg, u8g2_t *u8g2)
+/* the polygon is not changed and can be drawn again */
+void u8g2_FillPolygon(u8g2_t *u8g2, u8g2_polygon_t *pg)
 {
-  if ( pg_prepare(pg) == 0 )
+  uint16_t edge_cnt = pg->edge_cnt;
+  
+  if ( pg->cnt < 3 )
     return;
-  pg_exec(pg, u8g2);
+  /* the closing edge uses the free entry of the last point */
+  pg_add_edge(pg, pg->last_x, pg->last_y, pg->first_x, pg->first_y);
+  if ( pg->edge_cnt >= 2 )
+    pg_fill(u8g2, pg->edge, pg->edge_cnt);
+  pg->edge_cnt = edge_cnt;
 }
 
-pg_struct u8g2_pg;
+/* 
+  shared polygon for u8g2_ClearPolygonXY(), u8g2_AddPolygonXY() and 
+  u8g2_DrawPolygon(), not reentrant, use u8g2_polygon_t instead
+*/
+static u8g2_pg_edge_t u8g2_pg_edge[PG_MAX_POINTS];
+static u8g2_polygon_t u8g2_pg = { u8g2_pg_edge, PG_MAX_POINTS, 0, 0, 0, 0, 0, 0 };
 
 void u8g2_ClearPolygonXY(void)
 {
-  pg_ClearPolygonXY(&u8g2_pg);
+  u8g2_ClearPolygon(&u8g2_pg);
 }
 
 void u8g2_AddPolygonXY(U8X8_UNUSED u8g2_t *u8g2, int16_t x, int16_t y)
 {
-  pg_AddPolygonXY(&u8g2_pg, x, y);
+  u8g2_AddPolygonPoint(&u8g2_pg, x, y);
 }
 
 void u8g2_DrawPolygon(u8g2_t *u8g2)
 {
-  pg_DrawPolygon(&u8g2_pg, u8g2);
+  u8g2_FillPolygon(u8g2, &u8g2_pg);
 }
 
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  u8g2_ClearPolygonXY();
-  u8g2_AddPolygonXY(u8g2, x0, y0);
-  u8g2_AddPolygonXY(u8g2, x1, y1);
-  u8g2_AddPolygonXY(u8g2, x2, y2);
-  u8g2_DrawPolygon(u8g2);
+  u8g2_pg_edge_t edge[3];
+  u8g2_polygon_t pg;
+  
+  u8g2_InitPolygon(&pg, edge, 3);
+  u8g2_AddPolygonPoint(&pg, x0, y0);
+  u8g2_AddPolygonPoint(&pg, x1, y1);
+  u8g2_AddPolygonPoint(&pg, x2, y2);
+  u8g2_FillPolygon(u8g2, &pg);
 }
 
@@ -88,6 +88,14 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
   
+  u8g2->shadow_buf_ptr = NULL;
+  u8g2->is_shadow_buf_valid = 0;
+  u8g2->is_scroll_active = 0;
+  
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2->glyph_cache = NULL;
+#endif
+  
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
@@ -418,12 +426,145 @@ void u8g2_draw_l90_r3(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t le
 
 
 /*============================================*/
-const u8g2_cb_t u8g2_cb_r0 = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_r0 };
-const u8g2_cb_t u8g2_cb_r1 = { u8g2_update_dimension_r1, u8g2_update_page_win_r1, u8g2_draw_l90_r1 };
-const u8g2_cb_t u8g2_cb_r2 = { u8g2_update_dimension_r2, u8g2_update_page_win_r2, u8g2_draw_l90_r2 };
-const u8g2_cb_t u8g2_cb_r3 = { u8g2_update_dimension_r3, u8g2_update_page_win_r3, u8g2_draw_l90_r3 };
+/* rotation while the buffer is sent to the display */
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+
+static uint8_t u8g2_reverse_bits(uint8_t b)
+{
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xcc) >> 2) | ((b & 0x33) << 2);
+  b = ((b & 0xaa) >> 1) | ((b & 0x55) << 1);
+  return b;
+}
+
+/* 
+  U8G2_R1_FLUSH and U8G2_R3_FLUSH: the buffer has the size of the rotated display,
+  tile_width rows of tile_height*8 bytes, only full buffer mode is supported
+*/
+static void u8g2_update_dimension_transposed(u8g2_t *u8g2)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  u8g2_uint_t t;
   
-const u8g2_cb_t u8g2_cb_mirror = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_mirrorr_r0 };
+  u8g2_update_dimension_common(u8g2);
+  
+  t = display_info->tile_height;
+  t *= 8;
+  u8g2->pixel_buf_width = t;
+  t = display_info->tile_width;
+  t *= 8;
+  u8g2->pixel_buf_height = t;
+  u8g2->buf_y0 = 0;
+  u8g2->buf_y1 = t;
+  /* a page buffer is too small, nothing is drawn and u8g2_rotate_tile_row_transposed_ok() fails */
+  if ( u8g2->tile_buf_height < display_info->tile_height )
+    u8g2->buf_y1 = 0;
+  
+  u8g2->width = display_info->pixel_height;
+  u8g2->height = display_info->pixel_width;
+}
+
+static uint8_t u8g2_rotate_tile_row_transposed_ok(u8g2_t *u8g2, uint8_t *dest)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  
+  if ( u8g2->tile_buf_height >= display_info->tile_height )
+    return 1;
+  memset(dest, 0, display_info->tile_width*8);
+  return 0;
+}
+
+/* U8G2_R1: tile row r of the display is the tile column r of the buffer, from bottom to top */
+static uint8_t u8g2_rotate_tile_row_r1(u8g2_t *u8g2, const uint8_t *buf, uint8_t src_tile_row, uint8_t *dest)
+{
+  uint8_t tile[8];
+  const uint8_t *src;
+  uint8_t tx, i;
+  
+  if ( u8g2_rotate_tile_row_transposed_ok(u8g2, dest) == 0 )
+    return src_tile_row;
+  tx = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  src = buf + (uint16_t)tx*u8g2->pixel_buf_width + src_tile_row*8;
+  while( tx > 0 )
+  {
+    src -= u8g2->pixel_buf_width;
+    u8g2_transpose_8x8(src, tile);
+    for( i = 0; i < 8; i++ )
+      *dest++ = tile[7-i];
+    tx--;
+  }
+  return src_tile_row;
+}
+
+/* U8G2_R2: tile row r of the display is the tile row tile_height-1-r of the buffer, reversed */
+static uint8_t u8g2_rotate_tile_row_r2(u8g2_t *u8g2, const uint8_t *buf, uint8_t src_tile_row, uint8_t *dest)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  uint16_t w = display_info->tile_width*8;
+  const uint8_t *src = buf + src_tile_row*w + w;
+  
+  while( w > 0 )
+  {
+    src--;
+    *dest++ = u8g2_reverse_bits(*src);
+    w--;
+  }
+  return display_info->tile_height - 1 - u8g2->tile_curr_row - src_tile_row;
+}
+
+/* U8G2_R3: tile row r of the display is the tile column tile_height-1-r of the buffer, from top to bottom */
+static uint8_t u8g2_rotate_tile_row_r3(u8g2_t *u8g2, const uint8_t *buf, uint8_t src_tile_row, uint8_t *dest)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  uint8_t tile[8];
+  const uint8_t *src;
+  uint8_t tx, i;
+  
+  if ( u8g2_rotate_tile_row_transposed_ok(u8g2, dest) == 0 )
+    return src_tile_row;
+  src = buf + (display_info->tile_height - 1 - src_tile_row)*8;
+  for( tx = 0; tx < display_info->tile_width; tx++ )
+  {
+    u8g2_transpose_8x8(src, tile);
+    for( i = 0; i < 8; i++ )
+      *dest++ = u8g2_reverse_bits(tile[i]);
+    src += u8g2->pixel_buf_width;
+  }
+  return src_tile_row;
+}
+
+/* U8G2_MIRROR: each tile row is reversed */
+static uint8_t u8g2_rotate_tile_row_mirror(u8g2_t *u8g2, const uint8_t *buf, uint8_t src_tile_row, uint8_t *dest)
+{
+  uint16_t w = u8g2_GetU8x8(u8g2)->display_info->tile_width*8;
+  const uint8_t *src = buf + src_tile_row*w + w;
+  
+  while( w > 0 )
+  {
+    src--;
+    *dest++ = *src;
+    w--;
+  }
+  return u8g2->tile_curr_row + src_tile_row;
+}
+
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
+/*============================================*/
+const u8g2_cb_t u8g2_cb_r0 = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_r0 U8G2_CB_NO_FLUSH_ROTATION };
+const u8g2_cb_t u8g2_cb_r1 = { u8g2_update_dimension_r1, u8g2_update_page_win_r1, u8g2_draw_l90_r1 U8G2_CB_NO_FLUSH_ROTATION };
+const u8g2_cb_t u8g2_cb_r2 = { u8g2_update_dimension_r2, u8g2_update_page_win_r2, u8g2_draw_l90_r2 U8G2_CB_NO_FLUSH_ROTATION };
+const u8g2_cb_t u8g2_cb_r3 = { u8g2_update_dimension_r3, u8g2_update_page_win_r3, u8g2_draw_l90_r3 U8G2_CB_NO_FLUSH_ROTATION };
+  
+const u8g2_cb_t u8g2_cb_mirror = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_mirrorr_r0 U8G2_CB_NO_FLUSH_ROTATION };
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+const u8g2_cb_t u8g2_cb_r1_flush = { u8g2_update_dimension_transposed, u8g2_update_page_win_r0, u8g2_draw_l90_r0, u8g2_rotate_tile_row_r1 };
+const u8g2_cb_t u8g2_cb_r2_flush = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_r0, u8g2_rotate_tile_row_r2 };
+const u8g2_cb_t u8g2_cb_r3_flush = { u8g2_update_dimension_transposed, u8g2_update_page_win_r0, u8g2_draw_l90_r0, u8g2_rotate_tile_row_r3 };
+const u8g2_cb_t u8g2_cb_mirror_flush = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_r0, u8g2_rotate_tile_row_mirror };
+#endif /* U8G2_WITH_FLUSH_ROTATION */
   
 /*============================================*/
 /* setup for the null device */
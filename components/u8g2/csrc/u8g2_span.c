@@ -0,0 +1,131 @@
+/*
+
+  u8g2_span.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Horizontal spans of filled shapes (polygon, disc, ellipse, rounded box).
+
+  The shape procedures calculate one span per pixel row and pass it to
+  u8g2_span_add(). The span is clipped once against the visible area. 
+  For U8G2_R0 and the vertical top memory layout the spans of one tile 
+  row are collected and u8g2_ll_spans_vertical_top_lsb() writes each 
+  byte of the tile row once. All other rotations and memory layouts use 
+  u8g2_DrawHVLine().
+
+  Rows of a tile row can be added in any order, a tile row is written
+  when a row of another tile row or a second span of the same row is
+  added, and by u8g2_span_flush().
+
+*/
+
+#include "u8g2.h"
+
+void u8g2_span_init(u8g2_t *u8g2, u8g2_span_t *s)
+{
+  s->u8g2 = u8g2;
+  s->row_mask = 0;
+  if ( u8g2_is_r0_buffer(u8g2) && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    s->is_vertical_top = 1;
+    s->x0 = u8g2->user_x0;
+    s->x1 = u8g2->user_x1;
+    s->y0 = u8g2->user_y0;
+    s->y1 = u8g2->user_y1;
+  }
+  else
+  {
+    /* u8g2_DrawHVLine() clips against the user window and rotates */
+    s->is_vertical_top = 0;
+    s->x0 = 0;
+    s->x1 = u8g2_GetDisplayWidth(u8g2);
+    s->y0 = 0;
+    s->y1 = u8g2_GetDisplayHeight(u8g2);
+  }
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    s->y1 = s->y0;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+}
+
+void u8g2_span_flush(u8g2_span_t *s)
+{
+  uint8_t i;
+  
+  if ( s->row_mask == 0 )
+    return;
+  for( i = 0; i < 8; i++ )
+    if ( (s->row_mask & (1<<i)) == 0 )
+      s->row_x0[i] = s->row_x1[i] = 0;
+  u8g2_ll_spans_vertical_top_lsb(s->u8g2, s->tile_y, 8, s->row_x0, s->row_x1);
+  s->row_mask = 0;
+}
+
+/* span x0..x1-1 (or x1..x0-1) on row y, nothing is drawn for x0 == x1 */
+void u8g2_span_add(u8g2_span_t *s, int16_t y, int16_t x0, int16_t x1)
+{
+  u8g2_uint_t by;
+  uint8_t i, bit;
+  int16_t t;
+  
+  if ( y < s->y0 || y >= s->y1 )
+    return;
+  if ( x0 > x1 )
+  {
+    t = x0;
+    x0 = x1;
+    x1 = t;
+  }
+  if ( x0 < s->x0 )
+    x0 = s->x0;
+  if ( x1 > s->x1 )
+    x1 = s->x1;
+  if ( x0 >= x1 )
+    return;
+  
+  if ( s->is_vertical_top == 0 )
+  {
+    u8g2_DrawHVLine(s->u8g2, x0, y, x1 - x0, 0);
+    return;
+  }
+  
+  /* local buffer position */
+  by = y - s->u8g2->pixel_curr_row;
+  i = by & 7;
+  bit = 1 << i;
+  by -= i;
+  if ( s->row_mask != 0 && ( by != s->tile_y || (s->row_mask & bit) != 0 ) )
+    u8g2_span_flush(s);
+  s->tile_y = by;
+  s->row_mask |= bit;
+  s->row_x0[i] = x0;
+  s->row_x1[i] = x1;
+}
+
@@ -0,0 +1,300 @@
+/*
+
+  u8g2_strip.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Off-screen text strips.
+
+  A string is rendered once with the current font into a strip which may be
+  much wider than the display. Later, any window of the strip can be copied
+  into the current buffer with u8g2_DrawStrip(). This is much faster than
+  decoding all glyphs again with u8g2_DrawStr(), e.g. for scrolling text.
+
+  The strip is divided into chunks. Each chunk has the same width and
+  memory layout as the tile buffer, so the normal glyph procedures can render
+  into a chunk after tile_buf_ptr has been redirected.
+
+  Restrictions:
+    Only for the vertical top memory layout (u8g2_ll_hvline_vertical_top_lsb)
+    and U8G2_R0. Only font direction 0 is supported.
+    u8g2_DrawStrip sets pixels only (transparent, draw color 1).
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+/*
+  number of tile rows required for a strip of the current font
+*/
+uint8_t u8g2_GetStripTileRows(u8g2_t *u8g2)
+{
+  return (uint8_t)((u8g2->font_info.max_char_height+7)/8);
+}
+
+/*
+  draw a glyph into chunk "chunk" of the strip,
+  x is relative to the start of the strip
+*/
+static u8g2_uint_t u8g2_draw_strip_glyph(u8g2_t *u8g2, u8g2_strip_t *strip, uint8_t chunk, uint16_t x, uint16_t encoding)
+{
+  u8g2->tile_buf_ptr = strip->buf;
+  u8g2->tile_buf_ptr += (uint16_t)chunk*(uint16_t)strip->tile_rows*(uint16_t)strip->chunk_width;
+  /* x might be "negative", the intersection procedures take care of the wrap around */
+  x -= (uint16_t)chunk*(uint16_t)strip->chunk_width;
+  return u8g2_DrawGlyph(u8g2, (u8g2_uint_t)x, strip->ascent, encoding);
+}
+
+/*
+  render "str" (one byte per char, like u8g2_DrawStr) with the current font
+  into "buf". The strip is cleared first.
+
+  buf_size: size of buf in bytes, the rendered string is cut at the last
+    complete chunk which fits into buf.
+
+  returns the pixel width of the rendered string (also stored in strip->width)
+*/
+uint16_t u8g2_DrawStrStrip(u8g2_t *u8g2, u8g2_strip_t *strip, uint8_t *buf, uint16_t buf_size, const char *str)
+{
+  uint8_t *tile_buf_ptr = u8g2->tile_buf_ptr;
+  uint8_t tile_buf_height = u8g2->tile_buf_height;
+  uint8_t tile_curr_row = u8g2->tile_curr_row;
+  uint8_t draw_color = u8g2->draw_color;
+  u8g2_font_calc_vref_fnptr font_calc_vref = u8g2->font_calc_vref;
+#ifdef U8G2_WITH_FONT_ROTATION
+  uint8_t dir = u8g2->font_decode.dir;
+#endif
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2_uint_t clip_x0 = u8g2->clip_x0;
+  u8g2_uint_t clip_y0 = u8g2->clip_y0;
+  u8g2_uint_t clip_x1 = u8g2->clip_x1;
+  u8g2_uint_t clip_y1 = u8g2->clip_y1;
+#endif
+  uint16_t chunk_size, capacity, x, e;
+  u8g2_uint_t delta;
+  uint8_t chunk;
+
+  strip->buf = buf;
+  strip->width = 0;
+  strip->chunk_width = u8g2->pixel_buf_width;
+  strip->tile_rows = u8g2_GetStripTileRows(u8g2);
+  strip->ascent = u8g2->font_info.max_char_height + u8g2->font_info.y_offset;
+
+  chunk_size = (uint16_t)strip->tile_rows*(uint16_t)strip->chunk_width;
+  strip->chunk_cnt = 0;
+  if ( chunk_size > 0 )
+    strip->chunk_cnt = buf_size / chunk_size;
+  if ( strip->chunk_cnt == 0 )
+    return 0;
+  capacity = (uint16_t)strip->chunk_cnt*(uint16_t)strip->chunk_width;
+  memset(buf, 0, (size_t)strip->chunk_cnt*chunk_size);
+
+  /* redirect the buffer to the chunks, each chunk is a page with tile_rows height */
+  u8g2->tile_buf_height = strip->tile_rows;
+  u8g2->draw_color = 1;
+  u8g2_SetFontPosBaseline(u8g2);
+#ifdef U8G2_WITH_FONT_ROTATION
+  u8g2->font_decode.dir = 0;
+#endif
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2->clip_x0 = 0;
+  u8g2->clip_y0 = 0;
+  u8g2->clip_x1 = (u8g2_uint_t)~(u8g2_uint_t)0;
+  u8g2->clip_y1 = (u8g2_uint_t)~(u8g2_uint_t)0;
+#endif
+  u8g2_SetBufferCurrTileRow(u8g2, 0);
+
+  x = 0;
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  for(;;)
+  {
+    e = u8x8_ascii_next(u8g2_GetU8x8(u8g2), (uint8_t)*str);
+    if ( e == 0x0ffff )
+      break;
+    str++;
+    if ( e == 0x0fffe )
+      continue;
+
+    chunk = x / strip->chunk_width;
+    if ( chunk >= strip->chunk_cnt )
+      break;
+
+    delta = u8g2_draw_strip_glyph(u8g2, strip, chunk, x, e);
+
+    /* glyph may overlap into the neighbour chunks */
+    if ( chunk+1 < strip->chunk_cnt && x + u8g2->font_info.max_char_width > (uint16_t)(chunk+1)*strip->chunk_width )
+      u8g2_draw_strip_glyph(u8g2, strip, chunk+1, x, e);
+    if ( chunk > 0 && x < (uint16_t)chunk*strip->chunk_width + u8g2->font_info.max_char_width )
+      u8g2_draw_strip_glyph(u8g2, strip, chunk-1, x, e);
+
+    x += delta;
+  }
+  if ( x > capacity )
+    x = capacity;
+  strip->width = x;
+
+  /* restore the tile buffer and the page window */
+  u8g2->tile_buf_ptr = tile_buf_ptr;
+  u8g2->tile_buf_height = tile_buf_height;
+  u8g2->draw_color = draw_color;
+  u8g2->font_calc_vref = font_calc_vref;
+#ifdef U8G2_WITH_FONT_ROTATION
+  u8g2->font_decode.dir = dir;
+#endif
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2->clip_x0 = clip_x0;
+  u8g2->clip_y0 = clip_y0;
+  u8g2->clip_x1 = clip_x1;
+  u8g2->clip_y1 = clip_y1;
+#endif
+  u8g2_SetBufferCurrTileRow(u8g2, tile_curr_row);
+
+  return x;
+}
+
+/*
+  OR one tile row of the strip into tile row "dest_row" of the current buffer
+  shift > 0: move pixels down, shift < 0: move pixels up
+*/
+static void u8g2_draw_strip_row(u8g2_t *u8g2, uint8_t dest_row, u8g2_uint_t x, uint16_t w, const u8g2_strip_t *strip, uint8_t strip_row, uint16_t sx, int8_t shift)
+{
+  uint8_t mask, b;
+  uint16_t py, offset, len;
+  uint8_t *dest;
+  const uint8_t *src;
+
+  /* mask out the pixel rows outside the current window */
+  mask = 0;
+  py = (uint16_t)dest_row*8;
+  for( b = 0; b < 8; b++ )
+  {
+    if ( py+b >= u8g2->user_y0 && py+b < u8g2->user_y1 )
+      mask |= 1<<b;
+  }
+  if ( mask == 0 )
+    return;
+
+  dest = u8g2->tile_buf_ptr;
+  dest += (uint16_t)(dest_row - u8g2->tile_curr_row)*u8g2->pixel_buf_width;
+  dest += x;
+
+  while( w > 0 )
+  {
+    /* copy up to the end of the current chunk */
+    offset = sx % strip->chunk_width;
+    len = strip->chunk_width - offset;
+    if ( len > w )
+      len = w;
+    src = strip->buf;
+    src += ((uint16_t)(sx / strip->chunk_width)*strip->tile_rows + strip_row)*(uint16_t)strip->chunk_width;
+    src += offset;
+
+    sx += len;
+    w -= len;
+
+    if ( shift == 0 )
+    {
+      do
+      {
+	*dest++ |= *src++ & mask;
+	len--;
+      } while( len > 0 );
+    }
+    else if ( shift > 0 )
+    {
+      do
+      {
+	*dest++ |= (uint8_t)(*src++ << shift) & mask;
+	len--;
+      } while( len > 0 );
+    }
+    else
+    {
+      do
+      {
+	*dest++ |= (uint8_t)(*src++ >> (-shift)) & mask;
+	len--;
+      } while( len > 0 );
+    }
+  }
+}
+
+/*
+  copy the strip pixels sx...sx+w-1 to x...x+w-1 of the current buffer.
+  y is the top of the strip, the baseline of the text is at y+strip->ascent.
+  Only set pixels are copied.
+*/
+void u8g2_DrawStrip(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, const u8g2_strip_t *strip, uint16_t sx)
+{
+  uint16_t x1, width;
+  uint16_t py;
+  uint8_t r, shift, dest_row, row_end;
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  if ( strip->chunk_cnt == 0 )
+    return;
+
+  /* clip against the strip */
+  width = (uint16_t)strip->chunk_cnt*(uint16_t)strip->chunk_width;
+  if ( sx >= width )
+    return;
+  if ( (uint16_t)w > width - sx )
+    w = width - sx;
+
+  /* clip against the user window */
+  x1 = (uint16_t)x + (uint16_t)w;
+  if ( x < u8g2->user_x0 )
+  {
+    sx += u8g2->user_x0 - x;
+    x = u8g2->user_x0;
+  }
+  if ( x1 > u8g2->user_x1 )
+    x1 = u8g2->user_x1;
+  if ( x1 <= x )
+    return;
+  w = x1 - x;
+
+  row_end = u8g2->tile_curr_row + u8g2->tile_buf_height;
+  shift = y & 7;
+  for( r = 0; r < strip->tile_rows; r++ )
+  {
+    py = (uint16_t)y + (uint16_t)r*8;
+    dest_row = py >> 3;
+    if ( dest_row >= u8g2->tile_curr_row && dest_row < row_end )
+      u8g2_draw_strip_row(u8g2, dest_row, x, w, strip, r, sx, (int8_t)shift);
+    dest_row++;
+    if ( shift != 0 && dest_row >= u8g2->tile_curr_row && dest_row < row_end )
+      u8g2_draw_strip_row(u8g2, dest_row, x, w, strip, r, sx, -(int8_t)(8-shift));
+  }
+}
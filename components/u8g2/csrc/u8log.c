@@ -50,39 +50,41 @@ static uint8_t u8log_is_on_screen(u8log_t *u8log, uint8_t x, uint8_t y)
 }
 */
 
-static void u8log_clear_screen(u8log_t *u8log)
+static void u8log_clear_line(u8log_t *u8log, uint8_t *dest)
 {
-  uint8_t *dest = u8log->screen_buffer;
-  uint16_t cnt = u8log->height;
-  cnt *= u8log->width;
+  uint8_t cnt = u8log->width;
   do
   {
     *dest++ = ' ';
     cnt--;
   } while( cnt > 0 );
-  
 }
 
-
-/* scroll the content of the complete buffer, set redraw_line to 255 */
-static void u8log_scroll_up(u8log_t *u8log)
+static void u8log_clear_screen(u8log_t *u8log)
 {
   uint8_t *dest = u8log->screen_buffer;
-  uint8_t *src = dest+u8log->width;
   uint16_t cnt = u8log->height;
-  cnt--;
   cnt *= u8log->width;
   do
-  {
-    *dest++ = *src++;
-    cnt--;
-  } while( cnt > 0 );
-  cnt = u8log->width;
-  do
   {
     *dest++ = ' ';
     cnt--;
-  } while(cnt > 0);
+  } while( cnt > 0 );
+  u8log->top_line = 0;
+}
+
+
+/* 
+  scroll the content of the complete buffer, set redraw_line to 255 
+  the lines of screen_buffer are a ring, the first line is cleared
+  and becomes the last line, no chars are moved
+*/
+static void u8log_scroll_up(u8log_t *u8log)
+{
+  u8log_clear_line(u8log, u8log_GetLine(u8log, 0));
+  u8log->top_line++;
+  if ( u8log->top_line >= u8log->height )
+    u8log->top_line = 0;
   
   if ( u8log->is_redraw_line_for_each_char )
     u8log->is_redraw_all = 1;
@@ -114,7 +116,7 @@ static void u8log_cursor_on_screen(u8log_t *u8log)
 static void u8log_write_to_screen(u8log_t *u8log, uint8_t c)
 {
   u8log_cursor_on_screen(u8log);
-  u8log->screen_buffer[u8log->cursor_y * u8log->width + u8log->cursor_x] = c;
+  u8log_GetLine(u8log, u8log->cursor_y)[u8log->cursor_x] = c;
   u8log->cursor_x++;
   
   if ( u8log->is_redraw_line_for_each_char )
@@ -188,6 +190,17 @@ void u8log_SetRedrawMode(u8log_t *u8log, uint8_t is_redraw_line_for_each_char)
   u8log->is_redraw_line_for_each_char = is_redraw_line_for_each_char;
 }
 
+/*
+  is_redraw_deferred = 1: u8log_WriteChar() and u8log_WriteString() only 
+  mark the changed lines, the callback is called by u8log_Redraw(). 
+  This allows to redraw the screen with a fixed frame rate, independent
+  of the number of written lines.
+*/
+void u8log_SetRedrawDeferred(u8log_t *u8log, uint8_t is_redraw_deferred)
+{
+  u8log->is_redraw_deferred = is_redraw_deferred;
+}
+
 /* offset can be negative or positive, it is 0 by default */
 void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
 {
@@ -196,18 +209,55 @@ void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
 
 
 
+/* 
+  first char of line y (0..height-1) of the screen, the line has width chars 
+  and is not terminated
+*/
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y)
+{
+  uint16_t line = u8log->top_line;
+  line += y;
+  if ( line >= u8log->height )
+    line -= u8log->height;
+  line *= u8log->width;
+  return u8log->screen_buffer + line;
+}
+
+/*
+  call the callback for the lines, which have changed since the last 
+  call, returns 0 if nothing has changed
+*/
+uint8_t u8log_Redraw(u8log_t *u8log)
+{
+  if ( u8log->is_redraw_line == 0 && u8log->is_redraw_all == 0 )
+    return 0;
+  if ( u8log->cb != 0 )
+  {
+    u8log->cb(u8log);
+  }
+  u8log->is_redraw_line = 0;
+  u8log->is_redraw_all = 0;
+  return 1;
+}
+
 void u8log_WriteChar(u8log_t *u8log, uint8_t c)
 {
-  u8log_write_char(u8log, c);
-  if ( u8log->is_redraw_line || u8log->is_redraw_all )
+  uint8_t is_redraw_line;
+  uint8_t redraw_line;
+  
+  if ( u8log->is_redraw_deferred )
   {
-    if ( u8log->cb != 0 )
-    {
-      u8log->cb(u8log);
-    }
-    u8log->is_redraw_line = 0;
-    u8log->is_redraw_all = 0;
+    is_redraw_line = u8log->is_redraw_line;
+    redraw_line = u8log->redraw_line;
+    u8log_write_char(u8log, c);
+    /* more than one line has changed since the last u8log_Redraw() */
+    if ( is_redraw_line && u8log->redraw_line != redraw_line )
+      u8log->is_redraw_all = 1;
+    return;
   }
+  
+  u8log_write_char(u8log, c);
+  u8log_Redraw(u8log);
 }
 
 void u8log_WriteString(u8log_t *u8log, const char *s)
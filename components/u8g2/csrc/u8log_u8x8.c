@@ -40,11 +40,10 @@ static void u8x8_DrawLogLine(u8x8_t *u8x8, uint8_t disp_x, uint8_t disp_y, uint8
 static void u8x8_DrawLogLine(u8x8_t *u8x8, uint8_t disp_x, uint8_t disp_y, uint8_t buf_y, u8log_t *u8log)
 {
   uint8_t buf_x;
-  uint8_t c;
+  uint8_t *line = u8log_GetLine(u8log, buf_y);
   for( buf_x = 0; buf_x < u8log->width; buf_x++ )
   {
-    c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
-    u8x8_DrawGlyph(u8x8, disp_x, disp_y, c);
+    u8x8_DrawGlyph(u8x8, disp_x, disp_y, line[buf_x]);
     disp_x++;
   }
 }
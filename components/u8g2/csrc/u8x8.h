@@ -44,6 +44,7 @@
     U8X8_MSG_DISPLAY_SET_POWER_SAVE
     U8X8_MSG_DISPLAY_SET_CONTRAST
     U8X8_MSG_DISPLAY_DRAW_TILE
+    U8X8_MSG_DISPLAY_DRAW_TILE_ROWS
 
   A display driver may decided to breakdown these messages to a lower level interface or
   implement this functionality directly.
@@ -59,6 +60,7 @@
     U8X8_MSG_CAD_SEND_CMD
     U8X8_MSG_CAD_SEND_ARG
     U8X8_MSG_CAD_SEND_DATA
+    U8X8_MSG_CAD_SEND_DATA_LARGE
     U8X8_MSG_CAD_END_TRANSFER
     
   The byte interface is there to send 1 byte (8 bits) to the display hardware.
@@ -68,6 +70,7 @@
   bytes.
     U8X8_MSG_BYTE_INIT
     U8X8_MSG_BYTE_SEND 30
+    U8X8_MSG_BYTE_SEND_LARGE
     U8X8_MSG_BYTE_SET_DC 31
     U8X8_MSG_BYTE_START_TRANSFER
     U8X8_MSG_BYTE_END_TRANSFER
@@ -195,6 +198,8 @@ uint8_t u8x8_pgm_read_esp(const uint8_t * addr);   /* u8x8_8x8.c */
 typedef struct u8x8_struct u8x8_t;
 typedef struct u8x8_display_info_struct u8x8_display_info_t;
 typedef struct u8x8_tile_struct u8x8_tile_t;
+typedef struct u8x8_large_data_struct u8x8_large_data_t;
+typedef struct u8x8_scroll_struct u8x8_scroll_t;
 
 typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 typedef uint16_t (*u8x8_char_cb)(u8x8_t *u8x8, uint8_t b);
@@ -217,6 +222,22 @@ struct u8x8_tile_struct
   uint8_t y_pos;	/* tile x position */
 };
 
+/* argument of U8X8_MSG_DISPLAY_SET_SCROLL */
+struct u8x8_scroll_struct
+{
+  uint8_t y_start;	/* first tile row (page) */
+  uint8_t y_end;	/* last tile row (page), inclusive */
+  uint8_t dir;		/* U8X8_SCROLL_RIGHT or U8X8_SCROLL_LEFT */
+  uint8_t speed;	/* 0 (slowest) .. 7 (fastest) */
+};
+
+/* argument of U8X8_MSG_CAD_SEND_DATA_LARGE and U8X8_MSG_BYTE_SEND_LARGE */
+struct u8x8_large_data_struct
+{
+  uint8_t *data;
+  uint16_t cnt;		/* number of bytes, may be more than 255 */
+};
+
 
 struct u8x8_display_info_struct
 {
@@ -340,6 +361,8 @@ struct u8x8_struct
 					/* i2c_address is the address for writing data to the display */
 					/* usually, the lowest bit must be zero for a valid address */
   uint8_t i2c_started;	/* for i2c interface */
+  uint8_t byte_max_transfer;	/* max number of bytes the byte driver accepts between start and end transfer, 0: unknown (32 byte Arduino Wire buffer) */
+  uint16_t byte_max_large_transfer;	/* max number of bytes the byte driver accepts within one transfer with U8X8_MSG_BYTE_SEND_LARGE, 0: not supported */
   uint8_t device_address;	/* OBSOLETE???? - this is the device address, replacement for U8X8_MSG_CAD_SET_DEVICE */
   uint8_t utf8_state;		/* number of chars which are still to scan */
   uint8_t gpio_result;	/* return value from the gpio call (only for MENU keys at the moment) */ 
@@ -402,11 +425,13 @@ struct u8log_struct
   u8log_cb cb;			/* callback redraw function */
   uint8_t *screen_buffer;	/* size must be width*heigh bytes */
   uint8_t is_redraw_line_for_each_char;
+  uint8_t is_redraw_deferred;	/* callback is called by u8log_Redraw() only */
   int8_t line_height_offset;		/* extra offset for the line height (u8g2 only) */
   
   /* internal data */
   //uint8_t last_x, last_y;	/* position of the last printed char */
   uint8_t cursor_x, cursor_y;  /* position of the cursor, might be off screen */
+  uint8_t top_line;		/* line of screen_buffer which is shown first, see u8log_GetLine() */
   uint8_t redraw_line;	/* redraw specific line if is_redraw_line is not 0 */
   uint8_t is_redraw_line;
   uint8_t is_redraw_all;
@@ -517,6 +542,52 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_TILE_ROWS
+  Args:	
+    arg_int: Number of tile rows
+    arg_ptr: pointer to u8x8_tile_t
+        uint8_t *tile_ptr;	pointer to arg_int*cnt tiles, one tile row after the other
+	uint8_t cnt;		number of tiles in each row
+	uint8_t x_pos;		first tile x position
+	uint8_t y_pos;		first tile y position 
+  Tasks:
+    Draw arg_int rows of cnt tiles, row r at x_pos/y_pos+r. Optional: 
+    Display drivers return 0 if they do not support this message. Use
+      uint8_t u8x8_DrawTileRows(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+    which falls back to one U8X8_MSG_DISPLAY_DRAW_TILE per row.
+    Only sent if the byte driver supports U8X8_MSG_BYTE_SEND_LARGE, the
+    data should go to the display with u8x8_cad_SendDataLarge().
+*/
+#define U8X8_MSG_DISPLAY_DRAW_TILE_ROWS 17
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_SCROLL
+  Args:	
+    arg_int: 1: start scrolling, 0: stop scrolling
+    arg_ptr: pointer to u8x8_scroll_t (start only, NULL to stop)
+	uint8_t y_start;	first tile row
+	uint8_t y_end;		last tile row, inclusive
+	uint8_t dir;		U8X8_SCROLL_RIGHT or U8X8_SCROLL_LEFT
+	uint8_t speed;		0 (slowest) .. 7 (fastest)
+  Tasks:
+    Start or stop the continuous horizontal hardware scroll of the tile 
+    rows y_start..y_end. The content leaving the display on one side enters 
+    it again on the other side. Directions are those of flip mode 0.
+    "speed" is mapped to the nearest step the controller supports.
+    Optional: Display drivers return 0 if they do not support this message.
+    After stopping, the display RAM of the scrolled rows is shifted by an 
+    unknown number of pixels and must be written again.
+    Use
+      uint8_t u8x8_StartScroll(u8x8_t *u8x8, uint8_t y_start, uint8_t y_end, uint8_t dir, uint8_t speed)
+      uint8_t u8x8_StopScroll(u8x8_t *u8x8)
+    to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_SET_SCROLL 18
+
+#define U8X8_SCROLL_RIGHT 0
+#define U8X8_SCROLL_LEFT 1
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -535,6 +606,9 @@ void u8x8_Setup(u8x8_t *u8x8, u8x8_msg_cb display_cb, u8x8_msg_cb cad_cb, u8x8_m
 /*==========================================*/
 /* u8x8_display.c */
 uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr);
+uint8_t u8x8_DrawTileRows(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr);
+uint8_t u8x8_StartScroll(u8x8_t *u8x8, uint8_t y_start, uint8_t y_end, uint8_t dir, uint8_t speed);
+uint8_t u8x8_StopScroll(u8x8_t *u8x8);
 
 /* 
   After a call to u8x8_SetupDefaults, 
@@ -587,6 +661,8 @@ void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line);
 /* arg_int = 0: disable chip, arg_int = 1: enable chip */
 //#define U8X8_MSG_CAD_SET_I2C_ADR 26
 //#define U8X8_MSG_CAD_SET_DEVICE 27
+#define U8X8_MSG_CAD_SEND_DATA_LARGE 28
+/* arg_ptr: u8x8_large_data_t, all data within one transfer. Returns 0 if not supported by the CAD or byte driver */
 
 
 
@@ -598,6 +674,7 @@ uint8_t u8x8_cad_SendCmd(u8x8_t *u8x8, uint8_t cmd) U8X8_NOINLINE;
 uint8_t u8x8_cad_SendArg(u8x8_t *u8x8, uint8_t arg) U8X8_NOINLINE;
 uint8_t u8x8_cad_SendMultipleArg(u8x8_t *u8x8, uint8_t cnt, uint8_t arg) U8X8_NOINLINE;
 uint8_t u8x8_cad_SendData(u8x8_t *u8x8, uint8_t cnt, uint8_t *data) U8X8_NOINLINE;
+uint8_t u8x8_cad_SendDataLarge(u8x8_t *u8x8, uint16_t cnt, uint8_t *data);
 uint8_t u8x8_cad_StartTransfer(u8x8_t *u8x8) U8X8_NOINLINE;
 uint8_t u8x8_cad_EndTransfer(u8x8_t *u8x8) U8X8_NOINLINE;
 void u8x8_cad_vsendf(u8x8_t * u8x8, const char *fmt, va_list va);
@@ -654,6 +731,25 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 #define U8X8_MSG_BYTE_START_TRANSFER U8X8_MSG_CAD_START_TRANSFER
 #define U8X8_MSG_BYTE_END_TRANSFER U8X8_MSG_CAD_END_TRANSFER
 
+/* arg_ptr: u8x8_large_data_t, only sent if u8x8_GetByteMaxLargeTransfer() is not 0 */
+#define U8X8_MSG_BYTE_SEND_LARGE U8X8_MSG_CAD_SEND_DATA_LARGE
+
+/* 
+  Byte drivers without a small transfer buffer can announce the size of a transfer they accept.
+  This allows CAD procedures to send a full tile row (128 bytes) within one transfer.
+  Usually called during U8X8_MSG_BYTE_INIT.
+*/
+#define u8x8_SetByteMaxTransfer(u8x8, cnt) ((u8x8)->byte_max_transfer = (cnt))
+#define u8x8_GetByteMaxTransfer(u8x8) ((u8x8)->byte_max_transfer)
+
+/* 
+  Byte drivers, which can send more than 255 bytes from the callers memory within one 
+  transfer, announce U8X8_MSG_BYTE_SEND_LARGE with the max size of such a transfer.
+  The SSD1306 will then send a full frame (1 KB) with one transfer.
+*/
+#define u8x8_SetByteMaxLargeTransfer(u8x8, cnt) ((u8x8)->byte_max_large_transfer = (cnt))
+#define u8x8_GetByteMaxLargeTransfer(u8x8) ((u8x8)->byte_max_large_transfer)
+
 //#define U8X8_MSG_BYTE_SET_I2C_ADR U8X8_MSG_CAD_SET_I2C_ADR
 //#define U8X8_MSG_BYTE_SET_DEVICE U8X8_MSG_CAD_SET_DEVICE
 
@@ -661,6 +757,7 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 uint8_t u8x8_byte_SetDC(u8x8_t *u8x8, uint8_t dc) U8X8_NOINLINE;
 uint8_t u8x8_byte_SendByte(u8x8_t *u8x8, uint8_t byte) U8X8_NOINLINE;
 uint8_t u8x8_byte_SendBytes(u8x8_t *u8x8, uint8_t cnt, uint8_t *data) U8X8_NOINLINE;
+uint8_t u8x8_byte_SendBytesLarge(u8x8_t *u8x8, uint16_t cnt, uint8_t *data);
 uint8_t u8x8_byte_StartTransfer(u8x8_t *u8x8);
 uint8_t u8x8_byte_EndTransfer(u8x8_t *u8x8);
 
@@ -1035,6 +1132,9 @@ void u8log_Init(u8log_t *u8log, uint8_t width, uint8_t height, uint8_t *buf);
 void u8log_SetCallback(u8log_t *u8log, u8log_cb cb, void *aux_data);
 void u8log_SetRedrawMode(u8log_t *u8log, uint8_t is_redraw_line_for_each_char);
 void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset);
+void u8log_SetRedrawDeferred(u8log_t *u8log, uint8_t is_redraw_deferred);
+uint8_t u8log_Redraw(u8log_t *u8log);
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y);
 void u8log_WriteString(u8log_t *u8log, const char *s) U8X8_NOINLINE;
 void u8log_WriteChar(u8log_t *u8log, uint8_t c) U8X8_NOINLINE;
 void u8log_WriteHex8(u8log_t *u8log, uint8_t b) U8X8_NOINLINE;
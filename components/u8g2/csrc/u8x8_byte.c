@@ -46,6 +46,14 @@ uint8_t u8x8_byte_SendBytes(u8x8_t *u8x8, uint8_t cnt, uint8_t *data)
   return u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_SEND, cnt, (void *)data);
 }
 
+uint8_t u8x8_byte_SendBytesLarge(u8x8_t *u8x8, uint16_t cnt, uint8_t *data)
+{
+  u8x8_large_data_t large;
+  large.data = data;
+  large.cnt = cnt;
+  return u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_SEND_LARGE, 0, (void *)&large);
+}
+
 uint8_t u8x8_byte_SendByte(u8x8_t *u8x8, uint8_t byte)
 {
   return u8x8_byte_SendBytes(u8x8, 1, &byte);
@@ -43,6 +43,7 @@
     uint8_t u8x8_cad_SendCmd(u8x8_t *u8x8, uint8_t cmd)
     uint8_t u8x8_cad_SendArg(u8x8_t *u8x8, uint8_t arg)
     uint8_t u8x8_cad_SendData(u8x8_t *u8x8, uint8_t cnt, uint8_t *data)
+    uint8_t u8x8_cad_SendDataLarge(u8x8_t *u8x8, uint16_t cnt, uint8_t *data)
   
   uint8_t u8x8_cad_EndTransfer(u8x8_t *u8x8)
 
@@ -110,6 +111,17 @@ uint8_t u8x8_cad_SendData(u8x8_t *u8x8, uint8_t cnt, uint8_t *data)
   return u8x8->cad_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, cnt, data);
 }
 
+/* returns 0 if the data has not been sent, use u8x8_cad_SendData() in this case */
+uint8_t u8x8_cad_SendDataLarge(u8x8_t *u8x8, uint16_t cnt, uint8_t *data)
+{
+  u8x8_large_data_t large;
+  if ( u8x8->byte_max_large_transfer == 0 )
+    return 0;
+  large.data = data;
+  large.cnt = cnt;
+  return u8x8->cad_cb(u8x8, U8X8_MSG_CAD_SEND_DATA_LARGE, 0, (void *)&large);
+}
+
 uint8_t u8x8_cad_StartTransfer(u8x8_t *u8x8)
 {
   return u8x8->cad_cb(u8x8, U8X8_MSG_CAD_START_TRANSFER, 0, NULL);
@@ -298,6 +310,12 @@ uint8_t u8x8_cad_001(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
       u8x8_byte_SetDC(u8x8, 0);
       u8x8_byte_SendByte(u8x8, arg_int);
       break;
+    case U8X8_MSG_CAD_SEND_DATA_LARGE:
+      if ( ((u8x8_large_data_t *)arg_ptr)->cnt > u8x8->byte_max_large_transfer )
+	return 0;
+      u8x8_byte_SetDC(u8x8, 1);
+      u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_SEND_LARGE, 0, arg_ptr);
+      break;
     case U8X8_MSG_CAD_SEND_DATA:
       u8x8_byte_SetDC(u8x8, 1);
       //u8x8_byte_SendBytes(u8x8, arg_int, arg_ptr);
@@ -433,10 +451,35 @@ static void u8x8_i2c_data_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
     u8x8_byte_EndTransfer(u8x8);
 }
 
+/* 
+  max number of data bytes per i2c transfer: 24 bytes, unless the byte driver has 
+  announced a larger transfer size with u8x8_SetByteMaxTransfer().
+  One byte of the transfer is required for the data/command byte.
+*/
+static uint8_t u8x8_i2c_data_chunk_size(u8x8_t *u8x8)
+{
+  if ( u8x8->byte_max_transfer > 1 )
+    return u8x8->byte_max_transfer-1;
+  return 24;
+}
+
+static void u8x8_i2c_data_chunked_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr) U8X8_NOINLINE;
+static void u8x8_i2c_data_chunked_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p = arg_ptr;
+  uint8_t chunk = u8x8_i2c_data_chunk_size(u8x8);
+  while( arg_int > chunk )
+  {
+    u8x8_i2c_data_transfer(u8x8, chunk, p);
+    arg_int-=chunk;
+    p+=chunk;
+  }
+  u8x8_i2c_data_transfer(u8x8, arg_int, p);
+}
+
 /* classic version: will put a start/stop condition around each command and arg */
 uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
@@ -459,14 +502,7 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       /* Unfortunately, this can not be handled in the byte level drivers, */
       /* so this is done here. Even further, only 24 bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
-      p = arg_ptr;
-       while( arg_int > 24 )
-      {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
-      }
-      u8x8_i2c_data_transfer(u8x8, arg_int, p);
+      u8x8_i2c_data_chunked_transfer(u8x8, arg_int, arg_ptr);
       break;
     case U8X8_MSG_CAD_INIT:
       /* apply default i2c adr if required so that the start transfer msg can use this */
@@ -488,7 +524,6 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   static uint8_t in_transfer = 0;
-  uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
@@ -529,14 +564,20 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* Unfortunately, this can not be handled in the byte level drivers, */
       /* so this is done here. Even further, only 24 bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
-      p = arg_ptr;
-       while( arg_int > 24 )
-      {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
-      }
-      u8x8_i2c_data_transfer(u8x8, arg_int, p);
+      /* Byte drivers with larger buffers can announce this with u8x8_SetByteMaxTransfer() */
+      u8x8_i2c_data_chunked_transfer(u8x8, arg_int, arg_ptr);
+      in_transfer = 0;
+      break;
+    case U8X8_MSG_CAD_SEND_DATA_LARGE:
+      /* control byte and all data within one transfer, if the byte driver accepts this */
+      if ( ((u8x8_large_data_t *)arg_ptr)->cnt >= u8x8->byte_max_large_transfer )
+	return 0;
+      if ( in_transfer != 0 )
+	u8x8_byte_EndTransfer(u8x8); 
+      u8x8_byte_StartTransfer(u8x8);
+      u8x8_byte_SendByte(u8x8, 0x040);
+      u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_SEND_LARGE, 0, arg_ptr);
+      u8x8_byte_EndTransfer(u8x8);
       in_transfer = 0;
       break;
     case U8X8_MSG_CAD_INIT:
@@ -285,6 +285,94 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
 }
 
 
+/* 
+  SSD1306 only, not supported by the SH1106: 
+  Send several tile rows with horizontal addressing mode. The column and page range is 
+  set once and the data of all rows goes to the display with one large transfer.
+  Page addressing mode and the full column and page range are restored for U8X8_MSG_DISPLAY_DRAW_TILE.
+*/
+static uint8_t u8x8_d_ssd1306_draw_tile_rows(u8x8_t *u8x8, uint8_t rows, u8x8_tile_t *tile)
+{
+  uint8_t x, c;
+  uint16_t cnt;
+  uint8_t *ptr;
+  
+  x = tile->x_pos;
+  x *= 8;
+  x += u8x8->x_offset;
+  cnt = tile->cnt;
+  cnt *= 8;
+  
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, 0x020 );	/* horizontal addressing mode */
+  u8x8_cad_SendArg(u8x8, 0x000 );
+  u8x8_cad_SendCmd(u8x8, 0x021 );	/* column range */
+  u8x8_cad_SendArg(u8x8, x );
+  u8x8_cad_SendArg(u8x8, x + cnt - 1 );
+  u8x8_cad_SendCmd(u8x8, 0x022 );	/* page range */
+  u8x8_cad_SendArg(u8x8, tile->y_pos );
+  u8x8_cad_SendArg(u8x8, tile->y_pos + rows - 1 );
+  
+  cnt *= rows;
+  ptr = tile->tile_ptr;
+  if ( u8x8_cad_SendDataLarge(u8x8, cnt, ptr) == 0 )
+  {
+    /* the address wraps to the next page, so any chunk size will do */
+    while( cnt > 0 )
+    {
+      c = 128;
+      if ( cnt < 128 )
+	c = cnt;
+      u8x8_cad_SendData(u8x8, c, ptr);
+      ptr += c;
+      cnt -= c;
+    }
+  }
+  
+  u8x8_cad_SendCmd(u8x8, 0x021 );
+  u8x8_cad_SendArg(u8x8, 0x000 );
+  u8x8_cad_SendArg(u8x8, 0x07f );
+  u8x8_cad_SendCmd(u8x8, 0x022 );
+  u8x8_cad_SendArg(u8x8, 0x000 );
+  u8x8_cad_SendArg(u8x8, 0x007 );
+  u8x8_cad_SendCmd(u8x8, 0x020 );	/* page addressing mode */
+  u8x8_cad_SendArg(u8x8, 0x002 );
+  u8x8_cad_EndTransfer(u8x8);
+  return 1;
+}
+
+/* 
+  SSD1306 only, the SH1106 has no scroll commands:
+  Continuous horizontal scroll of a page range. The scroll is always deactivated
+  first, the parameters must not be changed while the scroll is running.
+  Scroll step interval in frames for speed 0..7: 256, 128, 64, 25, 5, 4, 3, 2
+*/
+static const uint8_t u8x8_d_ssd1306_scroll_interval[8] = { 0x03, 0x02, 0x01, 0x06, 0x00, 0x05, 0x04, 0x07 };
+
+static uint8_t u8x8_d_ssd1306_set_scroll(u8x8_t *u8x8, uint8_t is_start, u8x8_scroll_t *scroll)
+{
+  uint8_t speed;
+  
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, 0x02e );	/* deactivate scroll */
+  if ( is_start != 0 )
+  {
+    speed = scroll->speed;
+    if ( speed > 7 )
+      speed = 7;
+    u8x8_cad_SendCmd(u8x8, scroll->dir == U8X8_SCROLL_LEFT ? 0x027 : 0x026 );
+    u8x8_cad_SendArg(u8x8, 0x000 );	/* dummy byte */
+    u8x8_cad_SendArg(u8x8, scroll->y_start );
+    u8x8_cad_SendArg(u8x8, u8x8_d_ssd1306_scroll_interval[speed] );
+    u8x8_cad_SendArg(u8x8, scroll->y_end );
+    u8x8_cad_SendArg(u8x8, 0x000 );	/* dummy bytes */
+    u8x8_cad_SendArg(u8x8, 0x0ff );
+    u8x8_cad_SendCmd(u8x8, 0x02f );	/* activate scroll */
+  }
+  u8x8_cad_EndTransfer(u8x8);
+  return 1;
+}
+
 static const u8x8_display_info_t u8x8_ssd1306_128x64_noname_display_info =
 {
   /* chip_enable_level = */ 0,
@@ -321,6 +409,10 @@ uint8_t u8x8_d_ssd1306_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_noname_init_seq);    
       break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE_ROWS:
+      return u8x8_d_ssd1306_draw_tile_rows(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
+    case U8X8_MSG_DISPLAY_SET_SCROLL:
+      return u8x8_d_ssd1306_set_scroll(u8x8, arg_int, (u8x8_scroll_t *)arg_ptr);
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
@@ -342,6 +434,10 @@ uint8_t u8x8_d_ssd1306_128x64_vcomh0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_vcomh0_init_seq);    
       break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE_ROWS:
+      return u8x8_d_ssd1306_draw_tile_rows(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
+    case U8X8_MSG_DISPLAY_SET_SCROLL:
+      return u8x8_d_ssd1306_set_scroll(u8x8, arg_int, (u8x8_scroll_t *)arg_ptr);
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
@@ -363,6 +459,10 @@ uint8_t u8x8_d_ssd1306_128x64_alt0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, v
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_alt0_init_seq);    
       break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE_ROWS:
+      return u8x8_d_ssd1306_draw_tile_rows(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
+    case U8X8_MSG_DISPLAY_SET_SCROLL:
+      return u8x8_d_ssd1306_set_scroll(u8x8, arg_int, (u8x8_scroll_t *)arg_ptr);
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
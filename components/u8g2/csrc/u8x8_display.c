@@ -89,6 +89,62 @@ uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *
   return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
 }
 
+/* 
+  draw "rows" rows of "cnt" tiles, which follow each other in memory.
+  Displays and byte drivers with U8X8_MSG_DISPLAY_DRAW_TILE_ROWS support send all rows
+  within one transfer, otherwise each row is drawn with U8X8_MSG_DISPLAY_DRAW_TILE.
+*/
+uint8_t u8x8_DrawTileRows(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+{
+  u8x8_tile_t tile;
+  uint16_t row_size;
+  
+  if ( rows > 1 && u8x8->byte_max_large_transfer != 0 )
+  {
+    tile.x_pos = x;
+    tile.y_pos = y;
+    tile.cnt = cnt;
+    tile.tile_ptr = tile_ptr;
+    if ( u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE_ROWS, rows, (void *)&tile) != 0 )
+      return 1;
+  }
+  row_size = cnt;
+  row_size *= 8;
+  while( rows > 0 )
+  {
+    u8x8_DrawTile(u8x8, x, y, cnt, tile_ptr);
+    tile_ptr += row_size;
+    y++;
+    rows--;
+  }
+  return 1;
+}
+
+/*
+  start the horizontal hardware scroll of the tile rows y_start..y_end (inclusive),
+  returns 0 if the display does not support this, see U8X8_MSG_DISPLAY_SET_SCROLL
+*/
+uint8_t u8x8_StartScroll(u8x8_t *u8x8, uint8_t y_start, uint8_t y_end, uint8_t dir, uint8_t speed)
+{
+  u8x8_scroll_t scroll;
+
+  if ( y_end >= u8x8->display_info->tile_height )
+    y_end = u8x8->display_info->tile_height-1;
+  if ( y_start > y_end )
+    return 0;
+  scroll.y_start = y_start;
+  scroll.y_end = y_end;
+  scroll.dir = dir;
+  scroll.speed = speed;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_SCROLL, 1, (void *)&scroll);
+}
+
+/* the display RAM of the scrolled rows must be written again after this */
+uint8_t u8x8_StopScroll(u8x8_t *u8x8)
+{
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_SCROLL, 0, NULL);
+}
+
 /* should be implemented as macro */
 void u8x8_SetupMemory(u8x8_t *u8x8)
 {
@@ -0,0 +1,217 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Checks and benchmarks u8g2_DrawBox and u8g2_DrawHLine on the Bitmap
+ * device (128x64, U8G2_R0, vertical top memory layout as used by the
+ * SSD1306).
+ *
+ * 1. Random boxes, horizontal lines and rounded boxes must give the same
+ *    buffer as the previous line by line fill (box_ref.c): draw colors
+ *    0/1/2 on a random background, with and without clip window,
+ *    positions partly outside of the display and wrapping around, full
+ *    buffer and a one tile row page buffer.
+ * 2. Time per call (best of 5 rounds) and the fill rate for typical box
+ *    sizes.
+ */
+
+#define W 128
+#define H 64
+#define CHECK_SCENES 100000
+
+void ref_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+
+u8g2_t u8g2;
+u8g2_t u8g2_page;
+uint8_t page_buf[W];
+
+enum { SHAPE_BOX, SHAPE_HLINE, SHAPE_RBOX };
+
+struct scene
+{
+  uint8_t shape;
+  u8g2_uint_t x, y, w, h, r;
+  uint8_t color;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+};
+
+static uint8_t background[H/8*W];
+static uint8_t expect[H/8*W];
+static uint8_t frame[H/8*W];
+
+static int rnd(int lo, int hi)
+{
+  return lo + rand() % (hi - lo + 1);
+}
+
+/* mostly small sizes, sometimes up to 255 */
+static u8g2_uint_t rnd_size(void)
+{
+  if ( rand() % 4 == 0 )
+    return rnd(0, 255);
+  return rnd(0, 70);
+}
+
+static void random_scene(struct scene *s)
+{
+  unsigned i;
+
+  s->shape = rand() % 3;
+  s->x = rnd(0, 255);
+  s->y = rnd(0, 255);
+  if ( rand() % 2 )
+  {
+    /* near the display, partly outside */
+    s->x = rnd(-20, W+4);
+    s->y = rnd(-20, H+4);
+  }
+  s->w = rnd_size();
+  s->h = rnd_size();
+  s->r = 0;
+  if ( s->shape == SHAPE_RBOX )
+  {
+    /* u8g2_DrawRBox() needs w, h >= 2r+1 */
+    if ( s->w < 3 || s->h < 3 )
+      s->shape = SHAPE_BOX;
+    else
+      s->r = rnd(0, ((s->w < s->h ? s->w : s->h) - 1) / 2);
+  }
+  s->color = rand() % 3;
+  s->is_clip = rand() % 4 == 0;
+  s->clip_x0 = rnd(0, W-1); s->clip_x1 = rnd(s->clip_x0+1, W);
+  s->clip_y0 = rnd(0, H-1); s->clip_y1 = rnd(s->clip_y0+1, H);
+  for( i = 0; i < sizeof(background); i++ )
+    background[i] = rand();
+}
+
+static void draw(u8g2_t *u8g2, const struct scene *s)
+{
+  u8g2_SetDrawColor(u8g2, s->color);
+  if ( s->is_clip )
+    u8g2_SetClipWindow(u8g2, s->clip_x0, s->clip_y0, s->clip_x1, s->clip_y1);
+  else
+    u8g2_SetMaxClipWindow(u8g2);
+  if ( s->shape == SHAPE_BOX )
+    u8g2_DrawBox(u8g2, s->x, s->y, s->w, s->h);
+  else if ( s->shape == SHAPE_HLINE )
+    u8g2_DrawHLine(u8g2, s->x, s->y, s->w);
+  else
+    u8g2_DrawRBox(u8g2, s->x, s->y, s->w, s->h, s->r);
+}
+
+static void render_full(const struct scene *s, u8g2_draw_ll_hvline_cb ll_hvline)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+
+  u8g2.ll_hvline = ll_hvline;
+  memcpy(buf, background, sizeof(background));
+  draw(&u8g2, s);
+  memcpy(frame, buf, sizeof(frame));
+}
+
+static void render_pages(const struct scene *s, u8g2_draw_ll_hvline_cb ll_hvline)
+{
+  int row;
+
+  u8g2_page.ll_hvline = ll_hvline;
+  for( row = 0; row < H/8; row++ )
+  {
+    u8g2_SetBufferCurrTileRow(&u8g2_page, row);
+    memcpy(page_buf, background + row*W, W);
+    draw(&u8g2_page, s);
+    memcpy(frame + row*W, page_buf, W);
+  }
+}
+
+static unsigned check_previous(void)
+{
+  struct scene s;
+  unsigned i, errors = 0, is_page;
+
+  for( i = 0; i < CHECK_SCENES; i++ )
+  {
+    random_scene(&s);
+    for( is_page = 0; is_page < 2; is_page++ )
+    {
+      if ( is_page )
+	render_pages(&s, ref_ll_hvline_vertical_top_lsb);
+      else
+	render_full(&s, ref_ll_hvline_vertical_top_lsb);
+      memcpy(expect, frame, sizeof(frame));
+      if ( is_page )
+	render_pages(&s, u8g2_ll_hvline_vertical_top_lsb);
+      else
+	render_full(&s, u8g2_ll_hvline_vertical_top_lsb);
+      if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+      {
+	if ( errors < 5 )
+	  printf("difference: scene %u, shape %u, %d,%d %ux%u r%u, color %u, clip %u, page %u\n",
+	    i, s.shape, s.x, s.y, s.w, s.h, s.r, s.color, s.is_clip, is_page);
+	errors++;
+      }
+    }
+  }
+  u8g2_SetMaxClipWindow(&u8g2);
+  printf("%u scenes, full and page buffer: %u differences\n\n", CHECK_SCENES, errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+struct bench
+{
+  const char *name;
+  u8g2_uint_t x, y, w, h;
+};
+
+static const struct bench benches[] =
+{
+  { "full screen 128x64", 0, 0, 128, 64 },
+  { "progress bar 100x8", 14, 52, 100, 8 },
+  { "unaligned bar 100x5", 14, 27, 100, 5 },
+  { "spectrum bar 6x40", 60, 20, 6, 40 },
+  { "small box 8x8", 33, 11, 8, 8 },
+  { "hline 128x1", 0, 30, 128, 1 },
+  { "vbar 1x64", 64, 0, 1, 64 },
+};
+
+int main(void)
+{
+  const struct bench *b;
+  unsigned n, color, errors = 0;
+  double ns;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, W, H);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_ClearBuffer(&u8g2);
+
+  u8x8_SetupBitmap(u8g2_GetU8x8(&u8g2_page), W, H);
+  u8g2_SetupBuffer(&u8g2_page, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2_page));
+
+  errors += check_previous();
+
+  u8g2.ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+  u8g2_ClearBuffer(&u8g2);
+  printf("%-22s %5s %12s %12s\n", "box", "color", "ns/call", "Mpixel/s");
+  for( b = benches; b < benches + sizeof(benches)/sizeof(*benches); b++ )
+  {
+    for( color = 1; color <= 2; color++ )
+    {
+      u8g2_SetDrawColor(&u8g2, color);
+      n = 2000000 / (b->w * b->h) + 1000;
+      if ( b->h == 1 )
+	BENCH_NS(ns, 5, n, u8g2_DrawHLine(&u8g2, b->x, b->y, b->w));
+      else
+	BENCH_NS(ns, 5, n, u8g2_DrawBox(&u8g2, b->x, b->y, b->w, b->h));
+      printf("%-22s %5u %12.1f %12.1f\n", b->name, color, ns, b->w * b->h * 1e3 / ns);
+    }
+  }
+  u8g2_SetDrawColor(&u8g2, 1);
+  return errors != 0;
+}
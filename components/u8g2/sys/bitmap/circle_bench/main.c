@@ -0,0 +1,356 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Checks and benchmarks u8g2_DrawDisc, u8g2_DrawFilledEllipse and
+ * u8g2_DrawRBox on the Bitmap device (128x64, vertical top memory layout
+ * as used by the SSD1306).
+ *
+ * 1. Discs and rounded boxes with draw color 1 must give the same buffer
+ *    as the previous algorithm (circle_ref.c). Filled ellipses must be
+ *    the previous ellipse with the gaps in each row filled.
+ * 2. Draw color 2 on a clear buffer must give the same buffer as draw
+ *    color 1 (each pixel is drawn once).
+ * 3. U8G2_R2 and a one tile row page buffer, with and without clip window,
+ *    must give the same pixels as U8G2_R0 into the full buffer.
+ * 4. Time per call for typical shapes, previous and new algorithm.
+ */
+
+#define W 128
+#define H 64
+
+void ref_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+void ref_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+void ref_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+
+u8g2_t u8g2;
+u8g2_t u8g2_page;
+uint8_t page_buf[W];
+
+enum { SHAPE_DISC, SHAPE_ELLIPSE, SHAPE_RBOX };
+
+struct scene
+{
+  uint8_t shape;
+  u8g2_uint_t x, y, a, b, r;	/* center and radius or box and radius */
+  uint8_t option;
+  uint8_t color;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+};
+
+static uint8_t expect[H][W];
+static uint8_t frame[H][W];
+
+static int rnd(int lo, int hi)
+{
+  return lo + rand() % (hi - lo + 1);
+}
+
+static uint8_t background(int x, int y)
+{
+  return (x*7 + y*3) % 5 == 0;
+}
+
+static uint8_t get_pixel(const uint8_t *buf, int x, int y)
+{
+  return (buf[(y >> 3)*W + x] >> (y & 7)) & 1;
+}
+
+static void draw_new(u8g2_t *u8g2, const struct scene *s)
+{
+  switch( s->shape )
+  {
+    case SHAPE_DISC: u8g2_DrawDisc(u8g2, s->x, s->y, s->r, s->option); break;
+    case SHAPE_ELLIPSE: u8g2_DrawFilledEllipse(u8g2, s->x, s->y, s->a, s->b, s->option); break;
+    default: u8g2_DrawRBox(u8g2, s->x, s->y, s->a, s->b, s->r); break;
+  }
+}
+
+static void draw_ref(u8g2_t *u8g2, const struct scene *s)
+{
+  switch( s->shape )
+  {
+    case SHAPE_DISC: ref_DrawDisc(u8g2, s->x, s->y, s->r, s->option); break;
+    case SHAPE_ELLIPSE: ref_DrawFilledEllipse(u8g2, s->x, s->y, s->a, s->b, s->option); break;
+    default: ref_DrawRBox(u8g2, s->x, s->y, s->a, s->b, s->r); break;
+  }
+}
+
+static void random_scene(struct scene *s, uint8_t shape)
+{
+  s->shape = shape;
+  s->x = rnd(0, W-1);
+  s->y = rnd(0, H-1);
+  s->option = rnd(1, 15);
+  s->color = 1;
+  s->is_clip = 0;
+  if ( shape == SHAPE_DISC )
+  {
+    s->r = rnd(0, 70);
+  }
+  else if ( shape == SHAPE_ELLIPSE )
+  {
+    /* the previous algorithm does not terminate for 0, u8g2_long_t is 16 bit */
+    s->a = rnd(1, 24);
+    s->b = rnd(1, 24);
+    /* inside the display, gaps of the previous ellipse can not be filled outside */
+    s->x = rnd(s->a, W-1-s->a);
+    s->y = rnd(s->b, H-1-s->b);
+  }
+  else
+  {
+    s->a = rnd(1, W - s->x);
+    s->b = rnd(1, H - s->y);
+    s->r = rnd(0, ((s->a < s->b ? s->a : s->b) - 1)/2);
+  }
+}
+
+/*==========================================*/
+/* compare with the previous algorithm */
+
+/* the previous ellipse with the gaps in each row filled */
+static void fill_rows(const uint8_t *buf)
+{
+  int x, y, x0, x1;
+
+  for( y = 0; y < H; y++ )
+  {
+    x0 = W;
+    x1 = -1;
+    for( x = 0; x < W; x++ )
+      if ( get_pixel(buf, x, y) )
+      {
+	if ( x0 == W )
+	  x0 = x;
+	x1 = x;
+      }
+    for( x = 0; x < W; x++ )
+      expect[y][x] = x0 <= x && x <= x1;
+  }
+}
+
+static unsigned check_previous(void)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  struct scene s;
+  unsigned i, errors = 0;
+  int x, y;
+
+  u8g2_SetDrawColor(&u8g2, 1);
+  for( i = 0; i < 60000; i++ )
+  {
+    random_scene(&s, i % 3);
+    u8g2_ClearBuffer(&u8g2);
+    draw_ref(&u8g2, &s);
+    if ( s.shape == SHAPE_ELLIPSE )
+      fill_rows(buf);
+    else
+      for( y = 0; y < H; y++ )
+	for( x = 0; x < W; x++ )
+	  expect[y][x] = get_pixel(buf, x, y);
+    u8g2_ClearBuffer(&u8g2);
+    draw_new(&u8g2, &s);
+    for( y = 0; y < H; y++ )
+      for( x = 0; x < W; x++ )
+	frame[y][x] = get_pixel(buf, x, y);
+    if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+    {
+      if ( errors < 5 )
+	printf("difference to previous algorithm: shape %u x %u y %u a %u b %u r %u option %u\n",
+	  s.shape, s.x, s.y, s.a, s.b, s.r, s.option);
+      errors++;
+    }
+  }
+
+  /* lines, the previous algorithm did not terminate */
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawFilledEllipse(&u8g2, 64, 32, 0, 10, U8G2_DRAW_ALL);
+  u8g2_DrawFilledEllipse(&u8g2, 64, 32, 10, 0, U8G2_DRAW_ALL);
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+      if ( get_pixel(buf, x, y) != ((x == 64 && y >= 22 && y <= 42) || (y == 32 && x >= 54 && x <= 74)) )
+      {
+	if ( errors < 5 )
+	  printf("difference: ellipse with radius 0 at %d %d\n", x, y);
+	errors++;
+      }
+
+  printf("previous algorithm: %u differences\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* draw color 2, rotation, page buffer, clip window */
+
+/* is_r2: device position is W-1-x, H-1-y */
+static void render_full(const struct scene *s, uint8_t is_r2, uint8_t color, uint8_t is_clear)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  struct scene t = *s;
+  uint8_t mask, *p;
+  int x, y, dx, dy;
+
+  u8g2_SetDisplayRotation(&u8g2, is_r2 ? U8G2_R2 : U8G2_R0);
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+    {
+      dx = is_r2 ? W-1-x : x;
+      dy = is_r2 ? H-1-y : y;
+      p = buf + (dy >> 3)*W + dx;
+      mask = 1 << (dy & 7);
+      *p = !is_clear && background(x, y) ? *p | mask : *p & ~mask;
+    }
+  u8g2_SetDrawColor(&u8g2, color);
+  if ( s->is_clip )
+    u8g2_SetClipWindow(&u8g2, s->clip_x0, s->clip_y0, s->clip_x1, s->clip_y1);
+  else
+    u8g2_SetMaxClipWindow(&u8g2);
+  draw_new(&u8g2, &t);
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+    {
+      dx = is_r2 ? W-1-x : x;
+      dy = is_r2 ? H-1-y : y;
+      frame[y][x] = get_pixel(buf, dx, dy);
+    }
+}
+
+static void render_pages(const struct scene *s)
+{
+  uint8_t mask, *p;
+  int x, y, row;
+
+  u8g2_SetDrawColor(&u8g2_page, s->color);
+  for( row = 0; row < H/8; row++ )
+  {
+    u8g2_SetBufferCurrTileRow(&u8g2_page, row);
+    if ( s->is_clip )
+      u8g2_SetClipWindow(&u8g2_page, s->clip_x0, s->clip_y0, s->clip_x1, s->clip_y1);
+    else
+      u8g2_SetMaxClipWindow(&u8g2_page);
+    for( y = 0; y < 8; y++ )
+      for( x = 0; x < W; x++ )
+      {
+	p = page_buf + x;
+	mask = 1 << y;
+	*p = background(x, row*8+y) ? *p | mask : *p & ~mask;
+      }
+    draw_new(&u8g2_page, s);
+    for( y = 0; y < 8; y++ )
+      for( x = 0; x < W; x++ )
+	frame[row*8+y][x] = (page_buf[x] >> y) & 1;
+  }
+}
+
+static unsigned check_modes(void)
+{
+  struct scene s;
+  unsigned i, errors = 0, mode;
+
+  for( i = 0; i < 30000; i++ )
+  {
+    random_scene(&s, i % 3);
+
+    /* draw color 2 on a clear buffer is the same as draw color 1 */
+    render_full(&s, 0, 1, 1);
+    memcpy(expect, frame, sizeof(frame));
+    render_full(&s, 0, 2, 1);
+    if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+    {
+      if ( errors < 5 )
+	printf("difference: draw color 2, scene %u\n", i);
+      errors++;
+    }
+
+    s.color = rand() % 3;
+    s.is_clip = (i % 4) == 0;
+    s.clip_x0 = rnd(0, W-1); s.clip_x1 = rnd(s.clip_x0+1, W);
+    s.clip_y0 = rnd(0, H-1); s.clip_y1 = rnd(s.clip_y0+1, H);
+    render_full(&s, 0, s.color, 0);
+    memcpy(expect, frame, sizeof(frame));
+    for( mode = 1; mode < 3; mode++ )
+    {
+      if ( mode == 1 )
+      {
+	render_full(&s, 1, s.color, 0);
+      }
+      else
+      {
+	render_pages(&s);
+      }
+      if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+      {
+	if ( errors < 5 )
+	  printf("difference: scene %u, mode %u\n", i, mode);
+	errors++;
+      }
+    }
+  }
+  u8g2_SetDisplayRotation(&u8g2, U8G2_R0);
+  u8g2_SetMaxClipWindow(&u8g2);
+  printf("color 2, rotation, page buffer: %u differences\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+struct bench
+{
+  const char *name;
+  struct scene s;
+};
+
+static const struct bench benches[] =
+{
+  { "disc r3", { SHAPE_DISC, 64, 32, 0, 0, 3, U8G2_DRAW_ALL } },
+  { "disc r8", { SHAPE_DISC, 64, 32, 0, 0, 8, U8G2_DRAW_ALL } },
+  { "disc r16", { SHAPE_DISC, 64, 32, 0, 0, 16, U8G2_DRAW_ALL } },
+  { "disc r31", { SHAPE_DISC, 64, 32, 0, 0, 31, U8G2_DRAW_ALL } },
+  { "ellipse 30x15", { SHAPE_ELLIPSE, 64, 32, 30, 15, 0, U8G2_DRAW_ALL } },
+  { "rbox 40x16 r3", { SHAPE_RBOX, 20, 10, 40, 16, 3 } },
+  { "rbox 100x12 r5", { SHAPE_RBOX, 14, 40, 100, 12, 5 } },
+  { "rbox 128x64 r10", { SHAPE_RBOX, 0, 0, 128, 64, 10 } },
+};
+
+/* best of 100 rounds */
+static double bench_ns(const struct bench *b, uint8_t is_ref, unsigned n)
+{
+  double ns;
+
+  if ( is_ref )
+    BENCH_NS(ns, 100, n, draw_ref(&u8g2, &b->s));
+  else
+    BENCH_NS(ns, 100, n, draw_new(&u8g2, &b->s));
+  return ns;
+}
+
+int main(void)
+{
+  const struct bench *b;
+  unsigned errors = 0;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, W, H);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_ClearBuffer(&u8g2);
+
+  u8x8_SetupBitmap(u8g2_GetU8x8(&u8g2_page), W, H);
+  u8g2_SetupBuffer(&u8g2_page, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2_page));
+
+  errors += check_previous();
+  errors += check_modes();
+
+  u8g2_SetDrawColor(&u8g2, 1);
+  printf("\n%-18s %12s %12s\n", "ns/call", "previous", "spans");
+  for( b = benches; b < benches + sizeof(benches)/sizeof(*benches); b++ )
+    printf("%-18s %12.1f %12.1f\n", b->name, bench_ns(b, 1, 500), bench_ns(b, 0, 500));
+
+  if ( errors != 0 )
+    return 1;
+  return 0;
+}
@@ -0,0 +1,67 @@
+/*
+
+  bench.h
+
+  timing of the host benches in sys/bitmap
+
+  BENCH_NS(ns, rounds, n, statement)
+    ns = time of one execution of the statement, the best of "rounds"
+    rounds of "n" executions. The host timing is noisy, the best round
+    gives the most stable result.
+
+  BENCH_CALIBRATED_NS(ns, rounds, round_ns, max_n, statement)
+    same, the number of executions in each round is chosen from a first
+    execution, so that a round takes about round_ns (1..max_n executions)
+
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <time.h>
+
+static inline double bench_now_ns(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec*1e9 + t.tv_nsec;
+}
+
+/* executions for a round of about round_ns, if one execution takes ns */
+static inline unsigned bench_round_cnt(double ns, double round_ns, unsigned max_n)
+{
+  if ( ns <= 0 || round_ns / ns >= max_n )
+    return max_n;
+  if ( round_ns / ns < 1 )
+    return 1;
+  return (unsigned)(round_ns / ns);
+}
+
+/* the statement is the last argument, it may contain commas */
+#define BENCH_NS(ns, rounds, n, ...) \
+  do { \
+    double bench_t_, bench_best_ = 1e12; \
+    unsigned bench_round_, bench_i_; \
+    for( bench_round_ = 0; bench_round_ < (rounds); bench_round_++ ) \
+    { \
+      bench_t_ = bench_now_ns(); \
+      for( bench_i_ = 0; bench_i_ < (n); bench_i_++ ) \
+	{ __VA_ARGS__; } \
+      bench_t_ = bench_now_ns() - bench_t_; \
+      if ( bench_t_ < bench_best_ ) \
+	bench_best_ = bench_t_; \
+    } \
+    (ns) = bench_best_ / (n); \
+  } while(0)
+
+#define BENCH_CALIBRATED_NS(ns, rounds, round_ns, max_n, ...) \
+  do { \
+    double bench_t0_; \
+    unsigned bench_n_; \
+    bench_t0_ = bench_now_ns(); \
+    { __VA_ARGS__; } \
+    bench_n_ = bench_round_cnt(bench_now_ns() - bench_t0_, (round_ns), (max_n)); \
+    BENCH_NS(ns, rounds, bench_n_, __VA_ARGS__); \
+  } while(0)
+
+#endif /* BENCH_H */
@@ -0,0 +1,74 @@
+/*
+
+  font_scene.c
+
+  random text scenes, see font_scene.h
+
+*/
+
+#include "font_scene.h"
+#include <stdlib.h>
+
+static uint8_t *full_buf;
+static uint8_t page_buf[128];
+
+void font_scene_setup(u8g2_t *u8g2)
+{
+  u8g2_SetupBitmap(u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(u8g2));
+  full_buf = u8g2_GetBufferPtr(u8g2);
+}
+
+void font_scene_rnd(font_scene_t *sc, const uint8_t * const *fonts, unsigned font_cnt)
+{
+  unsigned i, len = rand() % (sizeof(sc->s) - 1);
+  sc->font = fonts[rand() % font_cnt];
+  sc->color = rand() % 3;
+  sc->is_transparent = rand() % 2;
+  sc->is_page = rand() % 2;
+  sc->is_clip = rand() % 4 == 0;
+  sc->clip_x0 = rand() % 128;
+  sc->clip_y0 = rand() % 64;
+  sc->clip_x1 = sc->clip_x0 + rand() % (129 - sc->clip_x0);
+  sc->clip_y1 = sc->clip_y0 + rand() % (65 - sc->clip_y0);
+  sc->x = rand() % 160 - 20;	/* wraps around for u8g2_uint_t */
+  sc->y = rand() % 96 - 8;
+  for( i = 0; i < len; i++ )
+    sc->s[i] = 32 + rand() % 224;	/* includes chars which are not in the _tr fonts */
+  sc->s[len] = '\0';
+}
+
+void font_scene_full_buffer(u8g2_t *u8g2)
+{
+  u8g2_SetupBuffer(u8g2, full_buf, 8, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+}
+
+/* the background is a pattern, so that draw color 0 and 2 change something */
+void font_scene_draw(u8g2_t *u8g2, const font_scene_t *sc, void (*prepare)(u8g2_t *u8g2), uint8_t *pic)
+{
+  u8g2_uint_t x, y;
+
+  if ( sc->is_page )
+    u8g2_SetupBuffer(u8g2, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  else
+    font_scene_full_buffer(u8g2);
+  if ( prepare != NULL )
+    prepare(u8g2);
+  u8g2_SetFont(u8g2, sc->font);
+  u8g2_SetFontMode(u8g2, sc->is_transparent);
+  u8g2_FirstPage(u8g2);
+  do
+  {
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2_SetDrawColor(u8g2, 1);
+    u8g2_DrawBox(u8g2, 0, 20, 128, 24);
+    if ( sc->is_clip )
+      u8g2_SetClipWindow(u8g2, sc->clip_x0, sc->clip_y0, sc->clip_x1, sc->clip_y1);
+    u8g2_SetDrawColor(u8g2, sc->color);
+    u8g2_DrawStr(u8g2, sc->x, sc->y, sc->s);
+  } while( u8g2_NextPage(u8g2) );
+
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+      pic[y*128+x] = u8x8_GetBitmapPixel(u8g2_GetU8x8(u8g2), x, y);
+}
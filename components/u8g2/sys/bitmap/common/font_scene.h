@@ -0,0 +1,45 @@
+/*
+
+  font_scene.h
+
+  random text scenes on the Bitmap device (128x64, U8G2_R0) for the benches
+  which compare a faster way to draw glyphs with the font decoder:
+  font, draw color, font mode, clip window, position (partly outside of
+  the display), full or page buffer mode and a string of chars 32..255
+
+*/
+
+#ifndef FONT_SCENE_H
+#define FONT_SCENE_H
+
+#include "u8g2.h"
+
+typedef struct
+{
+  const uint8_t *font;
+  uint8_t color;
+  uint8_t is_transparent;
+  uint8_t is_page;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+  u8g2_uint_t x, y;
+  char s[24];
+} font_scene_t;
+
+/* u8g2_SetupBitmap() and u8x8_InitDisplay() for the scenes, full buffer mode */
+void font_scene_setup(u8g2_t *u8g2);
+
+void font_scene_rnd(font_scene_t *sc, const uint8_t * const *fonts, unsigned font_cnt);
+
+/*
+  Draw the scene into pic, one byte per pixel (128*64 bytes).
+  prepare is called after the buffer has been set up, before the scene is
+  drawn, e.g. to attach a glyph cache. It may be NULL.
+  Leaves u8g2 in the buffer mode of the scene.
+*/
+void font_scene_draw(u8g2_t *u8g2, const font_scene_t *sc, void (*prepare)(u8g2_t *u8g2), uint8_t *pic);
+
+/* back to full buffer mode after font_scene_draw() */
+void font_scene_full_buffer(u8g2_t *u8g2);
+
+#endif /* FONT_SCENE_H */
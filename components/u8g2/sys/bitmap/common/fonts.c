@@ -0,0 +1,127 @@
+/* generated with tools/font/bdfconv: bdfconv -b 0 -f 1 -m "32-127" 9x15.bdf / helvB18.bdf */
+#include "u8g2.h"
+/*
+  Fontname: -Misc-Fixed-Medium-R-Normal--15-140-75-75-C-90-ISO10646-1
+  Copyright: Public domain font.  Share and enjoy.
+  Glyphs: 95/4777
+  BBX Build Mode: 0
+*/
+const uint8_t u8g2_font_9x15_tr[1250] U8G2_FONT_SECTION("u8g2_font_9x15_tr") = 
+  "_\0\3\2\4\4\4\5\5\11\17\0\375\12\375\13\377\1\224\3<\4\305 \5\0\310\63!\10\261\14"
+  "\63\16\221\0\42\10\64{\63\42S\0#\16\206\31s\242\226a\211Z\206%j\1$\24\267\371\362\302"
+  "A\211\42)L\322\65\11#\251\62\210\31\0%\21\247\11sB%JJ\255q\32\265\224\22\61\1&"
+  "\22\247\11s\304(\213\262(T\65)\251E\225H\13'\6\61|\63\6(\14\303\373\262\222(\211z"
+  "\213\262\0)\14\303\373\62\262(\213z\211\222\10*\15w\71\363J\225\266-i\252e\0+\13w\31"
+  "\363\342\332\60dq\15,\11R\334\62\206$Q\0-\7\27I\63\16\1.\7\42\14\63\206\0/\14"
+  "\247\11\263\323\70-\247\345\64\6\60\15\247\11\263\266J\352k\222e\23\0\61\15\247\11\363R\61\311\242"
+  "\270\267a\10\62\14\247\11s\6%U\373y\30\2\63\17\247\11\63\16qZ\335\201\70V\223A\1\64"
+  "\21\247\11sS\61\311\242Z\22&\303\220\306\25\0\65\17\247\11\63\16reH\304\270\254&\203\2\66"
+  "\20\247\11\263\206(\215+C\42\252\326dP\0\67\16\247\11\63\16q\32\247q\32\247q\10\70\21\247"
+  "\11\263\266J\232d\331VI\325$\313&\0\71\17\247\11s\6%uT\206$\256FC\4:\10r"
+  "\14\63\206x\10;\12\242\334\62\206xH\22\5<\11\245\12\63\263\216i\7=\11G)\63\16\71\341"
+  "\20>\12\245\12\63\322\216YG\0\77\16\247\11s\6%U\343\264\71\207\63\0@\22\247\11s\6%"
+  "\65\15J\246D\223\42\347\300\240\0A\15\247\11\363\322$\253\244\326\341j\15B\22\247\11\63\6)L"
+  "R\61\31\244\60I\215\311 \1C\15\247\11s\6%\225\373\232\14\12\0D\15\247\11\63\6)LR"
+  "\77&\203\4E\15\247\11\63\16ry\220\342\346a\10F\14\247\11\63\16ry\220\342\316\0G\17\247"
+  "\11s\6%\225\333\206\324\232\14\12\0H\12\247\11\63R\327\341\352\65I\12\245\12\63\6)\354\247A"
+  "J\24\250\11\363\6\65\7r \7r \7r \12\263!\3K\21\247\11\63R\61\311\242\332\230\204"
+  "QV\12\223\64L\12\247\11\63\342\376<\14\1M\20\247\11\63Ru[*JE\212\244H\265\6N"
+  "\17\247\11\63RuT\62)\322\22q\265\6O\14\247\11s\6%\365\327dP\0P\15\247\11\63."
+  "\251u\30\222\270\63\0Q\17\307\351r\6%\365K&U\6\65\7\4R\20\247\11\63.\251u\30\222"
+  "(+\205I\252\6S\21\247\11s\6%\265\3;\240\3\252\232\14\12\0T\12\247\11\63\16Y\334\337"
+  "\0U\13\247\11\63R\377\232\14\12\0V\21\247\11\63Rk\222EY\224U\302$L\322\14W\20\247"
+  "\11\63RO\221\24I\221\24)\335\22\0X\20\247\11\63R\65\311*i\234&Y%U\3Y\15\247"
+  "\11\63R\65\311*i\334\33\0Z\14\247\11\63\16q\332\347x\30\2[\12\304\373\62\6\255\177\33\2"
+  "\134\21\247\11\63r \316\201\34\210s \7\342\34\10]\12\304\372\62\206\254\177\33\4^\12Gi\363"
+  "\322$\253\244\1_\7\30\370\62\16\2`\7\63\213\63\262\2a\17w\11s\6\35\210\223aHEe"
+  "H\2b\17\247\11\63\342\226!\21U\353\250\14\11\0c\14w\11s\6%\225[\223A\1d\15\247"
+  "\11\263[\206D\134\35\225!\11e\16w\11s\6%U\207s\16\14\12\0f\16\247\11\363\266R\26"
+  "\305\341 \306\215\0g\24\247\331r\206DL\302$\214\206(\7\6%U\223A\1h\14\247\11\63\342"
+  "\226!\21U\257\1i\12\245\12stt\354i\20j\15\326\331\62u\312\332U\64&C\2k\17\247"
+  "\11\63\342VMI\64\65\321\62%\15l\11\245\12\63\306\376\64\10m\20w\11\63\26%\212\244H\212"
+  "\244H\212\324\0n\13w\11\63\222!\21U\257\1o\14w\11s\6%\365\232\14\12\0p\17\247\331"
+  "\62\222!\21U\353\250\14I\134\6q\15\247\331r\206D\134\35\225!\211\33r\14w\11\63\242IK"
+  "\302$n\5s\17w\11s\6%\325\201A\7\324dP\0t\14\227\11\263\342p\330\342n\331\2u"
+  "\20w\11\63\302$L\302$L\302$\214\206$v\16w\11\63R\65\311\242\254\22&i\6w\16w"
+  "\11\63RS$ER\244tK\0x\15w\11\63\322$\253\244\225\254\222\6y\15\246\331\62B\337\224"
+  "%\25\223!\1z\12w\11\63\16i\257\303\20{\15\305\373\262\226\260\32ij\26V\7|\6\301\374"
+  "\62>}\16\305\371\62\326\260\226jR\32V&\0~\12\67ys\64)\322\24\0\0\0\0\4\377\377"
+  "\0";
+/*
+  Fontname: -Adobe-Helvetica-Bold-R-Normal--25-180-100-100-P-138-ISO10646-1
+  Copyright: Copyright (c) 1984, 1987 Adobe Systems Incorporated. All Rights Reserved. Copyright (c) 1988, 1991 Digital Equipment Corporation. All Rights Reserved.
+  Glyphs: 95/756
+  BBX Build Mode: 0
+*/
+const uint8_t u8g2_font_helvB18_tr[2253] U8G2_FONT_SECTION("u8g2_font_helvB18_tr") = 
+  "_\0\4\3\5\5\3\5\6\27\30\0\373\23\373\23\373\2\352\6%\10\260 \6\0\60\232\0!\12c"
+  "\32\236\360\27\352\16\4\42\13\305\270\247 \301\213\221\10\0#*L\26\272$\42&\42&\42&\42&"
+  "\42s@q@#\42&\42&\42&\42s@q@#\42&\42&\42&\42&\42\4$'\254\322"
+  "\265%wt\60A!\261D\304D\344B\314\256\222\262\316L\342D\304D\304D\344B\202\342`\350N"
+  "T\12\0%\61U\22\332=W\66v\64\66\263LJdNJdnfb\362d\264d\36f\36d"
+  "\246t\344pdfnDJlFJlf\325\324\331X\11\0&&P\26\312TzHA\67\63\67"
+  "\63\67\63\70\61\332\364d\206\202bf\346d\252flh\252\206\346\201\310\220\321\0'\10\302\270\233p"
+  "@\1(\26\6w\241$\63\62\63\62\63#\263\377HhfhfhH\0)\26\6w\241 \264f"
+  "hfHhf\377Ff\311\314\310\214\20\0*\20\350\224\253#&#!q\60B#\242\5\0+\16"
+  "\214\65\276%\252\253\203\7S\242\272\2,\12\303\270\235p !A\1-\7g\320\242\360\1.\7c"
+  "\30\236p /\22g\26\242\245\221\224\42)\215\244\24I)\222R\5\60\33L\22\266cu\20CB"
+  "\62\64\62\64\61\346\237M\14\215\14\215\260\71\210\262\1\61\14G\32\266\264\346\340\200h\377\17\62\33L"
+  "\22\266Su \63C\61\65\61f\66\71\70H\307\254\214\216\341\344\301\203\1\63\37L\22\266Su "
+  "\263djbjbjrp\254\356rt\322\314\212b\206\344`\310\6\0\64\33L\22\266\67\310\256\231"
+  "\304\324\304\224\310\220\314\66B#C#\7\17\346&\67\1\65\36L\22\266q\60r\60\62\271\345A\320"
+  "\201\314\14\345\350\344\244\231\325A\14\311\201\224\15\0\66 L\22\266Tu B\63\62ef\271\202\350"
+  "`\244\204\202hb\314\331\304\320\10\233\203(\33\0\67\30L\22\266\360\301 \341\312\301\311\301\311\301\311"
+  "A\302\311A\302\311\71\0\70#L\22\266Dv\20\64\62\63\64\62\64\62\64\62\64\63\62eu\20\63"
+  "\64\61\346\331\304\320\310\301\220\15\0\71 L\22\266ct CBA\64\61\346\331\21\5I\305\1M"
+  "\305\344\244\325\4I\311\201T\21\0:\12\303\31\236p \17y ;\15#\272\235p \17y !"
+  "A\1<\16\215\61\276:X\326\31%mi\247\3=\13\252\270\272\360\300\364\340\300\0>\15\215\65\272"
+  "\60\332[J\262\36\216\2\77\30k\32\276cs Br\20deD\67GF\267p{\4\203\213\0"
+  "@A\326\226\341w {`XVEJC<BT!\62\61t r\263\306fh\306Fh\310d"
+  "hfbdHhbdf\311\232%\63#\23\64$\7U\63\25s\364@\364@U\243\7\305\7\201"
+  "\0A%p\26\312FLkj\71\42\71\62\70\62\67\64\66\64\66\64\65\66\64\66tPsp\62\70"
+  "\62\70\61\352t\0B%o\32\312p@t`\62F\62\70\61\70\61\70\61\70\61\67rPs`\62"
+  "\70\61\351\303\263\212\3\223\3\42\0C\35p\26\312uw@TSBG\61y<\275\257)'&'"
+  "\350Hj\212\16\350\216\0D\36p\32\316p@u`\63V\62H\61\71\61y\352_^N\14R\214"
+  "\225\34\330\34P\1E\26m\32\302pPqP\61\272\247\7$\7$\243\373\364\340A\1F\21l\32"
+  "\276\360\201\345^\36P\34PL\356/\1G#q\26\316ux@USCG\62\71A=\276\331\1"
+  "\331\1\255\355\351\304$\5]I\315\203\211\251\223\1H\16o\32\316\60\351_\36\374 \322\177\71I\10"
+  "c\32\236\360\77\10J\21k\26\272\270\377\241\225W\23\63\24\7\62'\0K'n\32\312\60wF\61"
+  "E\62D\63C\64B\65Av\367 \214\202jfjh\21\315\324\314\330\310\30\305\334\304\34\1L\14"
+  "l\32\276\60\271\377\277<x\60M\62s\32\336\60}{\20{ y\60y@w !'a\61\65"
+  "a\42%b\62\63b\62\63b\243\306fb\306fb\306\250\310\250\310j\312j\312j\1N'o\32"
+  "\316\60y\370 \356 \356@\314b\312b\312d\310f\306f\306h\304J\304j\302\354@\356 \356 "
+  "\360r\0O\35q\26\316ux@USCG\62\71Ay\353o/)&G\350hZ\35\20^\1"
+  "P\27n\32\306p@s`\61\67\61\350\273\211\3\213\203\222\331\375-\0Q#\221\366\315ux@U"
+  "SCG\62\71Ay\353o\317B(\246&F\250l\212\250\16\352.\346\1B\0R\32n\32\306p"
+  "@s`\61\67\61\350\273\211\3\213\203\222\61\212\271\211A\177\70S n\32\306dv\60CSA\66"
+  "\61\67\61K[z\20yZKk\350\356@\246\344\200\352\10\0T\15o\22\276\360\3\261\341\375\377\31"
+  "\0U\23o\32\316\60\351\377\227w\24s#\65\65\7dG\0V$p\26\312\60jzH\61\70B"
+  "F\63\66\64\66\304jhlh\214\204ndpdpd\322\324\226\230\31\0W>u\26\336\60\66f"
+  "\66f\66f\266b\250hd\250hdHBhdfbfFfbFhdbdhDFdh"
+  "bfbJbfBLbfB\254\252\254\252n\341\334\340\334\20\0X%p\26\312\60zHAF"
+  "\63\66\65\64\67\62x\20iKLky\20\70\62\67\64ED\64\66\63\70Ax:Y\36o\26\306"
+  "\60y\70\61\67B\66\63\65D\64\65\63\66\63\67\61\70\61YZ;\274\317\0Z\25n\26\302\360S"
+  "JN)\231R\62\245$\35\245$=\370\0[\15\5w\241p`\262\377\377\311\301\0\134\22g\22\242"
+  " \245LJ\231\224fR\312\244\224I)]\15\5{\241p\60\262\377\377\311\201\1^\23+U\273\64"
+  "\70W&!\65\61\263dfb\312j\0_\7Np\271\360\3`\10\206\364\243\60\264\1a\36\314\25"
+  "\272cu\20\63C\62\64\71fs R\62A\64\61\65\61DARr@R\62b\32l\32\276\60"
+  "\271\27\65\7#%\24D\23c~v\64QBq\60\62Q\3c\25\313\25\266ct\20\302b\310p"
+  "/\207&HH\16\202L\0d\31l\26\276\271\67\25#\7\23$\25Cg~\66\61DARr\60"
+  "S\61e\33\314\25\272Dv\20CB\62\64\61fv\360\201\344\350\324\4\15\311\201T\15\0f\20g"
+  "\26\246CR\62\264\344\340dh\377\23\0g\37lv\275S\61r\60AR\61t\346g\23C\24$"
+  "%\7\63\25\223fG#\7C\66\0h\21k\32\276\60\270\27\64\7\23\64\23S\376\257\6i\12c"
+  "\32\236p v\360\7j\15\5s\235\262\361\310\376\177rP\1k\37k\32\272\60\270G\23\63\24#"
+  "$\23\64GVG\23\64#\63#$\63\24C\23CW\3l\10c\32\236\360\77\10m$\321\31\326"
+  "\60ARrp ARr\64d\64d\64d\64d\64d\64d\64d\64d\64d\64d\264\0n"
+  "\20\313\31\276\60Qr\60A\63\61\345\377j\0o\27\314\25\272Dv\20CB\62\64\61\346g\23C"
+  "#l\16\302\210\0p\33lz\275\60Qs\60RBA\64\61\346gG\23%\24\7#\23\65\223\273"
+  "\4q\31lv\275S\61r\60AR\61t\346g\23C\24$%\7\63\25\223{r\15\307\31\252\60"
+  "q\360fh\377\10\0s\31\313\25\266bt\20\302bhb\320\354 \314\360\312\352\206\342@\346\4\0"
+  "t\17G\26\246\62\264\311\301\311\320\376Q\15\1u\20\313\31\276\60\345\377\210b\244\302bfd\0v"
+  "\32\314\25\272\60\346lbhdhdhfdhdhd\312\314\216\220\21\0w+\323\21\316\60\65"
+  "e\265BjJd\246fd\246fF\205\214\220\310\304\210\320\304V\22\62\22b\65e\65uS\203S"
+  "\203SC\0x\32\313\25\266\60uC\61\263b\350\252n\256\254jb\206\202df\202\346j\0y "
+  "mv\275\60g\67\61\66A\64\63\64CB\64\62\65\62fgXH\272rtr\260\220\16\0z\23"
+  "\313\25\266\360A\334:\62\272\71\62\272ut\7\17\2{\17\7w\251\64\263h\277Y\64\265h\277Z"
+  "|\10\2\177\235\360\17\14}\20\7{\251\60\265h\277Z\64\263h\277Y\4~\15\213\264\272As\60"
+  "aq\60C\1\0\0\0\4\377\377\0";
@@ -0,0 +1,154 @@
+/*
+
+  ssd1306_model.c
+
+  model of the SSD1306 display RAM, see ssd1306_model.h
+
+*/
+
+#include "ssd1306_model.h"
+#include <string.h>
+
+uint8_t ssd1306_ram[8][128];
+int ssd1306_is_scrolling;
+unsigned ssd1306_scroll_writes;
+unsigned ssd1306_i2c_errors;
+
+static int mode = 2, col0, col1 = 127, page0, page1 = 7, col, page;
+static uint8_t cmd[7];
+static int cmd_len;
+static int scroll_dir, scroll_page0, scroll_page1;
+
+/* I2C: 0: control byte expected, 1: data or command byte, depends on i2c_dc */
+static int i2c_state, i2c_dc, i2c_continuation;
+
+void ssd1306_model_reset(void)
+{
+  memset(ssd1306_ram, 0, sizeof(ssd1306_ram));
+  mode = 2, col0 = 0, col1 = 127, page0 = 0, page1 = 7, col = 0, page = 0;
+  cmd_len = 0;
+  ssd1306_is_scrolling = 0;
+  ssd1306_scroll_writes = 0;
+  ssd1306_i2c_errors = 0;
+  i2c_state = 0;
+}
+
+static void model_data(uint8_t d)
+{
+  if ( ssd1306_is_scrolling && page >= scroll_page0 && page <= scroll_page1 )
+    ssd1306_scroll_writes++;
+  ssd1306_ram[page][col] = d;
+  col++;
+  if ( mode == 2 )
+  {
+    if ( col > 127 )
+      col = 0;
+    return;
+  }
+  if ( col > col1 )
+  {
+    col = col0;
+    page = page == page1 ? page0 : page + 1;
+  }
+}
+
+/* the display moved the scrolled pages by SSD1306_MODEL_SCROLL_SHIFT columns */
+static void model_stop_scroll(void)
+{
+  uint8_t row[128];
+  int p, x;
+
+  for( p = scroll_page0; p <= scroll_page1; p++ )
+  {
+    for( x = 0; x < 128; x++ )
+      if ( scroll_dir == 0 )
+	row[(x + SSD1306_MODEL_SCROLL_SHIFT) % 128] = ssd1306_ram[p][x];
+      else
+	row[x] = ssd1306_ram[p][(x + SSD1306_MODEL_SCROLL_SHIFT) % 128];
+    memcpy(ssd1306_ram[p], row, 128);
+  }
+  ssd1306_is_scrolling = 0;
+}
+
+static void model_cmd(uint8_t b)
+{
+  uint8_t c;
+  cmd[cmd_len++] = b;
+  c = cmd[0];
+  if ( c == 0x81 || c == 0x8d || c == 0xa8 || c == 0xd3 || c == 0xd5 || c == 0xd9 || c == 0xda || c == 0xdb || c == 0x20 )
+  {
+    if ( cmd_len < 2 )
+      return;
+    if ( c == 0x20 )
+      mode = cmd[1];
+  }
+  else if ( c == 0x21 || c == 0x22 )
+  {
+    if ( cmd_len < 3 )
+      return;
+    if ( c == 0x21 )
+      col0 = col = cmd[1], col1 = cmd[2];
+    else
+      page0 = page = cmd[1], page1 = cmd[2];
+  }
+  else if ( c == 0x26 || c == 0x27 )
+  {
+    if ( cmd_len < 7 )
+      return;
+    scroll_dir = c & 1;
+    scroll_page0 = cmd[2];
+    scroll_page1 = cmd[4];
+  }
+  else if ( c == 0x2f )
+    ssd1306_is_scrolling = 1;
+  else if ( c == 0x2e )
+  {
+    if ( ssd1306_is_scrolling )
+      model_stop_scroll();
+  }
+  else if ( (c & 0xf0) == 0xb0 )
+    page = c & 7;
+  else if ( (c & 0xf0) == 0x10 )
+    col = (col & 15) | ((c & 15) << 4);
+  else if ( (c & 0xf0) == 0x00 )
+    col = (col & 0xf0) | (c & 15);
+  cmd_len = 0;
+}
+
+void ssd1306_model_byte(int dc, uint8_t b)
+{
+  if ( dc )
+    model_data(b);
+  else
+    model_cmd(b);
+}
+
+/*========================================================*/
+/* I2C */
+
+void ssd1306_model_i2c_start(void)
+{
+  i2c_state = 0;
+}
+
+/*
+  The first byte after the address is a control byte: bit 6 (D/C#) selects
+  data or command, with bit 7 (Co) clear all following bytes are data or
+  commands, with Co set one byte follows and then another control byte.
+  Only 0x00, 0x40, 0x80 and 0xc0 are valid control bytes.
+*/
+void ssd1306_model_i2c_byte(uint8_t b)
+{
+  if ( i2c_state == 0 )
+  {
+    if ( (b & 0x3f) != 0 )
+      ssd1306_i2c_errors++;
+    i2c_dc = (b & 0x40) != 0;
+    i2c_continuation = (b & 0x80) != 0;
+    i2c_state = 1;
+    return;
+  }
+  ssd1306_model_byte(i2c_dc, b);
+  if ( i2c_continuation )
+    i2c_state = 0;
+}
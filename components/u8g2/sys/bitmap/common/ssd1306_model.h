@@ -0,0 +1,33 @@
+/*
+
+  ssd1306_model.h
+
+  model of the SSD1306 display RAM for the host benches:
+  page and horizontal addressing, horizontal scroll,
+  4-wire SPI (DC line) and I2C (control bytes)
+
+*/
+
+#ifndef SSD1306_MODEL_H
+#define SSD1306_MODEL_H
+
+#include <stdint.h>
+
+/* columns the display moved the scrolled pages until the scroll is stopped */
+#define SSD1306_MODEL_SCROLL_SHIFT 37
+
+extern uint8_t ssd1306_ram[8][128];
+extern int ssd1306_is_scrolling;
+extern unsigned ssd1306_scroll_writes;	/* data bytes written to a scrolled page while scrolling */
+extern unsigned ssd1306_i2c_errors;	/* I2C transfers without a valid control byte */
+
+void ssd1306_model_reset(void);
+
+/* 4-wire SPI: one byte with the level of the DC line */
+void ssd1306_model_byte(int dc, uint8_t b);
+
+/* I2C: start (or repeated start) of a write, then the bytes after the address */
+void ssd1306_model_i2c_start(void);
+void ssd1306_model_i2c_byte(uint8_t b);
+
+#endif /* SSD1306_MODEL_H */
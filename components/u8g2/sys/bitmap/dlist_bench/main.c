@@ -0,0 +1,124 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Compares full buffer mode, page buffer mode and page buffer mode with a
+ * display list (u8g2_dlist.c) on the Bitmap device (128x64, U8G2_R0).
+ * The screen is similar to the track screen of the receiver: three
+ * centered text lines, a clock and a progress bar.
+ * Prints buffer RAM and frame time, and checks that all modes draw the
+ * same picture.
+ */
+
+extern const uint8_t u8g2_font_9x15_tr[];
+extern const uint8_t u8g2_font_helvB18_tr[];
+
+u8g2_t u8g2;
+
+static uint8_t page_buf[128];
+static uint8_t dl_buf[512];
+static u8g2_dlist_t dl;
+
+static const char *lines[3] = { "Artist Name", "A Rather Long Title", "Album" };
+
+static void draw_screen(void)
+{
+  u8g2_uint_t i, w;
+  u8g2_SetFont(&u8g2, u8g2_font_9x15_tr);
+  for( i = 0; i < 3; i++ )
+  {
+    w = u8g2_GetStrWidth(&u8g2, lines[i]);
+    u8g2_DrawStr(&u8g2, (128 - w)/2, u8g2_GetMaxCharHeight(&u8g2)*(i+1) - 4, lines[i]);
+  }
+  u8g2_SetFont(&u8g2, u8g2_font_helvB18_tr);
+  u8g2_DrawStr(&u8g2, 2, 58, "3:27");
+  u8g2_DrawFrame(&u8g2, 60, 50, 66, 8);
+  u8g2_DrawBox(&u8g2, 62, 52, 40, 4);
+}
+
+static void record_screen(void)
+{
+  u8g2_uint_t i, w;
+  u8g2_ClearDisplayList(&u8g2, &dl);
+  u8g2_DLSetFont(&u8g2, &dl, u8g2_font_9x15_tr);
+  for( i = 0; i < 3; i++ )
+  {
+    w = u8g2_GetStrWidth(&u8g2, lines[i]);
+    u8g2_DLDrawStr(&u8g2, &dl, (128 - w)/2, u8g2_GetMaxCharHeight(&u8g2)*(i+1) - 4, lines[i]);
+  }
+  u8g2_DLSetFont(&u8g2, &dl, u8g2_font_helvB18_tr);
+  u8g2_DLDrawStr(&u8g2, &dl, 2, 58, "3:27");
+  u8g2_DLDrawFrame(&u8g2, &dl, 60, 50, 66, 8);
+  u8g2_DLDrawBox(&u8g2, &dl, 62, 52, 40, 4);
+}
+
+static void frame_full_buffer(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  draw_screen();
+  u8g2_SendBuffer(&u8g2);
+}
+
+static void frame_page(void)
+{
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    draw_screen();
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+static void frame_page_dlist(void)
+{
+  record_screen();
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_DrawDisplayList(&u8g2, &dl);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+static void get_picture(uint8_t *pic)
+{
+  u8g2_uint_t x, y;
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+      pic[y*128+x] = u8x8_GetBitmapPixel(u8g2_GetU8x8(&u8g2), x, y);
+}
+
+/* us per frame, best of 5 rounds */
+static double bench(void (*frame)(void), uint8_t *pic)
+{
+  double ns;
+  frame();
+  get_picture(pic);
+  BENCH_NS(ns, 5, 4000, frame());
+  return ns / 1000.0;
+}
+
+int main(void)
+{
+  static uint8_t pic_full[128*64], pic_page[128*64], pic_dlist[128*64];
+  double t_full, t_page, t_dlist;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  t_full = bench(frame_full_buffer, pic_full);
+
+  /* same device, one tile row of buffer */
+  u8g2_SetupBuffer(&u8g2, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  t_page = bench(frame_page, pic_page);
+  u8g2_InitDisplayList(&u8g2, &dl, dl_buf, sizeof(dl_buf));
+  t_dlist = bench(frame_page_dlist, pic_dlist);
+
+  printf("%-24s %10s %14s %8s\n", "mode", "RAM bytes", "frame time us", "picture");
+  printf("%-24s %10d %14.1f %8s\n", "full buffer", 1024, t_full, "ref");
+  printf("%-24s %10d %14.1f %8s\n", "page buffer", (int)sizeof(page_buf), t_page, 
+    memcmp(pic_full, pic_page, sizeof(pic_full)) ? "DIFF" : "same");
+  printf("%-24s %10d %14.1f %8s\n", "page buffer + dlist", (int)(sizeof(page_buf) + dl.len), t_dlist, 
+    memcmp(pic_full, pic_dlist, sizeof(pic_full)) || dl.is_overflow ? "DIFF" : "same");
+  printf("display list: %u of %u bytes used\n", dl.len, dl.size);
+  return 0;
+}
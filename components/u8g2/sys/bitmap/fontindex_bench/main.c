@@ -0,0 +1,120 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdint.h>
+#include "bench.h"
+
+/*
+ * Glyph index of fonts built with bdfconv -f 3 (bbx_mode bit 7).
+ * Each font is built from tools/font/bdf with -f 1 and -f 3 (see Makefile).
+ * For all encodings 0..65535, u8g2_font_get_glyph_data() of the indexed
+ * font (u8g2_font_get_indexed_glyph_data) must find the same glyph record
+ * as the linear search in the font without index, or none in both.
+ * Prints the font sizes and the mean lookup time over all glyphs of the
+ * font.
+ */
+
+#include "u8g2_font_helvB10_f1.c"
+#include "u8g2_font_helvB10_f3.c"
+#include "u8g2_font_profont22_f1.c"
+#include "u8g2_font_profont22_f3.c"
+#include "u8g2_font_9x15_f1.c"
+#include "u8g2_font_9x15_f3.c"
+#include "u8g2_font_gb16st_f1.c"
+#include "u8g2_font_gb16st_f3.c"
+
+/* not in u8g2.h */
+const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding);
+
+struct font_pair
+{
+  const char *name;
+  const uint8_t *f1;
+  const uint8_t *f3;
+};
+
+static const struct font_pair fonts[] =
+{
+  { "helvB10", u8g2_font_helvB10_f1, u8g2_font_helvB10_f3 },
+  { "profont22", u8g2_font_profont22_f1, u8g2_font_profont22_f3 },
+  { "9x15", u8g2_font_9x15_f1, u8g2_font_9x15_f3 },
+  { "gb16st", u8g2_font_gb16st_f1, u8g2_font_gb16st_f3 },
+};
+
+u8g2_t u8g2;
+
+static const uint8_t *data_f1[65536];
+static uint16_t encodings[65536];
+static unsigned glyph_cnt;
+
+/* the glyph record (size, data) in front of the glyph data */
+static int same_glyph(const uint8_t *a, const uint8_t *b, uint32_t encoding)
+{
+  unsigned i, header = encoding <= 255 ? 2 : 3;
+  if ( a == NULL || b == NULL )
+    return a == b;
+  if ( a[-1] != b[-1] )
+    return 0;
+  for( i = 0; i + header < a[-1]; i++ )
+    if ( a[i] != b[i] )
+      return 0;
+  return 1;
+}
+
+static unsigned check(const struct font_pair *fp)
+{
+  uint32_t e;
+  unsigned errors = 0;
+
+  glyph_cnt = 0;
+  u8g2_SetFont(&u8g2, fp->f1);
+  if ( u8g2.font_info.glyph_index_pos != 0 )
+    errors++;
+  for( e = 0; e < 65536; e++ )
+  {
+    data_f1[e] = u8g2_font_get_glyph_data(&u8g2, e);
+    if ( data_f1[e] != NULL )
+      encodings[glyph_cnt++] = e;
+  }
+
+  u8g2_SetFont(&u8g2, fp->f3);
+  if ( u8g2.font_info.glyph_index_pos == 0 )
+    errors++;
+  for( e = 0; e < 65536; e++ )
+    if ( same_glyph(data_f1[e], u8g2_font_get_glyph_data(&u8g2, e), e) == 0 )
+      errors++;
+  return errors;
+}
+
+/* mean ns per lookup of each glyph of the font */
+static double lookup_ns(const uint8_t *font)
+{
+  volatile uintptr_t sink = 0;
+  unsigned j;
+  double ns;
+  u8g2_SetFont(&u8g2, font);
+  BENCH_NS(ns, 5, 1,
+    for( j = 0; j < glyph_cnt; j++ )
+      sink ^= (uintptr_t)u8g2_font_get_glyph_data(&u8g2, encodings[j]));
+  (void)sink;
+  return ns / glyph_cnt;
+}
+
+int main(void)
+{
+  const struct font_pair *fp;
+  unsigned errors, total_errors = 0;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+
+  printf("%-12s %7s %9s %9s %10s %10s %8s\n", "font", "glyphs", "bytes -f1", "bytes -f3", "ns -f1", "ns -f3", "glyphs");
+  for( fp = fonts; fp < fonts + sizeof(fonts)/sizeof(*fonts); fp++ )
+  {
+    errors = check(fp);
+    total_errors += errors;
+    printf("%-12s %7u %9u %9u %10.1f %10.1f %8s\n", fp->name, glyph_cnt,
+      (unsigned)u8g2_GetFontSize(fp->f1), (unsigned)u8g2_GetFontSize(fp->f3),
+      lookup_ns(fp->f1), lookup_ns(fp->f3), errors ? "DIFF" : "same");
+  }
+  return total_errors != 0;
+}
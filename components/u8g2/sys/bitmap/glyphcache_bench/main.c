@@ -0,0 +1,124 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "font_scene.h"
+
+/*
+ * Glyph cache (u8g2_SetGlyphCache) on the Bitmap device (128x64, U8G2_R0).
+ * First draws random scenes (common/font_scene.c) with and without the
+ * cache and checks that the pictures are the same: three fonts, helvB18
+ * mostly too large for the cache, draw colors, font modes, clip windows,
+ * full and page buffer mode.
+ * The cache is small, so entries are replaced during the check.
+ * Then prints the time of u8g2_DrawStr() for a line of the receiver
+ * without the cache, with a cold and with a warm cache, together with the
+ * hits, misses and bypass counters of the cache per call, and the memory
+ * of a cache of CACHE_ENTRIES entries (the size of main/ui_controller.c).
+ *
+ * The unifont is built from tools/font (see Makefile).
+ */
+
+#include "u8g2_font_unifont_t_symbols.c"
+
+extern const uint8_t u8g2_font_9x15_tr[];
+extern const uint8_t u8g2_font_helvB18_tr[];
+
+#define CHECK_SCENES 20000
+#define CHECK_CACHE_ENTRIES 16
+#define CACHE_ENTRIES 64
+
+u8g2_t u8g2;
+
+static u8g2_glyph_cache_t cache;
+static u8g2_glyph_cache_entry_t cache_entries[CACHE_ENTRIES];
+
+static const uint8_t *fonts[3] = { u8g2_font_unifont_t_symbols, u8g2_font_9x15_tr, u8g2_font_helvB18_tr };
+
+static const char *line = "Connected to My Phone";
+
+/* the scenes use the cache with its entries, u8g2_SetGlyphCache() would clear them */
+static void attach_cache(u8g2_t *u8g2)
+{
+  u8g2->glyph_cache = &cache;
+}
+
+static unsigned check(void)
+{
+  static uint8_t ref[128*64], pic[128*64];
+  font_scene_t sc;
+  unsigned i, errors = 0;
+
+  u8g2_SetGlyphCache(&u8g2, &cache, cache_entries, CHECK_CACHE_ENTRIES);
+  for( i = 0; i < CHECK_SCENES; i++ )
+  {
+    font_scene_rnd(&sc, fonts, 3);
+    font_scene_draw(&u8g2, &sc, NULL, ref);
+    font_scene_draw(&u8g2, &sc, attach_cache, pic);	/* misses, or hits of earlier scenes */
+    if ( memcmp(ref, pic, sizeof(ref)) != 0 )
+      errors++;
+    font_scene_draw(&u8g2, &sc, attach_cache, pic);	/* mostly hits */
+    if ( memcmp(ref, pic, sizeof(ref)) != 0 )
+      errors++;
+  }
+  printf("%u scenes, %lu hits, %lu misses, %lu bypass, %u differences\n\n", CHECK_SCENES,
+    (unsigned long)cache.hits, (unsigned long)cache.misses, (unsigned long)cache.bypass, errors);
+
+  font_scene_full_buffer(&u8g2);
+  return errors;
+}
+
+static void print_bench(const char *name, double ns, double calls)
+{
+  if ( calls == 0 )
+    printf("%-32s %10.1f %8s %8s %8s\n", name, ns, "-", "-", "-");
+  else
+    printf("%-32s %10.1f %8.1f %8.1f %8.1f\n", name, ns,
+      cache.hits / calls, cache.misses / calls, cache.bypass / calls);
+}
+
+#define ROUNDS 20
+#define N 10000
+
+static void bench_font(const uint8_t *font, const char *name_none, const char *name_cold, const char *name_warm)
+{
+  double ns;
+
+  u8g2_SetFont(&u8g2, font);
+  u8g2_SetFontMode(&u8g2, 0);
+  u8g2_SetDrawColor(&u8g2, 1);
+
+  u8g2.glyph_cache = NULL;
+  BENCH_NS(ns, ROUNDS, N, u8g2_DrawStr(&u8g2, 0, 30, line));
+  print_bench(name_none, ns, 0);
+
+  /* the counters are cleared with the cache, they show the last call */
+  u8g2_SetGlyphCache(&u8g2, &cache, cache_entries, CACHE_ENTRIES);
+  BENCH_NS(ns, ROUNDS, N, u8g2_ClearGlyphCache(&u8g2), u8g2_DrawStr(&u8g2, 0, 30, line));
+  print_bench(name_cold, ns, 1);
+
+  u8g2_ClearGlyphCache(&u8g2);
+  u8g2_DrawStr(&u8g2, 0, 30, line);
+  cache.hits = cache.misses = cache.bypass = 0;
+  BENCH_NS(ns, ROUNDS, N, u8g2_DrawStr(&u8g2, 0, 30, line));
+  print_bench(name_warm, ns, ROUNDS * N);
+}
+
+int main(void)
+{
+  unsigned errors;
+
+  font_scene_setup(&u8g2);
+
+  errors = check();
+
+  /* sizeof of this build, the entry starts with a font pointer */
+  printf("cache memory: %d entries of %u bytes + %u bytes = %u bytes, %u byte pointers\n\n", CACHE_ENTRIES,
+    (unsigned)sizeof(u8g2_glyph_cache_entry_t), (unsigned)sizeof(u8g2_glyph_cache_t),
+    (unsigned)(sizeof(cache_entries) + sizeof(cache)), (unsigned)sizeof(void *));
+
+  printf("%-32s %10s %8s %8s %8s\n", "DrawStr \"Connected to My Phone\"", "ns/call", "hits", "misses", "bypass");
+  bench_font(u8g2_font_unifont_t_symbols, "unifont, no cache", "unifont, cold cache", "unifont, warm cache");
+  bench_font(u8g2_font_helvB18_tr, "helvB18, no cache", "helvB18, cold cache", "helvB18, warm cache");
+  return errors != 0;
+}
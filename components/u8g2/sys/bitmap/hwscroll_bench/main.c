@@ -0,0 +1,307 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306_model.h"
+
+/*
+ * Checks the SSD1306 hardware scroll (U8X8_MSG_DISPLAY_SET_SCROLL) with a
+ * byte driver, which captures the bytes sent to the display and feeds a
+ * model of the SSD1306 RAM (4-wire SPI, u8x8_cad_001).
+ *
+ * 1. The command stream of u8x8_StartScroll() and u8x8_StopScroll(), the
+ *    SH1106 must not send anything and return 0.
+ * 2. Frames sent with u8g2_SendBufferChanged() while the display scrolls
+ *    must not write to the scrolled pages. After u8g2_StopScroll() the
+ *    display RAM must show the last frame again. The model
+ *    (common/ssd1306_model.c) moves the scrolled pages when the scroll
+ *    is stopped.
+ * 3. Bytes sent for a marquee: scrolled in software by one pixel per frame
+ *    or scrolled by the display.
+ */
+
+#define FPS 30
+
+/*==========================================*/
+/* capture byte driver */
+
+static uint8_t cap_dc[256], cap_byte[256];
+static unsigned cap_len;	/* captured bytes, the first 256 are kept */
+static int dc;
+
+static void capture_reset(void)
+{
+  cap_len = 0;
+}
+
+static void capture(uint8_t b)
+{
+  if ( cap_len < sizeof(cap_byte) )
+  {
+    cap_dc[cap_len] = dc;
+    cap_byte[cap_len] = b;
+  }
+  cap_len++;
+  ssd1306_model_byte(dc, b);
+}
+
+static uint8_t capture_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data;
+  u8x8_large_data_t *large;
+  uint16_t i;
+
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SET_DC:
+      dc = arg_int;
+      break;
+    case U8X8_MSG_BYTE_SEND:
+      data = (uint8_t *)arg_ptr;
+      while( arg_int > 0 )
+      {
+	capture(*data++);
+	arg_int--;
+      }
+      break;
+    case U8X8_MSG_BYTE_SEND_LARGE:
+      large = (u8x8_large_data_t *)arg_ptr;
+      for( i = 0; i < large->cnt; i++ )
+	capture(large->data[i]);
+      break;
+  }
+  return 1;
+}
+
+static uint8_t gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*==========================================*/
+/* command stream */
+
+static unsigned expect_cmds(const char *name, uint8_t ret, const uint8_t *cmds, unsigned n)
+{
+  unsigned i;
+
+  if ( ret == 0 || cap_len != n )
+  {
+    printf("%s: returned %u, %u bytes, expected %u\n", name, ret, cap_len, n);
+    return 1;
+  }
+  for( i = 0; i < n; i++ )
+    if ( cap_dc[i] != 0 || cap_byte[i] != cmds[i] )
+    {
+      printf("%s: byte %u is 0x%02x (dc %u), expected 0x%02x\n", name, i, cap_byte[i], cap_dc[i], cmds[i]);
+      return 1;
+    }
+  return 0;
+}
+
+static unsigned check_commands(void)
+{
+  static const uint8_t start_left[] = { 0x2e, 0x27, 0x00, 0x02, 0x07, 0x03, 0x00, 0xff, 0x2f };
+  static const uint8_t start_right[] = { 0x2e, 0x26, 0x00, 0x00, 0x03, 0x07, 0x00, 0xff, 0x2f };
+  static const uint8_t stop[] = { 0x2e };
+  /* interval of speed 0..7: 256, 128, 64, 25, 5, 4, 3, 2 frames */
+  static const uint8_t interval[8] = { 0x03, 0x02, 0x01, 0x06, 0x00, 0x05, 0x04, 0x07 };
+  u8x8_t u8x8;
+  u8g2_t u8g2;
+  unsigned errors = 0;
+  uint8_t speed, ret;
+
+  u8x8_Setup(&u8x8, u8x8_d_ssd1306_128x64_noname, u8x8_cad_001, capture_byte_cb, gpio_and_delay_cb);
+  u8x8_InitDisplay(&u8x8);
+
+  capture_reset();
+  ret = u8x8_StartScroll(&u8x8, 2, 3, U8X8_SCROLL_LEFT, 7);
+  errors += expect_cmds("start left, pages 2..3, speed 7", ret, start_left, sizeof(start_left));
+  capture_reset();
+  ret = u8x8_StopScroll(&u8x8);
+  errors += expect_cmds("stop", ret, stop, sizeof(stop));
+  capture_reset();
+  ret = u8x8_StartScroll(&u8x8, 0, 9, U8X8_SCROLL_RIGHT, 0);
+  errors += expect_cmds("start right, pages 0..9, speed 0", ret, start_right, sizeof(start_right));
+
+  for( speed = 0; speed < 8; speed++ )
+  {
+    capture_reset();
+    u8x8_StartScroll(&u8x8, 0, 7, U8X8_SCROLL_RIGHT, speed);
+    if ( cap_len != 9 || cap_byte[4] != interval[speed] )
+    {
+      printf("speed %u: interval 0x%02x\n", speed, cap_byte[4]);
+      errors++;
+    }
+  }
+  capture_reset();
+  u8x8_StartScroll(&u8x8, 0, 7, U8X8_SCROLL_RIGHT, 200);
+  if ( cap_byte[4] != 0x07 )
+  {
+    printf("speed 200: interval 0x%02x\n", cap_byte[4]);
+    errors++;
+  }
+
+  capture_reset();
+  if ( u8x8_StartScroll(&u8x8, 5, 4, U8X8_SCROLL_RIGHT, 0) != 0 || cap_len != 0 )
+  {
+    printf("empty page range: %u bytes sent\n", cap_len);
+    errors++;
+  }
+
+  /* no scroll commands on the SH1106 */
+  u8x8_Setup(&u8x8, u8x8_d_sh1106_128x64_noname, u8x8_cad_001, capture_byte_cb, gpio_and_delay_cb);
+  u8x8_InitDisplay(&u8x8);
+  capture_reset();
+  if ( u8x8_StartScroll(&u8x8, 2, 3, U8X8_SCROLL_LEFT, 7) != 0 || u8x8_StopScroll(&u8x8) != 0 || cap_len != 0 )
+  {
+    printf("SH1106: %u bytes sent\n", cap_len);
+    errors++;
+  }
+  u8g2_Setup_sh1106_128x64_noname_f(&u8g2, U8G2_R0, capture_byte_cb, gpio_and_delay_cb);
+  u8g2_InitDisplay(&u8g2);
+  capture_reset();
+  if ( u8g2_StartScroll(&u8g2, 2, 3, U8X8_SCROLL_LEFT, 7) != 0 || u8g2.is_scroll_active != 0 || cap_len != 0 )
+  {
+    printf("SH1106: u8g2_StartScroll() did not fail\n");
+    errors++;
+  }
+
+  printf("command stream: %u errors\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* display RAM after stopping */
+
+static u8g2_t u8g2;
+static uint8_t shadow[1024];
+
+static void setup(const u8g2_cb_t *rotation, uint8_t is_shadow)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, capture_byte_cb, gpio_and_delay_cb);
+  u8x8_SetByteMaxLargeTransfer(u8g2_GetU8x8(&u8g2), 1024);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_SetShadowBufferPtr(&u8g2, is_shadow ? shadow : NULL);
+  ssd1306_model_reset();
+}
+
+/* change a few random tiles */
+static void change_tiles(void)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  int i, t;
+
+  for( i = 0; i < 12; i++ )
+  {
+    t = rand() % 128;
+    memset(buf + t*8, rand(), 8);
+  }
+}
+
+static unsigned check_coherency(const char *name, const u8g2_cb_t *rotation, uint8_t is_shadow)
+{
+  uint8_t got[8][128];
+  uint8_t *buf;
+  unsigned i, errors = 0;
+
+  setup(rotation, is_shadow);
+  buf = u8g2_GetBufferPtr(&u8g2);
+  for( i = 0; i < 1024; i++ )
+    buf[i] = rand();
+  u8g2_SendBufferChanged(&u8g2);
+
+  u8g2_StartScroll(&u8g2, 2, 4, U8X8_SCROLL_RIGHT, 3);
+  for( i = 0; i < 40; i++ )
+  {
+    change_tiles();
+    if ( i == 10 )
+      u8g2_InvalidateShadowBuffer(&u8g2);
+    if ( i == 20 )
+      u8g2_StartScroll(&u8g2, 5, 7, U8X8_SCROLL_LEFT, 7);
+    u8g2_SendBufferChanged(&u8g2);
+  }
+  u8g2_StopScroll(&u8g2);
+  if ( ssd1306_scroll_writes != 0 || ssd1306_is_scrolling )
+  {
+    printf("%s: %u bytes written to scrolled pages\n", name, ssd1306_scroll_writes);
+    errors++;
+  }
+
+  /* the display must show the same as after sending the last frame without scroll */
+  memcpy(got, ssd1306_ram, sizeof(got));
+  ssd1306_model_reset();
+  u8g2_SendBuffer(&u8g2);
+  if ( memcmp(got, ssd1306_ram, sizeof(got)) != 0 )
+  {
+    printf("%s: display RAM differs from the last frame after stop\n", name);
+    errors++;
+  }
+  return errors;
+}
+
+/*==========================================*/
+/* bytes for a marquee */
+
+/* pages 0..1 are static, a pattern in pages 2..3 moves left by one pixel per frame */
+static void draw_marquee(unsigned offset)
+{
+  u8g2_uint_t x;
+
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 16);
+  for( x = 0; x < 128; x++ )
+    if ( (x + offset) % 16 < 6 )
+      u8g2_DrawVLine(&u8g2, x, 18, 12);
+}
+
+static void bench_bytes(void)
+{
+  unsigned i, sw_bytes, start_bytes, stop_bytes;
+  char name[40];
+
+  setup(U8G2_R0, 1);
+  draw_marquee(0);
+  u8g2_SendBufferChanged(&u8g2);
+  capture_reset();
+  for( i = 1; i <= 128; i++ )
+  {
+    draw_marquee(i);
+    u8g2_SendBufferChanged(&u8g2);
+  }
+  sw_bytes = cap_len;
+
+  capture_reset();
+  u8g2_StartScroll(&u8g2, 2, 3, U8X8_SCROLL_LEFT, 7);
+  start_bytes = cap_len;
+  capture_reset();
+  u8g2_StopScroll(&u8g2);
+  stop_bytes = cap_len;
+
+  printf("\n%-40s %10s %10s\n", "marquee in pages 2..3", "bytes", "bytes/s");
+  sprintf(name, "software, per frame at %u fps", FPS);
+  printf("%-40s %10.0f %10.0f\n", name, sw_bytes / 128.0, sw_bytes / 128.0 * FPS);
+  printf("%-40s %10u %10s\n", "hardware, start", start_bytes, "-");
+  printf("%-40s %10u %10u\n", "hardware, while scrolling", 0, 0);
+  printf("%-40s %10u %10s\n", "hardware, stop and write the pages", stop_bytes, "-");
+}
+
+int main(void)
+{
+  unsigned errors, ram_errors = 0;
+
+  errors = check_commands();
+  ram_errors += check_coherency("R0, shadow buffer", U8G2_R0, 1);
+  ram_errors += check_coherency("R0, no shadow buffer", U8G2_R0, 0);
+  ram_errors += check_coherency("R2_FLUSH, shadow buffer", U8G2_R2_FLUSH, 1);
+  ram_errors += check_coherency("MIRROR_FLUSH, shadow buffer", U8G2_MIRROR_FLUSH, 1);
+  printf("display RAM after stop: %u errors\n", ram_errors);
+  errors += ram_errors;
+
+  bench_bytes();
+
+  if ( errors != 0 )
+    return 1;
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include "esp_stub.h"
+#include "i2c_stub.h"
+#include "ssd1306_model.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Simulated ESP32 I2C master. Time is counted in ns of CPU time of the
+ * calling task. Each entry of a command link (start, write, stop) costs
+ * I2C_STUB_LINK_NS (the driver allocates it), i2c_master_cmd_begin()
+ * blocks for I2C_STUB_BEGIN_NS (driver, interrupts) plus 9 clocks per
+ * byte and the start and stop condition at the configured clock.
+ * Like the driver, i2c_master_write() keeps a pointer to the data, which is
+ * read during i2c_master_cmd_begin(). The bytes after the address go to
+ * the SSD1306 model.
+ */
+
+#define I2C_STUB_LINK_NS 1500
+#define I2C_STUB_BEGIN_NS 30000
+#define I2C_STUB_MAX_LINK 2048
+
+typedef struct
+{
+  int kind;	/* 0: start, 1: write, 2: stop */
+  const uint8_t *data;
+  size_t len;
+  uint8_t byte;	/* data of i2c_master_write_byte() */
+} i2c_stub_entry_t;
+
+typedef struct
+{
+  i2c_stub_entry_t entry[I2C_STUB_MAX_LINK];
+  unsigned cnt;
+} i2c_stub_link_t;
+
+static uint32_t clk_speed = 100000;
+
+i2c_stub_stat_t i2c_stub;
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+  return malloc(size);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+}
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  return ESP_OK;
+}
+
+void i2c_stub_reset(void)
+{
+  memset(&i2c_stub, 0, sizeof(i2c_stub));
+}
+
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf)
+{
+  clk_speed = conf->master.clk_speed;
+  return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t rx, size_t tx, int flags)
+{
+  return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+  i2c_stub_link_t *link = malloc(sizeof(i2c_stub_link_t));
+  link->cnt = 0;
+  return link;
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t h)
+{
+  free(h);
+}
+
+static i2c_stub_entry_t *i2c_stub_add(i2c_cmd_handle_t h, int kind)
+{
+  i2c_stub_link_t *link = h;
+  assert(link->cnt < I2C_STUB_MAX_LINK);
+  i2c_stub.cpu_ns += I2C_STUB_LINK_NS;
+  i2c_stub.links++;
+  link->entry[link->cnt].kind = kind;
+  return &link->entry[link->cnt++];
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t h)
+{
+  i2c_stub_add(h, 0);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t h)
+{
+  i2c_stub_add(h, 2);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t h, uint8_t data, bool ack)
+{
+  i2c_stub_entry_t *e = i2c_stub_add(h, 1);
+  e->byte = data;
+  e->data = &e->byte;
+  e->len = 1;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t h, uint8_t *data, size_t len, bool ack)
+{
+  i2c_stub_entry_t *e = i2c_stub_add(h, 1);
+  e->data = data;
+  e->len = len;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t h, TickType_t ticks)
+{
+  i2c_stub_link_t *link = h;
+  unsigned i;
+  size_t j;
+  unsigned clocks = 0;
+  int address = 0;	/* 1: the next byte is the address */
+  double ns;
+
+  for( i = 0; i < link->cnt; i++ )
+  {
+    const i2c_stub_entry_t *e = &link->entry[i];
+    if ( e->kind == 0 )
+    {
+      clocks += 1;
+      address = 1;
+      ssd1306_model_i2c_start();
+    }
+    else if ( e->kind == 2 )
+      clocks += 1;
+    else
+    {
+      for( j = 0; j < e->len; j++ )
+      {
+	clocks += 9;
+	if ( address )
+	  address = 0;
+	else
+	{
+	  ssd1306_model_i2c_byte(e->data[j]);
+	  i2c_stub.bytes++;
+	}
+      }
+    }
+  }
+  ns = I2C_STUB_BEGIN_NS + clocks * 1e9 / clk_speed;
+  i2c_stub.cpu_ns += ns;
+  i2c_stub.bus_ns += ns;
+  i2c_stub.transfers++;
+  return ESP_OK;
+}
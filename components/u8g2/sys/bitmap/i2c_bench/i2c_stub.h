@@ -0,0 +1,17 @@
+#ifndef I2C_STUB_H
+#define I2C_STUB_H
+
+typedef struct
+{
+  double cpu_ns;	/* simulated time of the calling task */
+  double bus_ns;	/* part of cpu_ns spent in i2c_master_cmd_begin() */
+  unsigned transfers;	/* i2c_master_cmd_begin() calls */
+  unsigned links;	/* entries added to command links */
+  unsigned bytes;	/* bytes after the address */
+} i2c_stub_stat_t;
+
+extern i2c_stub_stat_t i2c_stub;
+
+void i2c_stub_reset(void);
+
+#endif
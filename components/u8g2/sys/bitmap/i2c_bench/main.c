@@ -0,0 +1,126 @@
+#include "u8g2_esp32_hal.h"
+#include "i2c_stub.h"
+#include "ssd1306_model.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Frame time of the I2C transport in main/u8g2_esp32_hal.c against the
+ * simulated I2C master in i2c_stub.c (SSD1306 128x64, I2C).
+ * Compares the former byte callback (one command link entry per byte,
+ * 24 byte transfers) with the collected transfers of the HAL and checks
+ * with a model of the SSD1306 RAM (common/ssd1306_model.c) that all
+ * variants show the frame and that every transfer starts with a valid
+ * control byte.
+ * Times are simulated, see i2c_stub.c for the cost of a transfer.
+ */
+
+#define PIN_SDA 21
+#define PIN_SCL 22
+#define PIN_RESET 16
+
+/*==========================================*/
+/* the byte callback before the collected transfers */
+
+static i2c_cmd_handle_t legacy_handle;
+
+static uint8_t legacy_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_INIT:
+    {
+      i2c_config_t conf;
+      memset(&conf, 0, sizeof(conf));
+      conf.mode = I2C_MODE_MASTER;
+      conf.sda_io_num = PIN_SDA;
+      conf.scl_io_num = PIN_SCL;
+      conf.master.clk_speed = I2C_MASTER_FREQ_HZ;
+      ESP_ERROR_CHECK(i2c_param_config(I2C_MASTER_NUM, &conf));
+      ESP_ERROR_CHECK(i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0));
+      break;
+    }
+    case U8X8_MSG_BYTE_SEND:
+    {
+      uint8_t *data = arg_ptr;
+      while( arg_int > 0 )
+      {
+	ESP_ERROR_CHECK(i2c_master_write_byte(legacy_handle, *data, ACK_CHECK_EN));
+	data++;
+	arg_int--;
+      }
+      break;
+    }
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      legacy_handle = i2c_cmd_link_create();
+      ESP_ERROR_CHECK(i2c_master_start(legacy_handle));
+      ESP_ERROR_CHECK(i2c_master_write_byte(legacy_handle, u8x8_GetI2CAddress(u8x8) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      ESP_ERROR_CHECK(i2c_master_stop(legacy_handle));
+      ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_MASTER_NUM, legacy_handle, portMAX_DELAY));
+      i2c_cmd_link_delete(legacy_handle);
+      break;
+  }
+  return 0;
+}
+
+/*==========================================*/
+
+static u8g2_t u8g2;
+
+static void setup(u8x8_msg_cb byte_cb)
+{
+  u8g2_esp32_hal_t hal = U8G2_ESP32_HAL_DEFAULT;
+  hal.sda = PIN_SDA;
+  hal.scl = PIN_SCL;
+  hal.reset = PIN_RESET;
+  u8g2_esp32_hal_init(hal);
+  i2c_stub_reset();
+  ssd1306_model_reset();
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, byte_cb, u8g2_esp32_gpio_and_delay_cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+}
+
+static unsigned frame(const char *name)
+{
+  unsigned i, errors = 0;
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  
+  for( i = 0; i < 1024; i++ )
+    buf[i] = i * 37 + 11;
+  memset(ssd1306_ram, 0, sizeof(ssd1306_ram));
+  ssd1306_i2c_errors = 0;
+  i2c_stub_reset();
+  u8g2_SendBuffer(&u8g2);
+  for( i = 0; i < 1024; i++ )
+    if ( ssd1306_ram[i/128][i%128] != (uint8_t)(i * 37 + 11) )
+      errors++;
+  errors += ssd1306_i2c_errors;
+  printf("%-32s %6u %6u %6u %12.1f %12.1f %s\n", name, i2c_stub.transfers, i2c_stub.links, i2c_stub.bytes,
+    i2c_stub.cpu_ns/1e3, (i2c_stub.cpu_ns - i2c_stub.bus_ns)/1e3, errors ? "WRONG" : "ok");
+  return errors;
+}
+
+int main(void)
+{
+  unsigned errors = 0;
+  
+  printf("%-32s %6s %6s %6s %12s %12s\n", "SendBuffer 128x64, 50 kHz", "trans", "links", "bytes", "frame us", "link us");
+  
+  setup(legacy_i2c_byte_cb);
+  errors += frame("byte per link, 24 bytes (before)");
+  
+  setup(u8g2_esp32_i2c_byte_cb);
+  u8x8_SetByteMaxTransfer(u8g2_GetU8x8(&u8g2), 0);
+  u8x8_SetByteMaxLargeTransfer(u8g2_GetU8x8(&u8g2), 0);
+  errors += frame("collected, 24 bytes");
+  setup(u8g2_esp32_i2c_byte_cb);
+  u8x8_SetByteMaxLargeTransfer(u8g2_GetU8x8(&u8g2), 0);
+  errors += frame("collected, tile rows");
+  setup(u8g2_esp32_i2c_byte_cb);
+  errors += frame("collected, one transfer");
+  
+  return errors != 0;
+}
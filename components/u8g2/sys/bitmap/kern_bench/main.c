@@ -0,0 +1,131 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Kerning lookup with the tables written by bdfconv -k for helvB18 
+ * (u8g2_kerning_t helvb18_tr_k and the sorted pair table helvb18_tr_kt).
+ * Checks that the binary search of u8g2_GetKerning() and
+ * u8g2_GetKerningByTable() returns the same values as the former linear
+ * search for all pairs, then prints the time of the lookup and of a kerned
+ * string on the Bitmap device (128x64). helvb18_tr_kt+2 is the same pair
+ * list without the U8G2_KERNING_SORTED_TABLE header, which is searched 
+ * linearly like a hand written table.
+ */
+
+#include "helvb18_tr_k.c"
+
+u8g2_t u8g2;
+
+static const char *str = "AVATAR Typewriter, WAVE";
+
+/* u8g2_GetKerning() before the binary search */
+static uint8_t linear_get_kerning(u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2)
+{
+  uint16_t i1, i2, cnt, end;
+  cnt = kerning->first_table_cnt;
+  cnt--;
+  for( i1 = 0; i1 < cnt; i1++ )
+    if ( kerning->first_encoding_table[i1] == e1 )
+      break;
+  if ( i1 >= cnt )
+    return 0;
+  end = kerning->index_to_second_table[i1+1];
+  for( i2 = kerning->index_to_second_table[i1]; i2 < end; i2++ )
+    if ( kerning->second_encoding_table[i2] == e2 )
+      break;
+  if ( i2 >= end )
+    return 0;
+  return kerning->kerning_values[i2];
+}
+
+static unsigned check(void)
+{
+  unsigned e1, e2, errors = 0;
+  uint8_t k;
+  for( e1 = 0; e1 < 300; e1++ )
+    for( e2 = 0; e2 < 300; e2++ )
+    {
+      k = linear_get_kerning(&helvb18_tr_k, e1, e2);
+      if ( u8g2_GetKerning(&u8g2, &helvb18_tr_k, e1, e2) != k )
+	errors++;
+      if ( u8g2_GetKerningByTable(&u8g2, helvb18_tr_kt, e1, e2) != k )
+	errors++;
+      if ( u8g2_GetKerningByTable(&u8g2, helvb18_tr_kt+2, e1, e2) != k )
+	errors++;
+    }
+  if ( u8g2_GetKerning(&u8g2, &helvb18_tr_k, 0x0ffff, 'A') != 0 )
+    errors++;
+  if ( u8g2_GetKerningByTable(&u8g2, helvb18_tr_kt, 0x0ffff, 'A') != 0 )
+    errors++;
+  return errors;
+}
+
+/* kerning of all pairs of str */
+static unsigned string_kerning(uint8_t (*fn)(const void *kerning, uint16_t e1, uint16_t e2), const void *kerning)
+{
+  const char *s;
+  unsigned sum = 0;
+  for( s = str; s[1] != '\0'; s++ )
+    sum += fn(kerning, s[0], s[1]);
+  return sum;
+}
+
+static uint8_t linear_k(const void *kerning, uint16_t e1, uint16_t e2)
+{
+  return linear_get_kerning((u8g2_kerning_t *)kerning, e1, e2);
+}
+
+static uint8_t binary_k(const void *kerning, uint16_t e1, uint16_t e2)
+{
+  return u8g2_GetKerning(&u8g2, (u8g2_kerning_t *)kerning, e1, e2);
+}
+
+static uint8_t table_k(const void *kerning, uint16_t e1, uint16_t e2)
+{
+  return u8g2_GetKerningByTable(&u8g2, (const uint16_t *)kerning, e1, e2);
+}
+
+/* best of 5 rounds */
+#define BENCH(name, n, ...) \
+  do { \
+    double ns; \
+    BENCH_NS(ns, 5, n, __VA_ARGS__); \
+    printf("%-40s %10.1f\n", name, ns); \
+  } while(0)
+
+int main(void)
+{
+  static uint8_t linear_buf[1024];
+  unsigned errors;
+  volatile unsigned sink;
+  
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_SetFont(&u8g2, u8g2_font_helvB18_tr);
+  
+  errors = check();
+  
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawExtUTF8(&u8g2, 0, 20, 0, helvb18_tr_kt+2, str);
+  memcpy(linear_buf, u8g2_GetBufferPtr(&u8g2), 1024);
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawExtUTF8(&u8g2, 0, 20, 0, helvb18_tr_kt, str);
+  if ( memcmp(linear_buf, u8g2_GetBufferPtr(&u8g2), 1024) != 0 )
+    errors++;
+  printf("%u pairs, %u differences\n\n", helvb18_tr_kt[1], errors);
+  
+  printf("%-40s %10s\n", "ns/call", "");
+  BENCH("u8g2_kerning_t, linear, 22 pairs", 20000, sink = string_kerning(linear_k, &helvb18_tr_k));
+  BENCH("u8g2_kerning_t, binary, 22 pairs", 20000, sink = string_kerning(binary_k, &helvb18_tr_k));
+  BENCH("pair table, linear, 22 pairs", 2000, sink = string_kerning(table_k, helvb18_tr_kt+2));
+  BENCH("pair table, sorted, 22 pairs", 20000, sink = string_kerning(table_k, helvb18_tr_kt));
+  BENCH("DrawExtUTF8, linear table", 2000, u8g2_DrawExtUTF8(&u8g2, 0, 20, 0, helvb18_tr_kt+2, str));
+  BENCH("DrawExtUTF8, sorted table", 20000, u8g2_DrawExtUTF8(&u8g2, 0, 20, 0, helvb18_tr_kt, str));
+  BENCH("DrawExtendedUTF8, u8g2_kerning_t", 20000, u8g2_DrawExtendedUTF8(&u8g2, 0, 20, 0, &helvb18_tr_k, str));
+  BENCH("DrawUTF8, no kerning", 20000, u8g2_DrawUTF8(&u8g2, 0, 20, str));
+  (void)sink;
+  return errors != 0;
+}
@@ -0,0 +1,244 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Timing of the u8g2 primitives, written as JSON to stdout, so that the
+ * results of two versions can be compared ("make perf_bench.json").
+ *
+ * The drawing procedures run on the Bitmap device (128x64) in full buffer
+ * mode and in page mode (one tile row, the procedure is called for each of
+ * the 8 pages, without sending them), for U8G2_R0..U8G2_R3.
+ * SendBuffer runs on the SSD1306 driver (u8x8_cad_001) with a byte driver,
+ * which only counts the bytes. In page mode, all 8 pages are sent.
+ *
+ * Each result is the best of ROUNDS rounds, the host timing is noisy.
+ */
+
+#ifndef PERF_BENCH_VERSION
+#define PERF_BENCH_VERSION ""
+#endif
+
+#define W 128
+#define H 64
+#define ROUNDS 50
+#define ROUND_NS 200000.0	/* calls in each round are chosen to take about this time */
+
+#include "u8g2_font_5x7_tr.c"
+#include "u8g2_font_ncenB14_tr.c"
+#include "u8g2_font_6x13_tf.c"
+
+struct font
+{
+  const char *name;
+  const uint8_t *font;
+};
+
+static const struct font fonts[] =
+{
+  { "5x7_tr", u8g2_font_5x7_tr },
+  { "ncenB14_tr", u8g2_font_ncenB14_tr },
+  { "6x13_tf", u8g2_font_6x13_tf },
+};
+
+struct rotation
+{
+  const char *name;
+  const u8g2_cb_t *cb;
+};
+
+static const struct rotation rotations[] =
+{
+  { "R0", U8G2_R0 },
+  { "R1", U8G2_R1 },
+  { "R2", U8G2_R2 },
+  { "R3", U8G2_R3 },
+};
+
+static u8g2_t u8g2;		/* Bitmap device */
+static u8g2_t oled;		/* SSD1306 with the counting byte driver */
+static uint8_t page_buf[W];
+
+static unsigned long byte_cnt;
+static uint8_t xbm[32*32/8];
+static unsigned result_cnt;
+
+static uint8_t null_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_BYTE_SEND )
+    byte_cnt += arg_int;
+  return 1;
+}
+
+static uint8_t gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*==========================================*/
+/* the procedures, coordinates fit into the 64x128 display of R1 and R3 */
+
+static void op_clear_buffer(u8g2_t *u8g2)
+{
+  u8g2_ClearBuffer(u8g2);
+}
+
+static void op_draw_box(u8g2_t *u8g2)
+{
+  u8g2_DrawBox(u8g2, 10, 11, 44, 37);
+}
+
+static void op_draw_frame(u8g2_t *u8g2)
+{
+  u8g2_DrawFrame(u8g2, 10, 11, 44, 37);
+}
+
+static void op_draw_disc(u8g2_t *u8g2)
+{
+  u8g2_DrawDisc(u8g2, 32, 31, 20, U8G2_DRAW_ALL);
+}
+
+static void op_draw_xbm(u8g2_t *u8g2)
+{
+  u8g2_DrawXBM(u8g2, 13, 15, 32, 32, xbm);
+}
+
+static void op_draw_str(u8g2_t *u8g2)
+{
+  u8g2_DrawStr(u8g2, 2, 40, "Bluetooth 44.1k");
+}
+
+static void op_draw_utf8(u8g2_t *u8g2)
+{
+  u8g2_DrawUTF8(u8g2, 2, 40, "Gr\xc3\xbc\xc3\x9f" "e K\xc3\xbcnstler");
+}
+
+static void op_send_buffer(u8g2_t *u8g2)
+{
+  u8g2_SendBuffer(u8g2);
+}
+
+struct op
+{
+  const char *name;
+  void (*fn)(u8g2_t *u8g2);
+  uint8_t is_text;
+};
+
+static const struct op ops[] =
+{
+  { "ClearBuffer", op_clear_buffer, 0 },
+  { "DrawBox", op_draw_box, 0 },
+  { "DrawFrame", op_draw_frame, 0 },
+  { "DrawDisc", op_draw_disc, 0 },
+  { "DrawXBM", op_draw_xbm, 0 },
+  { "DrawStr", op_draw_str, 1 },
+  { "DrawUTF8", op_draw_utf8, 1 },
+};
+
+/*==========================================*/
+
+/* one call of the procedure: once in full buffer mode, once for each page in page mode */
+static void run(u8g2_t *u8g2, void (*fn)(u8g2_t *u8g2))
+{
+  uint8_t row, rows;
+
+  rows = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  if ( u8g2_GetBufferTileHeight(u8g2) == rows )
+  {
+    fn(u8g2);
+    return;
+  }
+  for( row = 0; row < rows; row++ )
+  {
+    u8g2_SetBufferCurrTileRow(u8g2, row);
+    fn(u8g2);
+  }
+}
+
+static double bench(u8g2_t *u8g2, void (*fn)(u8g2_t *u8g2))
+{
+  double ns;
+  BENCH_CALIBRATED_NS(ns, ROUNDS, ROUND_NS, 10000, run(u8g2, fn));
+  return ns;
+}
+
+static void print_result(const char *op, const char *font_name, const char *mode, const char *rotation, double ns)
+{
+  printf("%s    { \"op\": \"%s\", ", result_cnt > 0 ? ",\n" : "", op);
+  if ( font_name != NULL )
+    printf("\"font\": \"%s\", ", font_name);
+  printf("\"mode\": \"%s\", \"rotation\": \"%s\", \"ns_per_call\": %.1f", mode, rotation, ns);
+  result_cnt++;
+}
+
+static void setup(const struct rotation *r, uint8_t is_page_mode)
+{
+  u8g2_SetupBitmap(&u8g2, r->cb, W, H);
+  if ( is_page_mode )
+    u8g2_SetupBuffer(&u8g2, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, r->cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+
+  if ( is_page_mode )
+    u8g2_Setup_ssd1306_128x64_noname_1(&oled, r->cb, null_byte_cb, gpio_and_delay_cb);
+  else
+    u8g2_Setup_ssd1306_128x64_noname_f(&oled, r->cb, null_byte_cb, gpio_and_delay_cb);
+  u8g2_InitDisplay(&oled);
+  u8g2_SetPowerSave(&oled, 0);
+}
+
+static void bench_config(const struct rotation *r, uint8_t is_page_mode)
+{
+  const char *mode = is_page_mode ? "page" : "full";
+  unsigned o, f;
+  unsigned long bytes;
+  double ns;
+
+  setup(r, is_page_mode);
+  for( o = 0; o < sizeof(ops)/sizeof(*ops); o++ )
+  {
+    if ( ops[o].is_text == 0 )
+    {
+      print_result(ops[o].name, NULL, mode, r->name, bench(&u8g2, ops[o].fn));
+      printf(" }");
+      continue;
+    }
+    for( f = 0; f < sizeof(fonts)/sizeof(*fonts); f++ )
+    {
+      u8g2_SetFont(&u8g2, fonts[f].font);
+      print_result(ops[o].name, fonts[f].name, mode, r->name, bench(&u8g2, ops[o].fn));
+      printf(" }");
+    }
+  }
+
+  byte_cnt = 0;
+  run(&oled, op_send_buffer);
+  bytes = byte_cnt;
+  ns = bench(&oled, op_send_buffer);
+  print_result("SendBuffer", NULL, mode, r->name, ns);
+  printf(", \"bytes_per_call\": %lu }", bytes);
+}
+
+int main(void)
+{
+  unsigned r, i;
+
+  for( i = 0; i < sizeof(xbm); i++ )
+    xbm[i] = i * 37 + 11;
+
+  printf("{\n");
+  printf("  \"version\": \"%s\",\n", PERF_BENCH_VERSION);
+  printf("  \"display\": \"%ux%u\",\n", W, H);
+  printf("  \"u8g2_uint_bits\": %u,\n", (unsigned)sizeof(u8g2_uint_t)*8);
+  printf("  \"rounds\": %u,\n", ROUNDS);
+  printf("  \"results\": [\n");
+  for( r = 0; r < sizeof(rotations)/sizeof(*rotations); r++ )
+  {
+    bench_config(rotations+r, 0);
+    bench_config(rotations+r, 1);
+  }
+  printf("\n  ]\n}\n");
+  return 0;
+}
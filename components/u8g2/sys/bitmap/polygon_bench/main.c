@@ -0,0 +1,445 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Checks and benchmarks u8g2_FillPolygon and u8g2_DrawTriangle on the
+ * Bitmap device (128x64, vertical top memory layout as used by the SSD1306).
+ *
+ * 1. Random polygons with up to 16 points, partly outside of the display,
+ *    self intersecting, with clip window and draw colors 0/1/2, are
+ *    compared with a pixel by pixel even-odd reference. Each polygon is
+ *    drawn with U8G2_R0 (tile row spans), U8G2_R2 (u8g2_DrawHVLine) and
+ *    U8G2_R0 into a one tile row page buffer.
+ * 2. Random triangles and convex polygons with up to 6 points must give
+ *    the same buffer as the previous algorithm (polygon_ref.c).
+ * 3. Time per call for typical shapes, previous and new algorithm.
+ */
+
+#define W 128
+#define H 64
+
+void ref_ClearPolygonXY(void);
+void ref_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
+void ref_DrawPolygon(u8g2_t *u8g2);
+void ref_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
+u8g2_t u8g2;
+u8g2_t u8g2_page;
+uint8_t page_buf[W];
+
+struct scene
+{
+  int16_t x[16], y[16];
+  uint8_t cnt;
+  uint8_t color;
+  uint8_t is_triangle;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+};
+
+static uint8_t expect[H][W];
+static uint8_t frame[H][W];
+
+static uint8_t background(int x, int y)
+{
+  return (x*7 + y*3) % 5 == 0;
+}
+
+/*==========================================*/
+/* even-odd reference */
+
+static int16_t ceil_div(int32_t a, int32_t b)
+{
+  if ( a >= 0 )
+    return (a + b - 1) / b;
+  return -((-a) / b);
+}
+
+static int cmp_int16(const void *a, const void *b)
+{
+  return *(const int16_t *)a - *(const int16_t *)b;
+}
+
+static void ref_fill(const struct scene *s)
+{
+  int16_t xs[16];
+  int x0, y0, x1, y1, cx0, cy0, cx1, cy1;
+  int x, y, i, n, k;
+  
+  cx0 = 0; cy0 = 0; cx1 = W; cy1 = H;
+  if ( s->is_clip )
+  {
+    cx0 = s->clip_x0; cy0 = s->clip_y0; 
+    if ( s->clip_x1 < cx1 ) cx1 = s->clip_x1;
+    if ( s->clip_y1 < cy1 ) cy1 = s->clip_y1;
+  }
+  
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+      expect[y][x] = background(x, y);
+  
+  for( y = cy0; y < cy1; y++ )
+  {
+    n = 0;
+    for( i = 0; i < s->cnt; i++ )
+    {
+      x0 = s->x[i]; y0 = s->y[i];
+      x1 = s->x[(i+1) % s->cnt]; y1 = s->y[(i+1) % s->cnt];
+      if ( y0 > y1 )
+      {
+	k = x0; x0 = x1; x1 = k;
+	k = y0; y0 = y1; y1 = k;
+      }
+      if ( y0 <= y && y < y1 )
+	xs[n++] = x0 + ceil_div((int32_t)(y-y0)*(x1-x0), y1-y0);
+    }
+    qsort(xs, n, sizeof(int16_t), cmp_int16);
+    for( i = 0; i+1 < n; i += 2 )
+      for( x = xs[i] < cx0 ? cx0 : xs[i]; x < xs[i+1] && x < cx1; x++ )
+	expect[y][x] = s->color == 2 ? expect[y][x] ^ 1 : s->color;
+  }
+}
+
+/*==========================================*/
+/* render with u8g2 */
+
+static void draw_scene(u8g2_t *u8g2, const struct scene *s)
+{
+  u8g2_pg_edge_t edge[16];
+  u8g2_polygon_t pg;
+  uint8_t i;
+  
+  u8g2_SetDrawColor(u8g2, s->color);
+  if ( s->is_clip )
+    u8g2_SetClipWindow(u8g2, s->clip_x0, s->clip_y0, s->clip_x1, s->clip_y1);
+  else
+    u8g2_SetMaxClipWindow(u8g2);
+  if ( s->is_triangle )
+  {
+    u8g2_DrawTriangle(u8g2, s->x[0], s->y[0], s->x[1], s->y[1], s->x[2], s->y[2]);
+    return;
+  }
+  u8g2_InitPolygon(&pg, edge, 16);
+  for( i = 0; i < s->cnt; i++ )
+    u8g2_AddPolygonPoint(&pg, s->x[i], s->y[i]);
+  u8g2_FillPolygon(u8g2, &pg);
+}
+
+/* buffer pixel at device position x, y */
+static uint8_t *buf_byte(uint8_t *buf, int x, int y, uint8_t *mask)
+{
+  *mask = 1 << (y & 7);
+  return buf + (y >> 3)*W + x;
+}
+
+/* is_r2: device position is W-1-x, H-1-y */
+static void render_full(const struct scene *s, uint8_t is_r2)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  uint8_t *p, mask;
+  int x, y, dx, dy;
+  
+  u8g2_SetDisplayRotation(&u8g2, is_r2 ? U8G2_R2 : U8G2_R0);
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+    {
+      dx = is_r2 ? W-1-x : x;
+      dy = is_r2 ? H-1-y : y;
+      p = buf_byte(buf, dx, dy, &mask);
+      *p = background(x, y) ? *p | mask : *p & ~mask;
+    }
+  draw_scene(&u8g2, s);
+  for( y = 0; y < H; y++ )
+    for( x = 0; x < W; x++ )
+    {
+      dx = is_r2 ? W-1-x : x;
+      dy = is_r2 ? H-1-y : y;
+      p = buf_byte(buf, dx, dy, &mask);
+      frame[y][x] = (*p & mask) != 0;
+    }
+}
+
+static void render_pages(const struct scene *s)
+{
+  uint8_t *p, mask;
+  int x, y, row;
+  
+  for( row = 0; row < H/8; row++ )
+  {
+    u8g2_SetBufferCurrTileRow(&u8g2_page, row);
+    for( y = 0; y < 8; y++ )
+      for( x = 0; x < W; x++ )
+      {
+	p = buf_byte(page_buf, x, y, &mask);
+	*p = background(x, row*8+y) ? *p | mask : *p & ~mask;
+      }
+    draw_scene(&u8g2_page, s);
+    for( y = 0; y < 8; y++ )
+      for( x = 0; x < W; x++ )
+      {
+	p = buf_byte(page_buf, x, y, &mask);
+	frame[row*8+y][x] = (*p & mask) != 0;
+      }
+  }
+}
+
+static int rnd(int lo, int hi)
+{
+  return lo + rand() % (hi - lo + 1);
+}
+
+static unsigned check_reference(void)
+{
+  struct scene s;
+  unsigned i, errors = 0, mode;
+  uint8_t j;
+  
+  for( i = 0; i < 30000; i++ )
+  {
+    s.is_triangle = (i % 4) == 0;
+    s.cnt = s.is_triangle ? 3 : rnd(3, 16);
+    for( j = 0; j < s.cnt; j++ )
+    {
+      if ( i % 3 == 0 )
+      {
+	/* far outside of the display */
+	s.x[j] = rnd(-300, 400);
+	s.y[j] = rnd(-300, 300);
+      }
+      else
+      {
+	s.x[j] = rnd(-20, W+20);
+	s.y[j] = rnd(-20, H+20);
+      }
+    }
+    s.color = rand() % 3;
+    s.is_clip = (i % 5) == 0;
+    s.clip_x0 = rnd(0, W-1); s.clip_x1 = rnd(s.clip_x0+1, W);
+    s.clip_y0 = rnd(0, H-1); s.clip_y1 = rnd(s.clip_y0+1, H);
+    ref_fill(&s);
+    for( mode = 0; mode < 3; mode++ )
+    {
+      if ( mode < 2 )
+	render_full(&s, mode);
+      else
+	render_pages(&s);
+      if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+      {
+	if ( errors < 5 )
+	  printf("difference: scene %u, mode %u\n", i, mode);
+	errors++;
+      }
+    }
+  }
+  u8g2_SetDisplayRotation(&u8g2, U8G2_R0);
+  u8g2_SetMaxClipWindow(&u8g2);
+  printf("even-odd reference: %u differences\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* compare with the previous algorithm */
+
+static int16_t hx[16], hy[16];
+
+static long cross(int o, int a, int b)
+{
+  return (long)(hx[a]-hx[o])*(hy[b]-hy[o]) - (long)(hy[a]-hy[o])*(hx[b]-hx[o]);
+}
+
+static int cmp_point(const void *a, const void *b)
+{
+  int i = *(const int *)a, j = *(const int *)b;
+  if ( hx[i] != hx[j] )
+    return hx[i] - hx[j];
+  return hy[i] - hy[j];
+}
+
+/* strictly convex hull of n random points, at most 6 points */
+static uint8_t convex_polygon(int16_t *x, int16_t *y, int n)
+{
+  int idx[16], hull[32];
+  int i, k = 0, t;
+  
+  for( i = 0; i < n; i++ )
+  {
+    hx[i] = rnd(0, W);
+    hy[i] = rnd(0, H-1);
+    idx[i] = i;
+  }
+  qsort(idx, n, sizeof(int), cmp_point);
+  for( i = 0; i < n; i++ )
+  {
+    while( k >= 2 && cross(hull[k-2], hull[k-1], idx[i]) <= 0 )
+      k--;
+    hull[k++] = idx[i];
+  }
+  for( i = n-2, t = k+1; i >= 0; i-- )
+  {
+    while( k >= t && cross(hull[k-2], hull[k-1], idx[i]) <= 0 )
+      k--;
+    hull[k++] = idx[i];
+  }
+  k--;
+  if ( k > 6 )
+    k = 6;	/* any 6 points of a convex polygon are convex */
+  for( i = 0; i < k; i++ )
+  {
+    x[i] = hx[hull[i]];
+    y[i] = hy[hull[i]];
+  }
+  return k;
+}
+
+static unsigned check_previous(void)
+{
+  static uint8_t ref_buf[W*H/8];
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  int16_t x[6], y[6];
+  unsigned i, errors = 0;
+  uint8_t j, cnt;
+  u8g2_pg_edge_t edge[6];
+  u8g2_polygon_t pg;
+  
+  for( i = 0; i < 200000; i++ )
+  {
+    u8g2_SetDrawColor(&u8g2, rand() % 3);
+    if ( i & 1 )
+    {
+      for( j = 0; j < 3; j++ )
+      {
+	x[j] = rnd(0, W);
+	y[j] = rnd(0, H-1);
+      }
+      memset(buf, 0x5a, sizeof(ref_buf));
+      ref_DrawTriangle(&u8g2, x[0], y[0], x[1], y[1], x[2], y[2]);
+      memcpy(ref_buf, buf, sizeof(ref_buf));
+      memset(buf, 0x5a, sizeof(ref_buf));
+      u8g2_DrawTriangle(&u8g2, x[0], y[0], x[1], y[1], x[2], y[2]);
+    }
+    else
+    {
+      cnt = convex_polygon(x, y, rnd(3, 16));
+      if ( cnt < 3 )
+	continue;
+      if ( rand() & 1 )
+      {
+	/* other orientation */
+	for( j = 0; j < cnt/2; j++ )
+	{
+	  int16_t t;
+	  t = x[j]; x[j] = x[cnt-1-j]; x[cnt-1-j] = t;
+	  t = y[j]; y[j] = y[cnt-1-j]; y[cnt-1-j] = t;
+	}
+      }
+      memset(buf, 0x5a, sizeof(ref_buf));
+      ref_ClearPolygonXY();
+      for( j = 0; j < cnt; j++ )
+	ref_AddPolygonXY(&u8g2, x[j], y[j]);
+      ref_DrawPolygon(&u8g2);
+      memcpy(ref_buf, buf, sizeof(ref_buf));
+      memset(buf, 0x5a, sizeof(ref_buf));
+      u8g2_InitPolygon(&pg, edge, 6);
+      for( j = 0; j < cnt; j++ )
+	u8g2_AddPolygonPoint(&pg, x[j], y[j]);
+      u8g2_FillPolygon(&u8g2, &pg);
+    }
+    if ( memcmp(ref_buf, buf, sizeof(ref_buf)) != 0 )
+    {
+      if ( errors < 5 )
+	printf("difference to previous algorithm: %u\n", i);
+      errors++;
+    }
+  }
+  printf("previous algorithm: %u differences\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+struct bench
+{
+  const char *name;
+  uint8_t cnt;
+  int16_t x[24], y[24];
+};
+
+static const struct bench benches[] =
+{
+  { "triangle 12x10", 3, { 40, 52, 44 }, { 20, 24, 30 } },
+  { "triangle 128x64", 3, { 0, 127, 30 }, { 0, 20, 63 } },
+  { "needle 3x60", 3, { 60, 63, 61 }, { 2, 2, 62 } },
+  { "hexagon 48x40", 6, { 52, 76, 88, 76, 52, 40 }, { 12, 12, 32, 52, 52, 32 } },
+  { "star 24 points", 24, 
+    { 64, 70, 86, 76, 98, 78, 84, 73, 64, 55, 44, 50, 30, 52, 42, 58, 64, 71, 88, 80, 100, 80, 68, 60 }, 
+    { 2, 18, 10, 26, 32, 38, 56, 44, 62, 44, 56, 38, 32, 26, 10, 18, 2, 20, 12, 28, 34, 40, 50, 40 } },
+};
+
+/* best of 100 rounds */
+static double bench_ns(const struct bench *b, uint8_t is_ref, unsigned n)
+{
+  u8g2_pg_edge_t edge[24];
+  u8g2_polygon_t pg;
+  double ns;
+  uint8_t j;
+  
+  u8g2_InitPolygon(&pg, edge, 24);
+  for( j = 0; j < b->cnt; j++ )
+    u8g2_AddPolygonPoint(&pg, b->x[j], b->y[j]);
+  if ( b->cnt == 3 )
+  {
+    if ( is_ref )
+      BENCH_NS(ns, 100, n, ref_DrawTriangle(&u8g2, b->x[0], b->y[0], b->x[1], b->y[1], b->x[2], b->y[2]));
+    else
+      BENCH_NS(ns, 100, n, u8g2_DrawTriangle(&u8g2, b->x[0], b->y[0], b->x[1], b->y[1], b->x[2], b->y[2]));
+  }
+  else if ( is_ref )
+  {
+    BENCH_NS(ns, 100, n, 
+      ref_ClearPolygonXY();
+      for( j = 0; j < b->cnt; j++ )
+	ref_AddPolygonXY(&u8g2, b->x[j], b->y[j]);
+      ref_DrawPolygon(&u8g2));
+  }
+  else
+  {
+    BENCH_NS(ns, 100, n, u8g2_FillPolygon(&u8g2, &pg));
+  }
+  return ns;
+}
+
+int main(void)
+{
+  const struct bench *b;
+  unsigned errors = 0;
+  
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, W, H);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_ClearBuffer(&u8g2);
+  
+  u8x8_SetupBitmap(u8g2_GetU8x8(&u8g2_page), W, H);
+  u8g2_SetupBuffer(&u8g2_page, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2_page));
+
+  errors += check_reference();
+  errors += check_previous();
+  
+  u8g2_SetDrawColor(&u8g2, 2);
+  printf("\n%-18s %12s %12s\n", "ns/call", "previous", "edge table");
+  for( b = benches; b < benches + sizeof(benches)/sizeof(*benches); b++ )
+  {
+    /* the previous algorithm is limited to 6 points */
+    if ( b->cnt <= 6 )
+      printf("%-18s %12.1f %12.1f\n", b->name, bench_ns(b, 1, 500), bench_ns(b, 0, 500));
+    else
+      printf("%-18s %12s %12.1f\n", b->name, "-", bench_ns(b, 0, 500));
+  }
+  
+  if ( errors != 0 )
+    return 1;
+  return 0;
+}
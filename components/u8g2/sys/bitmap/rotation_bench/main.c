@@ -0,0 +1,197 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Compares U8G2_R1, U8G2_R2, U8G2_R3 and U8G2_MIRROR (rotation while
+ * drawing) with U8G2_R1_FLUSH ... U8G2_MIRROR_FLUSH (rotation while the
+ * buffer is sent) on the Bitmap device (128x64, vertical top memory layout
+ * as used by the SSD1306).
+ * Checks that both give the same picture on the display, also in page
+ * buffer mode and with u8g2_SendFrameChanged(), then prints the time to
+ * draw a full frame and to draw and send it.
+ */
+
+extern const uint8_t u8g2_font_9x15_tr[];
+extern const uint8_t u8g2_font_helvB18_tr[];
+
+u8g2_t u8g2;
+
+static uint8_t page_buf[128];
+static uint8_t shadow_buf[1024];
+static uint8_t display[64][128];
+
+struct rotation
+{
+  const char *name;
+  const u8g2_cb_t *cb;
+  const u8g2_cb_t *flush_cb;
+};
+
+static const struct rotation rotations[] =
+{
+  { "R0", U8G2_R0, U8G2_R0 },
+  { "R1", U8G2_R1, U8G2_R1_FLUSH },
+  { "R2", U8G2_R2, U8G2_R2_FLUSH },
+  { "R3", U8G2_R3, U8G2_R3_FLUSH },
+  { "MIRROR", U8G2_MIRROR, U8G2_MIRROR_FLUSH },
+};
+
+/* a typical screen: title, menu with a selected entry, progress bar */
+static void draw_screen(void)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(&u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(&u8g2);
+  u8g2_uint_t i;
+  
+  u8g2_SetDrawColor(&u8g2, 1);
+  u8g2_SetFont(&u8g2, u8g2_font_helvB18_tr);
+  u8g2_DrawStr(&u8g2, 1, 20, "3:27");
+  u8g2_DrawHLine(&u8g2, 0, 23, w);
+  u8g2_SetFont(&u8g2, u8g2_font_9x15_tr);
+  for( i = 0; i < 3; i++ )
+    u8g2_DrawStr(&u8g2, 3, 36 + i*13, i == 0 ? "Play" : i == 1 ? "Menu" : "Exit");
+  u8g2_SetDrawColor(&u8g2, 2);
+  u8g2_DrawBox(&u8g2, 0, 38, w, 13);
+  u8g2_SetDrawColor(&u8g2, 1);
+  u8g2_DrawFrame(&u8g2, 2, h-7, w-4, 6);
+  u8g2_DrawBox(&u8g2, 4, h-5, (w-8)/3, 2);
+  u8g2_DrawCircle(&u8g2, w-12, 10, 7, U8G2_DRAW_ALL);
+  u8g2_DrawLine(&u8g2, w-12, 10, w-7, 5);
+}
+
+static void full_frame(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  draw_screen();
+  u8g2_SendBuffer(&u8g2);
+}
+
+static void page_frame(void)
+{
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    draw_screen();
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+static void changed_frame(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  draw_screen();
+  u8g2_SendFrameChanged(&u8g2, u8g2_GetBufferPtr(&u8g2));
+}
+
+/* u8g2 with the Bitmap device, page buffer mode if page is not 0 */
+static void setup(const u8g2_cb_t *cb, int page)
+{
+  u8g2_SetupBitmap(&u8g2, cb, 128, 64);
+  if ( page )
+    u8g2_SetupBuffer(&u8g2, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, cb);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+}
+
+static void clear_display(void)
+{
+  uint8_t zero[128] = { 0 };
+  uint8_t ty;
+  for( ty = 0; ty < 8; ty++ )
+    u8x8_DrawTile(u8g2_GetU8x8(&u8g2), 0, ty, 16, zero);
+}
+
+/* compare the display with the result of the last call to save_display() */
+static unsigned compare_display(int save)
+{
+  unsigned x, y, errors = 0;
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+    {
+      if ( save )
+	display[y][x] = u8x8_GetBitmapPixel(u8g2_GetU8x8(&u8g2), x, y);
+      else if ( display[y][x] != u8x8_GetBitmapPixel(u8g2_GetU8x8(&u8g2), x, y) )
+	errors++;
+    }
+  return errors;
+}
+
+static unsigned check_rotation(const struct rotation *r)
+{
+  unsigned errors;
+  
+  setup(r->cb, 0);
+  clear_display();
+  full_frame();
+  compare_display(1);
+  
+  setup(r->flush_cb, 0);
+  clear_display();
+  full_frame();
+  errors = compare_display(0);
+  
+  /* the shadow buffer has the layout of the display, the second call sends nothing */
+  clear_display();
+  u8g2_SetShadowBufferPtr(&u8g2, shadow_buf);
+  changed_frame();
+  errors += compare_display(0);
+  u8g2_DrawPixel(&u8g2, 10, 30);
+  if ( u8g2_SendFrameChanged(&u8g2, u8g2_GetBufferPtr(&u8g2)) != 1 )
+    errors++;
+  changed_frame();
+  errors += compare_display(0);
+  
+  /* U8G2_R1_FLUSH and U8G2_R3_FLUSH require full buffer mode */
+  if ( r->flush_cb != U8G2_R1_FLUSH && r->flush_cb != U8G2_R3_FLUSH )
+  {
+    setup(r->flush_cb, 1);
+    clear_display();
+    page_frame();
+    errors += compare_display(0);
+  }
+  printf("%-8s %u differences\n", r->name, errors);
+  return errors;
+}
+
+/* best of 5 rounds */
+static double bench(void (*frame)(void), unsigned n)
+{
+  double ns;
+  BENCH_NS(ns, 5, n, frame());
+  return ns;
+}
+
+static void draw_frame(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  draw_screen();
+}
+
+int main(void)
+{
+  const struct rotation *r;
+  unsigned errors = 0;
+  
+  for( r = rotations; r < rotations + sizeof(rotations)/sizeof(*rotations); r++ )
+    errors += check_rotation(r);
+  
+  printf("\n%-8s %12s %12s %12s %12s\n", "us/frame", "draw", "draw+send", "flush draw", "flush d+s");
+  for( r = rotations; r < rotations + sizeof(rotations)/sizeof(*rotations); r++ )
+  {
+    double d, ds, fd, fds;
+    setup(r->cb, 0);
+    d = bench(draw_frame, 2000);
+    ds = bench(full_frame, 2000);
+    setup(r->flush_cb, 0);
+    fd = bench(draw_frame, 2000);
+    fds = bench(full_frame, 2000);
+    printf("%-8s %12.2f %12.2f %12.2f %12.2f\n", r->name, d/1e3, ds/1e3, fd/1e3, fds/1e3);
+  }
+  
+  if ( errors != 0 )
+  {
+    printf("%u differences\n", errors);
+    return 1;
+  }
+  return 0;
+}
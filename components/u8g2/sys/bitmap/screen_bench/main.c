@@ -0,0 +1,430 @@
+#include "ui_stub.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "u8g2_esp32_hal.h"
+#include "app_events.h"
+#include "ui_controller.h"
+#include "ui_flush.h"
+
+/*
+ * Golden frames and frame cost of the screens of main/ui_controller.c.
+ *
+ * Drives the controller through its events (ui_controller_dispatch()) from
+ * start up to disconnect and draws each screen with ui_controller_refresh().
+ * The frame handed to ui_flush_submit() is written with u8g2_WriteBufferPBM()
+ * and compared with golden/<screen>.pbm, a differing frame is written to
+ * <screen>.actual.pbm. For each screen the harness reports:
+ *   - bytes sent over I2C by u8g2_SendFrameChanged(), after the previous screen
+ *   - render time of ui_controller_refresh() without sending, best of ROUNDS
+ *   - the render time relative to a calibration frame (calib_frame()), which
+ *     draws a similar screen with u8g2 into a separate buffer
+ *   - frames per minute without a model change, counted by following the
+ *     time until the next frame returned by ui_controller_refresh() for a
+ *     minute, "event" if the screen is only drawn again on a model change
+ *   - the render CPU time per second of the drawing task: with a frame
+ *     every OLD_FRAME_MS as the task did before it waited for changes, and
+ *     with the frames per minute of now. This is host time, an estimate of
+ *     the share on the target, the I2C transfer is not included.
+ * together with the delta to golden/screens.txt. golden/screens.txt keeps
+ * the bytes and the relative render time, which does not depend on the
+ * speed of the host as much as the time itself.
+ * "screen_bench -u" writes the golden frames and golden/screens.txt.
+ *
+ * Fonts are built from tools/font (see Makefile), the unifont is replaced
+ * by a font of the same size, the frames differ from the display in detail.
+ */
+
+#define ROUNDS 50
+#define ROUND_NS 2000000.0	/* refreshes in each round are chosen to take about this time */
+#define PBM_SIZE (16 + 64*129)
+#define MAX_SCREENS 32
+#define OLD_FRAME_MS 50	/* fixed frame period of the drawing task before the redraw on changes */
+
+#include "u8g2_font_unifont_t_symbols.c"
+#include "u8g2_font_osr21_tn.c"
+#include "u8g2_font_osr29_tn.c"
+
+volatile ui_rcvr_state_t rcvr_state = RCVR_STATE_INITIALISING;
+
+extern u8g2_t u8g2;	/* of ui_controller.c */
+
+struct result
+{
+  char name[32];
+  unsigned long bytes;
+  double ns;
+  double ratio;	/* ns / calib_ns */
+  long frames;	/* per minute without a model change, -1: only on a change */
+};
+
+static struct result golden[MAX_SCREENS];
+static unsigned golden_cnt;
+
+static uint8_t is_update;
+static uint8_t is_capture;	/* ui_flush_submit() captures and sends the frame */
+static unsigned long byte_cnt;
+static char pbm[PBM_SIZE];
+static size_t pbm_len;
+
+static unsigned errors;
+
+static u8g2_t calib_u8g2;
+static uint8_t calib_buf[1024];
+
+/*==========================================*/
+/* display HAL, counts the bytes of the I2C transfers */
+
+void u8g2_esp32_hal_init(u8g2_esp32_hal_t u8g2_esp32_hal_param)
+{
+}
+
+uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_INIT:
+      /* same transfer sizes as main/u8g2_esp32_hal.c */
+      u8x8_SetByteMaxTransfer(u8x8, I2C_MASTER_TRANSFER_BUF_SIZE);
+      u8x8_SetByteMaxLargeTransfer(u8x8, I2C_MASTER_LARGE_TRANSFER_SIZE);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      byte_cnt++;	/* address */
+      break;
+    case U8X8_MSG_BYTE_SEND:
+      byte_cnt += arg_int;
+      break;
+    case U8X8_MSG_BYTE_SEND_LARGE:
+      byte_cnt += ((u8x8_large_data_t *)arg_ptr)->cnt;
+      break;
+  }
+  return 0;
+}
+
+uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 0;
+}
+
+void u8g2_esp32_hal_wait_done(void)
+{
+}
+
+/*==========================================*/
+/* frame capture */
+
+static void pbm_out(const char *s)
+{
+  size_t len = strlen(s);
+  if ( pbm_len + len < sizeof(pbm) )
+  {
+    memcpy(pbm + pbm_len, s, len);
+    pbm_len += len;
+  }
+}
+
+bool ui_flush_submit(u8g2_t *u8g2)
+{
+  if ( is_capture )
+  {
+    pbm_len = 0;
+    u8g2_WriteBufferPBM(u8g2, pbm_out);
+    byte_cnt = 0;
+    u8g2_SendFrameChanged(u8g2, u8g2_GetBufferPtr(u8g2));
+  }
+  return true;
+}
+
+/* differing pixels, or -1 if the golden frame is missing */
+static long compare_golden(const char *name)
+{
+  static char ref[PBM_SIZE];
+  char path[64];
+  FILE *fp;
+  size_t len, i;
+  long diff = 0;
+
+  sprintf(path, "golden/%s.pbm", name);
+  if ( is_update )
+  {
+    fp = fopen(path, "w");
+    if ( fp == NULL || fwrite(pbm, 1, pbm_len, fp) != pbm_len )
+    {
+      printf("%s: can not write\n", path);
+      errors++;
+    }
+    if ( fp != NULL )
+      fclose(fp);
+    return 0;
+  }
+
+  fp = fopen(path, "r");
+  if ( fp == NULL )
+    return -1;
+  len = fread(ref, 1, sizeof(ref), fp);
+  fclose(fp);
+
+  if ( len != pbm_len )
+    diff = 128*64;
+  else
+    for( i = 0; i < len; i++ )
+      if ( ref[i] != pbm[i] )
+	diff++;
+  if ( diff != 0 )
+  {
+    sprintf(path, "%s.actual.pbm", name);
+    fp = fopen(path, "w");
+    if ( fp != NULL )
+    {
+      fwrite(pbm, 1, pbm_len, fp);
+      fclose(fp);
+    }
+  }
+  return diff;
+}
+
+/*==========================================*/
+/* calibration, a track screen drawn directly with u8g2 */
+
+static void calib_frame(void)
+{
+  u8g2_ClearBuffer(&calib_u8g2);
+  u8g2_SetFont(&calib_u8g2, u8g2_font_unifont_t_symbols);
+  u8g2_DrawStr(&calib_u8g2, 4, 14, "Miles Davis");
+  u8g2_DrawStr(&calib_u8g2, 4, 30, "So What");
+  u8g2_DrawStr(&calib_u8g2, 4, 46, "Kind of Blue");
+  u8g2_DrawFrame(&calib_u8g2, 0, 54, 128, 10);
+  u8g2_DrawBox(&calib_u8g2, 2, 56, 30, 6);
+}
+
+static void calib_setup(void)
+{
+  u8g2_SetupDisplay(&calib_u8g2, u8x8_d_ssd1306_128x64_noname, u8x8_cad_empty, u8x8_byte_empty, u8x8_dummy_cb);
+  u8g2_SetupBuffer(&calib_u8g2, calib_buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+}
+
+/*==========================================*/
+/* golden/screens.txt: name, bytes, render time / calibration time */
+
+static void read_golden_results(void)
+{
+  FILE *fp = fopen("golden/screens.txt", "r");
+  struct result *r;
+
+  if ( fp == NULL )
+    return;
+  while( golden_cnt < MAX_SCREENS )
+  {
+    r = golden + golden_cnt;
+    if ( fscanf(fp, "%31s %lu %lf", r->name, &r->bytes, &r->ratio) != 3 )
+      break;
+    golden_cnt++;
+  }
+  fclose(fp);
+}
+
+static const struct result *find_golden_result(const char *name)
+{
+  unsigned i;
+  for( i = 0; i < golden_cnt; i++ )
+    if ( strcmp(golden[i].name, name) == 0 )
+      return golden + i;
+  return NULL;
+}
+
+/*==========================================*/
+/* screens */
+
+static struct result results[MAX_SCREENS];
+static unsigned result_cnt;
+
+static void send_event(ui_evt_t event, const char *text, uint32_t value)
+{
+  esp_ui_param_t param;
+  ui_msg_t msg;
+
+  memset(&param, 0, sizeof(param));
+  if ( text != NULL )
+  {
+    param.text_rsp.evt_text = (uint8_t *)text;
+    param.text_rsp.evt_text_length = strlen(text);
+  }
+  else
+  {
+    param.int_rsp.evt_value = value;
+  }
+  msg.sig = 0;
+  msg.event = event;
+  msg.param = &param;
+  ui_controller_dispatch(&msg);
+}
+
+static void advance_ms(uint32_t ms)
+{
+  stub_ticks += pdMS_TO_TICKS(ms);
+}
+
+/* the calibration frame is timed along with each screen, the speed of the host may change */
+static double render_ns(double *calib_ns)
+{
+  double ns;
+  BENCH_CALIBRATED_NS(*calib_ns, ROUNDS, ROUND_NS, 1000, calib_frame());
+  BENCH_CALIBRATED_NS(ns, ROUNDS, ROUND_NS, 1000, ui_controller_refresh());
+  return ns;
+}
+
+/* frames in a minute without a model change, the time is set back afterwards */
+static long frames_per_minute(void)
+{
+  TickType_t start = stub_ticks, next;
+  long frames = 0;
+
+  next = ui_controller_refresh();
+  if ( next == portMAX_DELAY )
+    return -1;
+  while( stub_ticks + next - start <= pdMS_TO_TICKS(60000) )
+  {
+    stub_ticks += next;
+    next = ui_controller_refresh();
+    frames++;
+    if ( next == portMAX_DELAY )
+      break;
+  }
+  stub_ticks = start;
+  return frames;
+}
+
+static void screen(const char *name)
+{
+  struct result *r = results + result_cnt;
+  const struct result *g = find_golden_result(name);
+  long diff;
+  char pixels[32];
+  double calib_ns;
+
+  is_capture = 1;
+  ui_controller_refresh();
+  is_capture = 0;
+
+  strcpy(r->name, name);
+  r->bytes = byte_cnt;
+  r->ns = render_ns(&calib_ns);
+  r->ratio = r->ns / calib_ns;
+  r->frames = frames_per_minute();
+  result_cnt++;
+
+  diff = compare_golden(name);
+  if ( diff < 0 )
+    strcpy(pixels, "no golden");
+  else if ( diff > 0 )
+    sprintf(pixels, "%ld differ", diff);
+  else
+    strcpy(pixels, "ok");
+  if ( diff != 0 )
+    errors++;
+
+  printf("%-22s %-10s %6lu", name, pixels, r->bytes);
+  if ( g != NULL && !is_update )
+    printf(" %+6ld", (long)r->bytes - (long)g->bytes);
+  else
+    printf(" %6s", "-");
+  printf(" %10.1f %7.2f", r->ns / 1e3, r->ratio);
+  if ( g != NULL && !is_update )
+    printf(" %+7.1f%%", (r->ratio - g->ratio) * 100.0 / g->ratio);
+  else
+    printf(" %8s", "-");
+  if ( r->frames < 0 )
+    printf(" %8s", "event");
+  else
+    printf(" %8ld", r->frames);
+  printf(" %10.1f", r->ns / 1e3 * 1000 / OLD_FRAME_MS);
+  if ( r->frames < 0 )
+    printf(" %10s", "-");
+  else
+    printf(" %10.1f", r->ns / 1e3 * r->frames / 60);
+  printf("\n");
+}
+
+static void write_golden_results(void)
+{
+  FILE *fp = fopen("golden/screens.txt", "w");
+  unsigned i;
+
+  if ( fp == NULL )
+  {
+    printf("golden/screens.txt: can not write\n");
+    errors++;
+    return;
+  }
+  for( i = 0; i < result_cnt; i++ )
+    fprintf(fp, "%s %lu %.3f\n", results[i].name, results[i].bytes, results[i].ratio);
+  fclose(fp);
+}
+
+int main(int argc, char **argv)
+{
+  if ( argc > 1 && strcmp(argv[1], "-u") == 0 )
+    is_update = 1;
+  read_golden_results();
+
+  ui_controller_init();
+  calib_setup();
+
+  printf("%-22s %-10s %6s %6s %10s %7s %8s %8s %21s\n", "", "", "", "", "", "", "", "frames", "draw CPU us/s");
+  printf("%-22s %-10s %6s %6s %10s %7s %8s %8s %10s %10s\n", "screen", "pixels", "bytes", "delta", "render us", "x calib", "delta", "per min", "50 ms", "now");
+
+  screen("about");
+
+  send_event(UI_EVT_NON_DISCOVERABLE, "Grotsoft Receiver", 0);
+  screen("disconnected");
+
+  send_event(UI_EVT_DISCOVERABLE, "", 0);
+  screen("discoverable");
+  advance_ms(CONFIG_DISCOVERY_MODE_DURATION * 1000 / 2);
+  screen("discoverable_half");
+
+  send_event(UI_EVT_PAIRING_AUTH, "482916", 0);
+  screen("pairing");
+  send_event(UI_EVT_PAIRED_FAIL, NULL, 0);
+  screen("pairing_failed");
+  send_event(UI_EVT_PAIRING_AUTH, "482916", 0);
+  send_event(UI_EVT_PAIRED_OK, NULL, 0);
+  screen("paired");
+
+  send_event(UI_EVT_CONNECTED, "Pixel 7", 0);
+  screen("connected");
+
+  send_event(UI_EVT_TRK_STARTED, NULL, 0);
+  screen("playing");
+  send_event(UI_EVT_TRK_ARTIST, "Miles Davis", 0);
+  send_event(UI_EVT_TRK_TITLE, "So What", 0);
+  send_event(UI_EVT_TRK_ALBUM, "Kind of Blue", 0);
+  send_event(UI_EVT_TRK_PLAYINGTIME, NULL, 545000);
+  send_event(UI_EVT_TRK_POS_CHANGED, NULL, 136000);
+  screen("track");
+
+  /* scrolling lines, at the start and while scrolling */
+  send_event(UI_EVT_TRK_ARTIST, "Keith Jarrett", 0);
+  send_event(UI_EVT_TRK_TITLE, "Part II c (Live at the Opera House, Cologne)", 0);
+  send_event(UI_EVT_TRK_ALBUM, "The Koln Concert", 0);
+  send_event(UI_EVT_TRK_POS_CHANGED, NULL, 60000);
+  screen("track_long");
+  advance_ms(2500);
+  screen("track_long_2500ms");
+  advance_ms(40);
+  screen("track_long_2540ms");
+
+  send_event(UI_EVT_TRK_STOPPED, NULL, 0);
+  screen("stopped");
+  send_event(UI_EVT_DISCONNECTED, NULL, 0);
+  screen("disconnected_again");
+
+  if ( is_update )
+    write_golden_results();
+  else if ( golden_cnt == 0 )
+    printf("no golden/screens.txt, use -u to create it\n");
+
+  printf("%u errors\n", errors);
+  return errors != 0;
+}
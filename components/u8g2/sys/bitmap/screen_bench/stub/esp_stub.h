@@ -0,0 +1,64 @@
+/*
+ * Minimal ESP-IDF and FreeRTOS declarations to build main/ui_controller.c
+ * and main/ui_scroll.c on the host. The tick count and the app description
+ * are set by the harness, see ui_stub.c.
+ */
+#ifndef ESP_STUB_H
+#define ESP_STUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+/* the arguments are checked by the compiler like printf(), nothing is printed */
+#define ESP_LOG_DISCARD(tag, ...) do { (void)(tag); if ( 0 ) printf(__VA_ARGS__); } while(0)
+#define ESP_LOGE(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+
+/* FreeRTOS, single task, critical sections do nothing */
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+#define pdFALSE 0
+#define pdTRUE 1
+#define portMAX_DELAY ((TickType_t)0xffffffff)
+#define portTICK_PERIOD_MS (1000 / CONFIG_FREERTOS_HZ)
+#define portTICK_RATE_MS portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms) ((TickType_t)((uint64_t)(ms) * CONFIG_FREERTOS_HZ / 1000))
+#define configMAX_PRIORITIES 25
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) do { (void)(mux); } while(0)
+#define portEXIT_CRITICAL(mux) do { (void)(mux); } while(0)
+
+TickType_t xTaskGetTickCount(void);
+
+typedef void *TimerHandle_t;
+typedef TimerHandle_t xTimerHandle;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t timer);
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, BaseType_t auto_reload, void *id, TimerCallbackFunction_t cb);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks_to_wait);
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks_to_wait);
+
+/* esp_ota_ops.h */
+typedef struct {
+  char version[32];
+  char project_name[32];
+} esp_app_desc_t;
+const esp_app_desc_t *esp_ota_get_app_description(void);
+
+/* driver/gpio.h, the HAL header only needs the pin type */
+typedef int gpio_num_t;
+#define I2C_NUM_1 1
+
+/* part of newlib on the ESP32 */
+size_t strlcpy(char *dst, const char *src, size_t size);
+
+#endif
@@ -0,0 +1,6 @@
+/* as in the sdkconfig of the project, the defaults of main/Kconfig.projbuild */
+#define CONFIG_FREERTOS_HZ 100
+#define CONFIG_DISCOVERY_MODE_DURATION 60
+#define CONFIG_DISPLAY_I2C_SCL_GPIO 23
+#define CONFIG_DISPLAY_I2C_SDA_GPIO 21
+#define CONFIG_DISPLAY_I2C_ADDRESS 0x78
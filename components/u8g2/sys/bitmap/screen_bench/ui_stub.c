@@ -0,0 +1,71 @@
+#include "ui_stub.h"
+#include <string.h>
+#include "bt_app_core.h"
+#include "app_events.h"
+#include "ui_task.h"
+
+/*
+ * The ESP-IDF, FreeRTOS and application functions used by
+ * main/ui_controller.c. Time only moves when the harness says so.
+ */
+
+TickType_t stub_ticks;
+unsigned stub_timers;	/* timers created and not deleted */
+
+TickType_t xTaskGetTickCount(void)
+{
+  return stub_ticks;
+}
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, BaseType_t auto_reload, void *id, TimerCallbackFunction_t cb)
+{
+  stub_timers++;
+  return (TimerHandle_t)&stub_timers;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+  return pdTRUE;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+  stub_timers--;
+  return pdTRUE;
+}
+
+const esp_app_desc_t *esp_ota_get_app_description(void)
+{
+  static const esp_app_desc_t desc = { "1.2.3", "receiver" };
+  return &desc;
+}
+
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  size_t len = strlen(src);
+
+  if ( size > 0 )
+  {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+bool bt_app_work_dispatch(bt_app_cb_t p_cback, uint16_t event, void *p_params, int param_len, bt_app_copy_cb_t p_copy_cback)
+{
+  return true;
+}
+
+void bt_av_hdl_stack_evt(uint16_t event, void *p_param)
+{
+}
+
+void ui_task_request_redraw(void)
+{
+}
+
+void ui_flush_start_up(u8g2_t *u8g2)
+{
+}
@@ -0,0 +1,11 @@
+#ifndef UI_STUB_H
+#define UI_STUB_H
+
+#include "esp_stub.h"
+#include "u8g2.h"
+
+/* current time of xTaskGetTickCount() */
+extern TickType_t stub_ticks;
+extern unsigned stub_timers;
+
+#endif
@@ -0,0 +1,130 @@
+#include "u8g2_esp32_hal.h"
+#include "spi_stub.h"
+#include "ssd1306_model.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Frame time of the SPI transport in main/u8g2_esp32_hal.c against the
+ * simulated SPI master in spi_stub.c (SSD1306 128x64, 4-wire SPI).
+ * Compares the former blocking byte callback (one spi_device_transmit()
+ * per U8X8_MSG_BYTE_SEND, 10 kHz) with the queued DMA transport and
+ * checks with a model of the SSD1306 RAM (common/ssd1306_model.c) that all
+ * variants show the frame.
+ * Times are simulated, see spi_stub.c for the cost of a transaction.
+ */
+
+#define PIN_CLK 18
+#define PIN_MOSI 23
+#define PIN_CS 5
+#define PIN_DC 17
+#define PIN_RESET 16
+
+/*==========================================*/
+/* the byte callback before the queued transport */
+
+static spi_device_handle_t legacy_handle;
+static int legacy_clock_hz;
+
+static uint8_t legacy_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SET_DC:
+      gpio_set_level(PIN_DC, arg_int);
+      break;
+    case U8X8_MSG_BYTE_INIT:
+    {
+      spi_bus_config_t bus_config;
+      spi_device_interface_config_t dev_config;
+      memset(&bus_config, 0, sizeof(bus_config));
+      memset(&dev_config, 0, sizeof(dev_config));
+      ESP_ERROR_CHECK(spi_bus_initialize(HSPI_HOST, &bus_config, 1));
+      dev_config.clock_speed_hz = legacy_clock_hz;
+      dev_config.spics_io_num = PIN_CS;
+      dev_config.queue_size = 200;
+      ESP_ERROR_CHECK(spi_bus_add_device(HSPI_HOST, &dev_config, &legacy_handle));
+      break;
+    }
+    case U8X8_MSG_BYTE_SEND:
+    {
+      spi_transaction_t trans_desc;
+      memset(&trans_desc, 0, sizeof(trans_desc));
+      trans_desc.length = 8 * arg_int;
+      trans_desc.tx_buffer = arg_ptr;
+      ESP_ERROR_CHECK(spi_device_transmit(legacy_handle, &trans_desc));
+      break;
+    }
+  }
+  return 0;
+}
+
+/*==========================================*/
+
+static u8g2_t u8g2;
+
+static void setup(u8x8_msg_cb byte_cb, int clock_hz)
+{
+  u8g2_esp32_hal_t hal = U8G2_ESP32_HAL_DEFAULT;
+  hal.clk = PIN_CLK;
+  hal.mosi = PIN_MOSI;
+  hal.cs = PIN_CS;
+  hal.dc = PIN_DC;
+  hal.reset = PIN_RESET;
+  hal.spi_clock_hz = clock_hz;
+  u8g2_esp32_hal_init(hal);
+  legacy_clock_hz = clock_hz;
+  spi_stub_reset(PIN_DC);
+  ssd1306_model_reset();
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, byte_cb, u8g2_esp32_gpio_and_delay_cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_esp32_hal_wait_done();
+}
+
+static unsigned frame(const char *name)
+{
+  double submitted_ns, blocked_ns, done_ns;
+  unsigned i, errors = 0;
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+  
+  for( i = 0; i < 1024; i++ )
+    buf[i] = i * 37 + 11;
+  memset(ssd1306_ram, 0, sizeof(ssd1306_ram));
+  spi_stub_reset(PIN_DC);
+  u8g2_SendBuffer(&u8g2);
+  submitted_ns = spi_stub.cpu_ns;
+  blocked_ns = spi_stub.blocked_ns;
+  /* the frame buffer may now be drawn again */
+  memset(buf, 0, 1024);
+  u8g2_esp32_hal_wait_done();
+  done_ns = spi_stub_bus_free_ns();
+  for( i = 0; i < 1024; i++ )
+    if ( ssd1306_ram[i/128][i%128] != (uint8_t)(i * 37 + 11) )
+      errors++;
+  printf("%-30s %6u %6u %12.1f %12.1f %12.1f %s\n", name, spi_stub.transactions, spi_stub.bytes,
+    submitted_ns/1e3, blocked_ns/1e3, done_ns/1e3, errors ? "WRONG" : "ok");
+  return errors;
+}
+
+int main(void)
+{
+  unsigned errors = 0;
+  
+  printf("%-30s %6s %6s %12s %12s %12s\n", "SendBuffer 128x64", "trans", "bytes", "returns us", "blocked us", "on display us");
+  
+  setup(legacy_spi_byte_cb, 10000);
+  errors += frame("blocking, 10 kHz (before)");
+  setup(legacy_spi_byte_cb, 8000000);
+  errors += frame("blocking, 8 MHz");
+  
+  setup(u8g2_esp32_spi_byte_cb, 8000000);
+  u8x8_SetByteMaxLargeTransfer(u8g2_GetU8x8(&u8g2), 0);
+  errors += frame("queued, 8 MHz, tile rows");
+  setup(u8g2_esp32_spi_byte_cb, 8000000);
+  errors += frame("queued, 8 MHz, one transfer");
+  setup(u8g2_esp32_spi_byte_cb, 0);
+  errors += frame("queued, display clock");
+  
+  return errors != 0;
+}
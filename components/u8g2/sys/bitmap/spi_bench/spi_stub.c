@@ -0,0 +1,144 @@
+#include "esp_stub.h"
+#include "spi_stub.h"
+#include "ssd1306_model.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Simulated ESP32 SPI master. Time is counted in ns of CPU time (the
+ * calling task) and bus time. A transaction occupies the bus for its bits
+ * at the device clock plus SPI_STUB_TRANS_NS (interrupt, pre_cb, DMA and
+ * CS setup). Queueing costs the CPU SPI_STUB_QUEUE_NS, blocking calls wait
+ * until the bus has finished the transaction.
+ * Received bytes go to the SSD1306 model with the level of the DC GPIO.
+ */
+
+#define SPI_STUB_QUEUE_NS 4000
+#define SPI_STUB_TRANS_NS 6000
+#define SPI_STUB_MAX_QUEUE 256
+
+struct spi_device_t
+{
+  int clock_speed_hz;
+  int queue_size;
+  transaction_cb_t pre_cb;
+};
+
+static struct spi_device_t device;
+static spi_transaction_t *queue[SPI_STUB_MAX_QUEUE];
+static double queue_end_ns[SPI_STUB_MAX_QUEUE];
+static unsigned queue_head, queue_cnt;
+static double bus_free_ns;
+static int dc_gpio = -1, dc_level;
+
+spi_stub_stat_t spi_stub;
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+  return malloc(size);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+}
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  if ( gpio_num == dc_gpio )
+    dc_level = level;
+  return ESP_OK;
+}
+
+void spi_stub_reset(int dc)
+{
+  memset(&spi_stub, 0, sizeof(spi_stub));
+  queue_cnt = 0;
+  bus_free_ns = 0;
+  dc_gpio = dc;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan)
+{
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle)
+{
+  device.clock_speed_hz = dev_config->clock_speed_hz;
+  device.queue_size = dev_config->queue_size;
+  device.pre_cb = dev_config->pre_cb;
+  assert(device.queue_size <= SPI_STUB_MAX_QUEUE);
+  *handle = &device;
+  return ESP_OK;
+}
+
+static void spi_stub_wait_oldest(void)
+{
+  if ( spi_stub.cpu_ns < queue_end_ns[queue_head] )
+  {
+    spi_stub.blocked_ns += queue_end_ns[queue_head] - spi_stub.cpu_ns;
+    spi_stub.cpu_ns = queue_end_ns[queue_head];
+  }
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t ticks_to_wait)
+{
+  const uint8_t *data = trans->tx_buffer;
+  size_t i;
+  double start;
+  
+  assert(queue_cnt <= (unsigned)handle->queue_size);
+  if ( queue_cnt == (unsigned)handle->queue_size )
+    return ESP_ERR_TIMEOUT;	/* the HAL must fetch results first */
+  
+  spi_stub.cpu_ns += SPI_STUB_QUEUE_NS;
+  start = spi_stub.cpu_ns > bus_free_ns ? spi_stub.cpu_ns : bus_free_ns;
+  bus_free_ns = start + SPI_STUB_TRANS_NS + trans->length * 1e9 / handle->clock_speed_hz;
+  queue[(queue_head + queue_cnt) % SPI_STUB_MAX_QUEUE] = trans;
+  queue_end_ns[(queue_head + queue_cnt) % SPI_STUB_MAX_QUEUE] = bus_free_ns;
+  queue_cnt++;
+  
+  /* the data is sampled now, a HAL which changes it before the transaction is done is wrong anyway */
+  if ( handle->pre_cb != NULL )
+    handle->pre_cb(trans);
+  for( i = 0; i < trans->length / 8; i++ )
+    ssd1306_model_byte(dc_level, data[i]);
+  spi_stub.transactions++;
+  spi_stub.bytes += trans->length / 8;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t ticks_to_wait)
+{
+  if ( queue_cnt == 0 )
+    return ESP_ERR_TIMEOUT;
+  if ( ticks_to_wait == 0 && queue_end_ns[queue_head] > spi_stub.cpu_ns )
+    return ESP_ERR_TIMEOUT;
+  spi_stub_wait_oldest();
+  *trans = queue[queue_head];
+  queue_head = (queue_head + 1) % SPI_STUB_MAX_QUEUE;
+  queue_cnt--;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+  spi_transaction_t *done;
+  esp_err_t rc;
+  while( queue_cnt > 0 )
+    spi_device_get_trans_result(handle, &done, portMAX_DELAY);
+  rc = spi_device_queue_trans(handle, trans, portMAX_DELAY);
+  if ( rc != ESP_OK )
+    return rc;
+  return spi_device_get_trans_result(handle, &done, portMAX_DELAY);
+}
+
+double spi_stub_bus_free_ns(void)
+{
+  return bus_free_ns;
+}
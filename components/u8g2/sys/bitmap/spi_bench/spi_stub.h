@@ -0,0 +1,19 @@
+#ifndef SPI_STUB_H
+#define SPI_STUB_H
+
+typedef struct
+{
+  double cpu_ns;	/* simulated time of the calling task */
+  double blocked_ns;	/* part of cpu_ns spent waiting for the bus */
+  unsigned transactions;
+  unsigned bytes;
+} spi_stub_stat_t;
+
+extern spi_stub_stat_t spi_stub;
+
+/* dc: GPIO number of the DC line */
+void spi_stub_reset(int dc);
+/* simulated time when the last queued transaction is done */
+double spi_stub_bus_free_ns(void);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Minimal ESP-IDF declarations to build main/u8g2_esp32_hal.c on the host.
+ * The SPI master is simulated in spi_stub.c, GPIO and I2C do nothing.
+ */
+#ifndef ESP_STUB_H
+#define ESP_STUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <assert.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_TIMEOUT 0x107
+
+/* the arguments are checked by the compiler like printf(), nothing is printed */
+#define ESP_LOG_DISCARD(tag, ...) do { (void)(tag); if ( 0 ) printf(__VA_ARGS__); } while(0)
+#define ESP_LOGE(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ESP_LOG_DISCARD(tag, __VA_ARGS__)
+#define ESP_LOG_BUFFER_HEXDUMP(tag, buf, len, level) do { (void)(tag); } while(0)
+#define ESP_ERROR_CHECK(x) do { esp_err_t rc = (x); assert(rc == ESP_OK); } while(0)
+
+#define IRAM_ATTR
+#define MALLOC_CAP_DMA 8
+void *heap_caps_malloc(size_t size, uint32_t caps);
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ((TickType_t)0xffffffff)
+#define portTICK_RATE_MS 1
+#define portTICK_PERIOD_MS 1
+void vTaskDelay(TickType_t ticks);
+
+/* gpio */
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+typedef enum { GPIO_PULLUP_DISABLE, GPIO_PULLUP_ENABLE } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE, GPIO_PULLDOWN_ENABLE } gpio_pulldown_t;
+typedef enum { GPIO_INTR_DISABLE } gpio_int_type_t;
+typedef struct {
+  uint64_t pin_bit_mask;
+  gpio_mode_t mode;
+  gpio_pullup_t pull_up_en;
+  gpio_pulldown_t pull_down_en;
+  gpio_int_type_t intr_type;
+} gpio_config_t;
+esp_err_t gpio_config(const gpio_config_t *config);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+
+/* spi master */
+typedef enum { SPI_HOST, HSPI_HOST, VSPI_HOST } spi_host_device_t;
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+struct spi_transaction_t {
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t length;
+  size_t rxlength;
+  void *user;
+  const void *tx_buffer;
+  void *rx_buffer;
+};
+typedef struct {
+  int mosi_io_num, miso_io_num, sclk_io_num, quadwp_io_num, quadhd_io_num;
+  int max_transfer_sz;
+  uint32_t flags;
+  int intr_flags;
+} spi_bus_config_t;
+typedef struct {
+  uint8_t command_bits, address_bits, dummy_bits, mode;
+  uint16_t duty_cycle_pos, cs_ena_pretrans;
+  uint8_t cs_ena_posttrans;
+  int clock_speed_hz;
+  int input_delay_ns;
+  int spics_io_num;
+  uint32_t flags;
+  int queue_size;
+  transaction_cb_t pre_cb;
+  transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+typedef struct spi_device_t *spi_device_handle_t;
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+
+/* i2c, not used by the benchmark */
+typedef int i2c_port_t;
+typedef void *i2c_cmd_handle_t;
+#define I2C_NUM_1 1
+#define I2C_MASTER_WRITE 0
+typedef enum { I2C_MODE_MASTER = 1 } i2c_mode_t;
+typedef struct {
+  i2c_mode_t mode;
+  int sda_io_num, scl_io_num;
+  gpio_pullup_t sda_pullup_en, scl_pullup_en;
+  struct { uint32_t clk_speed; } master;
+} i2c_config_t;
+static inline esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf) { return ESP_OK; }
+static inline esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t rx, size_t tx, int flags) { return ESP_OK; }
+static inline i2c_cmd_handle_t i2c_cmd_link_create(void) { return NULL; }
+static inline void i2c_cmd_link_delete(i2c_cmd_handle_t h) { }
+static inline esp_err_t i2c_master_start(i2c_cmd_handle_t h) { return ESP_OK; }
+static inline esp_err_t i2c_master_stop(i2c_cmd_handle_t h) { return ESP_OK; }
+static inline esp_err_t i2c_master_write_byte(i2c_cmd_handle_t h, uint8_t data, bool ack) { return ESP_OK; }
+static inline esp_err_t i2c_master_write(i2c_cmd_handle_t h, uint8_t *data, size_t len, bool ack) { return ESP_OK; }
+static inline esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t h, TickType_t ticks) { return ESP_OK; }
+
+#endif
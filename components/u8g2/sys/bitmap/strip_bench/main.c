@@ -0,0 +1,177 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Scrolling text from a pre-rendered strip (u8g2_strip.c, as used by
+ * main/ui_scroll.c) on the Bitmap device (128x64, U8G2_R0).
+ * First checks that u8g2_DrawStrip() draws the same picture as
+ * u8g2_DrawStr() for many strip offsets, y positions (also not tile
+ * aligned), window positions and widths, in full and page buffer mode.
+ * u8g2_uint_t has 8 bits, so the reference draws only the glyphs around
+ * the window with u8g2_DrawStr(), clipped to the window.
+ * Then prints the per frame cost of a scrolled line: u8g2_DrawStr() of the
+ * whole line (as before the strips), of the visible glyphs only, and
+ * u8g2_DrawStrip() of a 128 pixel window, together with the one-off
+ * u8g2_DrawStrStrip().
+ *
+ * The unifont is built from tools/font (see Makefile).
+ */
+
+#include "u8g2_font_unifont_t_symbols.c"
+
+extern const uint8_t u8g2_font_9x15_tr[];
+
+#define STRIP_SIZE (6 * 2 * 128)	/* UI_SCROLL_STRIP_SIZE of main/ui_scroll.h */
+#define MAX_STR 80
+
+u8g2_t u8g2;
+
+static uint8_t *full_buf;
+static uint8_t page_buf[128];
+static uint8_t strip_buf[STRIP_SIZE];
+static u8g2_strip_t strip;
+
+static const char *title = "Symphony No. 9 in D minor, Op. 125 'Choral': IV. Presto - Allegro assai (Live)";
+
+/* x position of each char in the strip */
+static uint16_t pos[MAX_STR+1];
+
+static void get_picture(uint8_t *pic)
+{
+  u8g2_uint_t x, y;
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+      pic[y*128+x] = u8x8_GetBitmapPixel(u8g2_GetU8x8(&u8g2), x, y);
+}
+
+static void set_buffer(uint8_t is_page, const uint8_t *font)
+{
+  if ( is_page )
+    u8g2_SetupBuffer(&u8g2, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  else
+    u8g2_SetupBuffer(&u8g2, full_buf, 8, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  u8g2_SetFont(&u8g2, font);
+  u8g2_SetFontMode(&u8g2, 1);
+}
+
+static void calc_pos(const char *s)
+{
+  unsigned i;
+  pos[0] = 0;
+  for( i = 0; s[i] != '\0'; i++ )
+    pos[i+1] = pos[i] + u8g2_GetGlyphWidth(&u8g2, (uint8_t)s[i]);
+}
+
+/* u8g2_DrawStr() of the glyphs of s which may touch x...x+w-1 for the strip position sx */
+static void draw_visible(const char *s, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, uint16_t sx)
+{
+  char sub[MAX_STR+1];
+  uint16_t margin = u8g2.font_info.max_char_width;
+  unsigned a = 0, b, len = strlen(s);
+
+  while( a < len && pos[a+1] + margin <= sx )
+    a++;
+  b = a;
+  while( b < len && pos[b] < sx + w + margin )
+    b++;
+  memcpy(sub, s + a, b - a);
+  sub[b - a] = '\0';
+  u8g2_DrawStr(&u8g2, (u8g2_uint_t)(x + pos[a] - sx), y + strip.ascent, sub);
+}
+
+static void draw_ref(const char *s, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, uint16_t sx)
+{
+  u8g2_SetClipWindow(&u8g2, x, 0, x + w, 64);
+  draw_visible(s, x, y, w, sx);
+  u8g2_SetMaxClipWindow(&u8g2);
+}
+
+static unsigned check_font(const uint8_t *font, const char *s, unsigned *cnt)
+{
+  static const uint16_t offsets[] = { 0, 1, 7, 8, 63, 127, 128, 129, 200, 255, 256, 257, 333, 511, 512 };
+  static const u8g2_uint_t ys[] = { 0, 3, 8, 13, 24, 41, 50, 60 };
+  static const u8g2_uint_t windows[][2] = { { 0, 128 }, { 10, 100 }, { 37, 5 }, { 120, 8 } };
+  static uint8_t ref[128*64], pic[128*64];
+  unsigned o, i, j, is_page, errors = 0;
+  uint16_t sx;
+
+  for( is_page = 0; is_page < 2; is_page++ )
+    for( o = 0; o < sizeof(offsets)/sizeof(*offsets); o++ )
+      for( i = 0; i < sizeof(ys)/sizeof(*ys); i++ )
+	for( j = 0; j < sizeof(windows)/sizeof(*windows); j++ )
+	{
+	  sx = offsets[o];
+	  if ( sx + windows[j][1] > strip.width )
+	    sx = strip.width - windows[j][1];	/* the end of the line */
+	  set_buffer(is_page, font);
+	  u8g2_FirstPage(&u8g2);
+	  do
+	  {
+	    draw_ref(s, windows[j][0], ys[i], windows[j][1], sx);
+	  } while( u8g2_NextPage(&u8g2) );
+	  get_picture(ref);
+
+	  u8g2_FirstPage(&u8g2);
+	  do
+	  {
+	    u8g2_DrawStrip(&u8g2, windows[j][0], ys[i], windows[j][1], &strip, sx);
+	  } while( u8g2_NextPage(&u8g2) );
+	  get_picture(pic);
+
+	  if ( memcmp(ref, pic, sizeof(ref)) != 0 )
+	    errors++;
+	  (*cnt)++;
+	}
+  return errors;
+}
+
+/* render the strip of s in full buffer mode */
+static void setup_font(const uint8_t *font, const char *s)
+{
+  set_buffer(0, font);
+  calc_pos(s);
+  u8g2_DrawStrStrip(&u8g2, &strip, strip_buf, STRIP_SIZE, s);
+}
+
+#define ROUNDS 20
+
+static unsigned bench_font(const char *name, const uint8_t *font)
+{
+  unsigned cnt = 0, errors;
+  double ns_str, ns_visible, ns_strip, ns_render;
+  uint16_t sx;
+
+  setup_font(font, title);
+  if ( strip.width != pos[strlen(title)] )
+    printf("%s: strip width %u, expected %u\n", name, strip.width, pos[strlen(title)]);
+  errors = check_font(font, title, &cnt);
+  errors += strip.width != pos[strlen(title)];
+
+  set_buffer(0, font);
+  sx = strip.width / 2;
+  BENCH_NS(ns_str, ROUNDS, 2000, u8g2_DrawStr(&u8g2, 0, 30, title));
+  BENCH_NS(ns_visible, ROUNDS, 2000, draw_visible(title, 0, 14, 128, sx));
+  BENCH_NS(ns_strip, ROUNDS, 20000, u8g2_DrawStrip(&u8g2, 0, 14, 128, &strip, sx));
+  BENCH_NS(ns_render, ROUNDS, 1000, u8g2_DrawStrStrip(&u8g2, &strip, strip_buf, STRIP_SIZE, title));
+
+  printf("%-10s %6u %10.2f %10.2f %10.2f %10.2f %6u %s\n", name, strip.width,
+    ns_str/1e3, ns_visible/1e3, ns_strip/1e3, ns_render/1e3, cnt, errors ? "DIFF" : "same");
+  return errors;
+}
+
+int main(void)
+{
+  unsigned errors = 0;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  full_buf = u8g2_GetBufferPtr(&u8g2);
+
+  printf("%u char line, us per call\n", (unsigned)strlen(title));
+  printf("%-10s %6s %10s %10s %10s %10s %6s %s\n", "font", "width", "DrawStr", "visible", "DrawStrip", "render", "checks", "strip");
+  errors += bench_font("unifont", u8g2_font_unifont_t_symbols);
+  errors += bench_font("9x15", u8g2_font_9x15_tr);
+  return errors != 0;
+}
@@ -0,0 +1,63 @@
+#include "U8g2Template.h"
+
+/*
+ * One frame (DrawStr, DrawBox, SendBuffer) for the code size comparison
+ * in the Makefile: compile with -DFRAME_C for the C path of
+ * U8G2_SSD1306_128X64_NONAME_F_HW_I2C, with -DFRAME_TEMPLATE for
+ * U8G2_TEMPLATE.
+ */
+
+extern "C" const uint8_t u8g2_font_9x15_tr[];
+
+volatile uint8_t sink;
+
+static uint8_t byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data = (uint8_t *)arg_ptr;
+  if ( msg == U8X8_MSG_BYTE_SEND )
+    while( arg_int-- > 0 )
+      sink = *data++;
+  return 1;
+}
+
+static uint8_t gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+#ifdef FRAME_C
+
+u8g2_t u8g2;
+
+int main(void)
+{
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, byte_cb, gpio_and_delay_cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_ClearDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_SetFont(&u8g2, u8g2_font_9x15_tr);
+  u8g2_DrawStr(&u8g2, 0, 20, "Title");
+  u8g2_DrawBox(&u8g2, 14, 52, 100, 8);
+  u8g2_SendBuffer(&u8g2);
+  return 0;
+}
+
+#endif
+
+#ifdef FRAME_TEMPLATE
+
+U8G2_TEMPLATE<U8G2_CONTROLLER_SSD1306_128X64_NONAME_I2C, U8G2_LAYOUT_VERTICAL_TOP_LSB, U8G2_ROTATION_R0, U8G2_TRANSPORT_CB<byte_cb, gpio_and_delay_cb> > u8g2;
+
+int main(void)
+{
+  u8g2.begin();
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_9x15_tr);
+  u8g2.drawStr(0, 20, "Title");
+  u8g2.drawBox(14, 52, 100, 8);
+  u8g2.sendBuffer();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include "U8g2Template.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include <vector>
+
+/*
+ * Compares U8G2_TEMPLATE (cppsrc/U8g2Template.h) with the C path of
+ * U8G2_SSD1306_128X64_NONAME_F_HW_I2C (u8g2_Setup_ssd1306_i2c_128x64_noname_f).
+ * First checks for all four rotations that random pixels, lines, boxes and
+ * frames give the same buffer and that sendBuffer sends the same I2C
+ * transfers, then prints the time of DrawStr, DrawBox and SendBuffer.
+ * Code size: "make size".
+ */
+
+extern "C" const uint8_t u8g2_font_9x15_tr[];
+
+/*==========================================*/
+/* byte procedures */
+
+#define REC_START 0x100
+#define REC_END 0x101
+
+static std::vector<int> *rec;
+volatile uint8_t sink;
+
+static uint8_t rec_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      rec->insert(rec->end(), (uint8_t *)arg_ptr, (uint8_t *)arg_ptr + arg_int);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      rec->push_back(REC_START);
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      rec->push_back(REC_END);
+      break;
+  }
+  return 1;
+}
+
+static uint8_t null_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data = (uint8_t *)arg_ptr;
+  if ( msg == U8X8_MSG_BYTE_SEND )
+    while( arg_int-- > 0 )
+      sink = *data++;
+  return 1;
+}
+
+static uint8_t gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*==========================================*/
+/* compare with the C path */
+
+static u8g2_uint_t rnd_pos(void)
+{
+  /* mostly on screen, sometimes wrapped around */
+  if ( (rand() & 7) == 0 )
+    return (u8g2_uint_t)rand();
+  return rand() % 140;
+}
+
+template <class ROTATION>
+static unsigned check_rotation(const u8g2_cb_t *cb, const char *name)
+{
+  static u8g2_t c;
+  static U8G2_TEMPLATE<U8G2_CONTROLLER_SSD1306_128X64_NONAME_I2C, U8G2_LAYOUT_VERTICAL_TOP_LSB, ROTATION, U8G2_TRANSPORT_CB<rec_byte_cb, gpio_and_delay_cb> > t;
+  static const uint8_t max_transfer[] = { 0, 17, 32, 129, 255 };
+  std::vector<int> rec_c, rec_t;
+  unsigned scene, i, errors = 0;
+  u8g2_uint_t x, y, w, h;
+  uint8_t color, op;
+
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&c, cb, rec_byte_cb, gpio_and_delay_cb);
+  for( scene = 0; scene < 20000; scene++ )
+  {
+    for( i = 0; i < 1024; i++ )
+      u8g2_GetBufferPtr(&c)[i] = t.getBufferPtr()[i] = rand();
+    if ( (scene & 3) == 0 )
+    {
+      /* x0 < x1 <= width, y0 < y1 <= height */
+      x = rand() % c.width; w = x + 1 + rand() % (c.width-x);
+      y = rand() % c.height; h = y + 1 + rand() % (c.height-y);
+      u8g2_SetClipWindow(&c, x, y, w, h);
+      u8g2_SetClipWindow(t.getU8g2(), x, y, w, h);
+    }
+    else
+    {
+      u8g2_SetMaxClipWindow(&c);
+      u8g2_SetMaxClipWindow(t.getU8g2());
+    }
+    for( i = 0; i < 8; i++ )
+    {
+      color = rand() % 3;
+      u8g2_SetDrawColor(&c, color);
+      t.setDrawColor(color);
+      x = rnd_pos(); y = rnd_pos(); w = rnd_pos(); h = rnd_pos();
+      op = rand() % 5;
+      /* u8g2_clip_intersection2() may return len 0 for a wrapped line and */
+      /* u8g2_ll_hvline_vertical_top_lsb() would overflow with dir 1 and len 0, */
+      /* only the rows of a box may wrap around */
+      if ( (u8g2_uint_t)(x + w) < x )
+	w = (u8g2_uint_t)~x;
+      if ( op != 3 && (u8g2_uint_t)(y + h) < y )
+	h = (u8g2_uint_t)~y;
+      switch( op )
+      {
+	case 0: u8g2_DrawPixel(&c, x, y); t.drawPixel(x, y); break;
+	case 1: u8g2_DrawHLine(&c, x, y, w); t.drawHLine(x, y, w); break;
+	case 2: u8g2_DrawVLine(&c, x, y, h); t.drawVLine(x, y, h); break;
+	case 3: u8g2_DrawBox(&c, x, y, w, h); t.drawBox(x, y, w, h); break;
+	case 4: u8g2_DrawFrame(&c, x, y, w, h); t.drawFrame(x, y, w, h); break;
+      }
+    }
+    if ( memcmp(u8g2_GetBufferPtr(&c), t.getBufferPtr(), 1024) != 0 )
+      errors++;
+  }
+
+  for( i = 0; i < sizeof(max_transfer); i++ )
+  {
+    u8x8_SetByteMaxTransfer(u8g2_GetU8x8(&c), max_transfer[i]);
+    u8x8_SetByteMaxTransfer(t.getU8x8(), max_transfer[i]);
+    rec_c.clear();
+    rec_t.clear();
+    rec = &rec_c;
+    u8g2_SendBuffer(&c);
+    rec = &rec_t;
+    t.sendBuffer();
+    if ( rec_c != rec_t )
+      errors++;
+  }
+  printf("%s: %u differences\n", name, errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+static u8g2_t c;
+static U8G2_TEMPLATE<U8G2_CONTROLLER_SSD1306_128X64_NONAME_I2C, U8G2_LAYOUT_VERTICAL_TOP_LSB, U8G2_ROTATION_R0, U8G2_TRANSPORT_CB<null_byte_cb, gpio_and_delay_cb> > t;
+
+/* best of 5 alternating rounds, the time of a single round depends on the order */
+#define BENCH(name, n, c_expr, t_expr) \
+  do { \
+    double t0, c_ns = 1e12, t_ns = 1e12; \
+    unsigned i, round; \
+    for( round = 0; round < 5; round++ ) \
+    { \
+      t0 = bench_now_ns(); \
+      for( i = 0; i < (n); i++ ) { c_expr; } \
+      if ( bench_now_ns() - t0 < c_ns ) c_ns = bench_now_ns() - t0; \
+      t0 = bench_now_ns(); \
+      for( i = 0; i < (n); i++ ) { t_expr; } \
+      if ( bench_now_ns() - t0 < t_ns ) t_ns = bench_now_ns() - t0; \
+    } \
+    printf("%-24s %10.1f %10.1f\n", name, c_ns/(n), t_ns/(n)); \
+  } while(0)
+
+int main(void)
+{
+  unsigned errors = 0;
+  u8g2_uint_t x, y;
+
+  errors += check_rotation<U8G2_ROTATION_R0>(U8G2_R0, "U8G2_R0");
+  errors += check_rotation<U8G2_ROTATION_R1>(U8G2_R1, "U8G2_R1");
+  errors += check_rotation<U8G2_ROTATION_R2>(U8G2_R2, "U8G2_R2");
+  errors += check_rotation<U8G2_ROTATION_R3>(U8G2_R3, "U8G2_R3");
+
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&c, U8G2_R0, null_byte_cb, gpio_and_delay_cb);
+  u8g2_InitDisplay(&c);
+  t.begin();
+  u8g2_SetFont(&c, u8g2_font_9x15_tr);
+  t.setFont(u8g2_font_9x15_tr);
+  u8g2_SetDrawColor(&c, 2);
+  t.setDrawColor(2);
+
+  printf("\n%-24s %10s %10s\n", "ns/call", "C", "template");
+  BENCH("DrawStr 19 chars", 50000,
+    u8g2_DrawStr(&c, 0, 30, "A Rather Long Title"),
+    t.drawStr(0, 30, "A Rather Long Title"));
+  BENCH("DrawBox 128x64", 200000,
+    u8g2_DrawBox(&c, 0, 0, 128, 64),
+    t.drawBox(0, 0, 128, 64));
+  BENCH("DrawBox 100x8", 200000,
+    u8g2_DrawBox(&c, 14, 52, 100, 8),
+    t.drawBox(14, 52, 100, 8));
+  BENCH("DrawBox 6x40", 200000,
+    u8g2_DrawBox(&c, 60, 20, 6, 40),
+    t.drawBox(60, 20, 6, 40));
+  BENCH("DrawPixel 128x64", 500,
+    for( y = 0; y < 64; y++ ) for( x = 0; x < 128; x++ ) u8g2_DrawPixel(&c, x, y),
+    for( y = 0; y < 64; y++ ) for( x = 0; x < 128; x++ ) t.drawPixel(x, y));
+  BENCH("SendBuffer", 10000,
+    u8g2_SendBuffer(&c),
+    t.sendBuffer());
+
+  if ( errors != 0 )
+  {
+    printf("%u differences\n", errors);
+    return 1;
+  }
+  return 0;
+}
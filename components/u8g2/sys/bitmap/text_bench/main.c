@@ -0,0 +1,146 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Per frame cost of centered labels on the Bitmap device (128x64, U8G2_R0):
+ * u8g2_GetStrWidth() and u8g2_DrawStr() for each label (as drawStrCentered()
+ * in main/ui_controller.c did) against u8g2_LayoutStr() and u8g2_DrawText()
+ * with an unchanged layout. First checks for random strings, both fonts,
+ * with and without glyph cache and all font directions that the width
+ * and the buffer are the same.
+ */
+
+extern const uint8_t u8g2_font_9x15_tr[];
+extern const uint8_t u8g2_font_helvB18_tr[];
+
+u8g2_t u8g2;
+
+#define CACHE_ENTRIES 64
+static u8g2_glyph_cache_t cache;
+static u8g2_glyph_cache_entry_t cache_entries[CACHE_ENTRIES];
+
+static u8g2_text_t texts[4];
+
+static const char *labels[4] = { "Grotsoft", "Bluetooth", "Receiver", "SW v1.2.3" };
+
+static void rnd_str(char *s, unsigned max)
+{
+  unsigned i, len = rand() % max;
+  for( i = 0; i < len; i++ )
+    s[i] = 32 + rand() % 100;	/* includes chars which are not in the _tr fonts */
+  s[len] = '\0';
+}
+
+static unsigned check(void)
+{
+  static uint8_t ref[1024];
+  static u8g2_text_t text;
+  char s[U8G2_TEXT_MAX_LEN+8];
+  unsigned i, errors = 0;
+  u8g2_uint_t x, y, w_ref, w_text, d_ref, d_text;
+  uint8_t dir;
+  
+  for( i = 0; i < 20000; i++ )
+  {
+    u8g2_SetFont(&u8g2, (i & 1) ? u8g2_font_9x15_tr : u8g2_font_helvB18_tr);
+    if ( (i & 2) )
+      u8g2_SetGlyphCache(&u8g2, &cache, cache_entries, CACHE_ENTRIES);
+    else
+      u8g2.glyph_cache = NULL;
+    dir = (i >> 2) & 3;
+    u8g2_SetFontDirection(&u8g2, dir);
+    rnd_str(s, sizeof(s)-1);	/* sometimes longer than U8G2_TEXT_MAX_LEN */
+    x = rand() % 128;
+    y = rand() % 64;
+    
+    u8g2_ClearBuffer(&u8g2);
+    w_ref = u8g2_GetStrWidth(&u8g2, s);
+    d_ref = u8g2_DrawStr(&u8g2, x, y, s);
+    memcpy(ref, u8g2_GetBufferPtr(&u8g2), 1024);
+    
+    u8g2_ClearBuffer(&u8g2);
+    w_text = u8g2_LayoutStr(&u8g2, &text, s);
+    d_text = u8g2_DrawText(&u8g2, x, y, &text);
+    if ( w_ref != w_text || d_ref != d_text || memcmp(ref, u8g2_GetBufferPtr(&u8g2), 1024) != 0 )
+      errors++;
+    
+    /* same string again: the layout is kept */
+    if ( u8g2_LayoutStr(&u8g2, &text, s) != w_ref )
+      errors++;
+  }
+  u8g2_SetFontDirection(&u8g2, 0);
+  return errors;
+}
+
+static void frame_str(void)
+{
+  unsigned i;
+  u8g2_uint_t w;
+  for( i = 0; i < 4; i++ )
+  {
+    w = u8g2_GetStrWidth(&u8g2, labels[i]);
+    u8g2_DrawStr(&u8g2, (128 - w) / 2, 15 * (i+1), labels[i]);
+  }
+}
+
+static void frame_text(void)
+{
+  unsigned i;
+  u8g2_uint_t w;
+  for( i = 0; i < 4; i++ )
+  {
+    w = u8g2_LayoutStr(&u8g2, texts + i, labels[i]);
+    u8g2_DrawText(&u8g2, (128 - w) / 2, 15 * (i+1), texts + i);
+  }
+}
+
+static void layout_str(void)
+{
+  unsigned i;
+  volatile u8g2_uint_t w;
+  for( i = 0; i < 4; i++ )
+    w = u8g2_GetStrWidth(&u8g2, labels[i]);
+  (void)w;
+}
+
+static void layout_text(void)
+{
+  unsigned i;
+  volatile u8g2_uint_t w;
+  for( i = 0; i < 4; i++ )
+    w = u8g2_LayoutStr(&u8g2, texts + i, labels[i]);
+  (void)w;
+}
+
+/* best of 20 rounds */
+#define BENCH(name, n, ...) \
+  do { \
+    double ns; \
+    BENCH_NS(ns, 20, n, __VA_ARGS__); \
+    printf("%-40s %10.1f\n", name, ns); \
+  } while(0)
+
+int main(void)
+{
+  unsigned errors;
+  
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  
+  errors = check();
+  printf("%u differences\n\n", errors);
+  
+  u8g2_SetFont(&u8g2, u8g2_font_9x15_tr);
+  printf("%-40s %10s\n", "ns per frame, 4 centered labels", "");
+  BENCH("width, GetStrWidth", 20000, layout_str());
+  BENCH("width, LayoutStr", 20000, layout_text());
+  BENCH("frame, GetStrWidth + DrawStr", 10000, frame_str());
+  BENCH("frame, LayoutStr + DrawText", 10000, frame_text());
+  u8g2_SetGlyphCache(&u8g2, &cache, cache_entries, CACHE_ENTRIES);
+  BENCH("frame, glyph cache, GetStrWidth + DrawStr", 10000, frame_str());
+  BENCH("frame, glyph cache, LayoutStr + DrawText", 10000, frame_text());
+  return errors != 0;
+}
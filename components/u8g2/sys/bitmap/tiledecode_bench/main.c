@@ -0,0 +1,121 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "font_scene.h"
+
+/*
+ * Tile glyph decoder (U8G2_WITH_TILE_GLYPH_DECODE) against the generic
+ * decoder (u8g2_font_decode_len) on the Bitmap device (128x64, U8G2_R0).
+ * The generic decoder is used if ll_hvline is not
+ * u8g2_ll_hvline_vertical_top_lsb, so the reference scenes draw through a
+ * wrapper of it.
+ * First draws random scenes (common/font_scene.c) with both decoders and
+ * checks that the pictures are the same: four fonts, one with glyphs wider
+ * than U8G2_TILE_GLYPH_MAX_WIDTH (these fall back to the generic decoder),
+ * draw colors, font modes, clip windows, positions partly outside of the
+ * display, full and page buffer mode.
+ * Then prints the time of u8g2_DrawStr() with both decoders.
+ *
+ * The unifont and osr96 are built from tools/font (see Makefile).
+ */
+
+#include "u8g2_font_unifont_t_symbols.c"
+#include "u8g2_font_osr96_tr.c"
+
+extern const uint8_t u8g2_font_9x15_tr[];
+extern const uint8_t u8g2_font_helvB18_tr[];
+
+#define CHECK_SCENES 20000
+
+u8g2_t u8g2;
+
+static const uint8_t *fonts[4] = { u8g2_font_unifont_t_symbols, u8g2_font_9x15_tr, u8g2_font_helvB18_tr, u8g2_font_osr96_tr };
+
+/* same pixels as u8g2_ll_hvline_vertical_top_lsb, but the tile decoder is not used */
+static void generic_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_ll_hvline_vertical_top_lsb(u8g2, x, y, len, dir);
+}
+
+static void generic_decoder(u8g2_t *u8g2)
+{
+  u8g2->ll_hvline = generic_hvline;
+}
+
+static void tile_decoder(u8g2_t *u8g2)
+{
+  u8g2->ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+}
+
+/* glyphs of the font which are too wide for the tile decoder */
+static unsigned wide_glyphs(const uint8_t *font)
+{
+  unsigned e, cnt = 0;
+  u8g2_SetFont(&u8g2, font);
+  for( e = 32; e < 256; e++ )
+    if ( u8g2_IsGlyph(&u8g2, e) )
+    {
+      u8g2_GetGlyphWidth(&u8g2, e);
+      if ( u8g2.font_decode.glyph_width > U8G2_TILE_GLYPH_MAX_WIDTH )
+	cnt++;
+    }
+  return cnt;
+}
+
+static unsigned check(void)
+{
+  static uint8_t ref[128*64], pic[128*64];
+  font_scene_t sc;
+  unsigned i, errors = 0;
+
+  for( i = 0; i < CHECK_SCENES; i++ )
+  {
+    font_scene_rnd(&sc, fonts, 4);
+    font_scene_draw(&u8g2, &sc, generic_decoder, ref);
+    font_scene_draw(&u8g2, &sc, tile_decoder, pic);
+    if ( memcmp(ref, pic, sizeof(ref)) != 0 )
+      errors++;
+  }
+  printf("%u scenes, %u differences\n", CHECK_SCENES, errors);
+
+  font_scene_full_buffer(&u8g2);
+  return errors;
+}
+
+#define ROUNDS 20
+#define N 10000
+
+static void bench_font(const char *name, const uint8_t *font, u8g2_uint_t y, const char *s)
+{
+  double ns_generic, ns_tile;
+
+  u8g2_SetFont(&u8g2, font);
+  u8g2_SetFontMode(&u8g2, 0);
+  u8g2_SetDrawColor(&u8g2, 1);
+  generic_decoder(&u8g2);
+  BENCH_NS(ns_generic, ROUNDS, N, u8g2_DrawStr(&u8g2, 0, y, s));
+  tile_decoder(&u8g2);
+  BENCH_NS(ns_tile, ROUNDS, N, u8g2_DrawStr(&u8g2, 0, y, s));
+  printf("%-36s %10.1f %10.1f %8.2f\n", name, ns_generic, ns_tile, ns_generic / ns_tile);
+}
+
+int main(void)
+{
+  unsigned errors, wide;
+
+  font_scene_setup(&u8g2);
+
+  wide = wide_glyphs(u8g2_font_osr96_tr);
+  printf("osr96: %u glyphs wider than %d pixel\n", wide, U8G2_TILE_GLYPH_MAX_WIDTH);
+  errors = check();
+  if ( wide == 0 )
+    errors++;
+
+  printf("\n%-36s %10s %10s %8s\n", "DrawStr ns/call", "generic", "tile", "speedup");
+  bench_font("unifont \"Connected to My Phone\"", u8g2_font_unifont_t_symbols, 30, "Connected to My Phone");
+  bench_font("9x15 \"Connected to My Phone\"", u8g2_font_9x15_tr, 30, "Connected to My Phone");
+  bench_font("helvB18 \"3:27\"", u8g2_font_helvB18_tr, 58, "3:27");
+  bench_font("osr96 \"a=w\", = and w wider than max", u8g2_font_osr96_tr, 70, "a=w");
+  return errors != 0;
+}
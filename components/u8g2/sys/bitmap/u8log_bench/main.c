@@ -0,0 +1,236 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Checks and benchmarks u8log with the ring of lines and the deferred
+ * redraw on the Bitmap device (128x64, 25x9 chars of u8g2_font_5x7_tr).
+ *
+ * 1. Random text with control codes must give the same screen and the
+ *    same redraw callbacks as the previous u8log (u8log_ref.c), in line
+ *    and in char redraw mode.
+ * 2. With deferred redraw, u8log_Redraw() after each burst of text must
+ *    report a change whenever the previous u8log called the callback.
+ * 3. Time to write a log line: the previous u8log moves the whole screen
+ *    for each scrolled line, the new one only clears the scrolled line.
+ *    Log lines per second which can be written while the console is
+ *    redrawn at a fixed frame rate. The previous u8log redraws the
+ *    screen for each line (u8log_u8g2_cb), the new one once per frame.
+ */
+
+#define W 128
+#define H 64
+#define LOG_W 25
+#define LOG_H 9
+
+void ref_u8log_Init(u8log_t *u8log, uint8_t width, uint8_t height, uint8_t *buf);
+void ref_u8log_SetCallback(u8log_t *u8log, u8log_cb cb, void *aux_data);
+void ref_u8log_SetRedrawMode(u8log_t *u8log, uint8_t is_redraw_line_for_each_char);
+void ref_u8log_WriteChar(u8log_t *u8log, uint8_t c);
+void ref_u8log_WriteString(u8log_t *u8log, const char *s);
+void ref_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log);
+
+#include "u8g2_font_5x7_tr.c"
+
+u8g2_t u8g2;
+
+static u8log_t log_new, log_ref;
+static uint8_t buf_new[LOG_W*LOG_H], buf_ref[LOG_W*LOG_H];
+
+/* redraw callbacks: is_redraw_all, redraw_line */
+static unsigned cb_cnt_new, cb_cnt_ref;
+static uint8_t cb_all_new, cb_all_ref, cb_line_new, cb_line_ref;
+
+static void cb_new(u8log_t *u8log)
+{
+  cb_cnt_new++;
+  cb_all_new = u8log->is_redraw_all;
+  cb_line_new = u8log->redraw_line;
+}
+
+static void cb_ref(u8log_t *u8log)
+{
+  cb_cnt_ref++;
+  cb_all_ref = u8log->is_redraw_all;
+  cb_line_ref = u8log->redraw_line;
+}
+
+static uint8_t random_char(void)
+{
+  static const char ctrl[] = "\n\n\n\n\r\t";
+  int r = rand() % 60;
+
+  if ( r < 6 )
+    return ctrl[r];
+  if ( r == 6 && rand() % 20 == 0 )
+    return '\f';
+  return 'a' + rand() % 26;
+}
+
+static int same_screen(void)
+{
+  uint8_t y;
+
+  for( y = 0; y < LOG_H; y++ )
+    if ( memcmp(u8log_GetLine(&log_new, y), buf_ref + y*LOG_W, LOG_W) != 0 )
+      return 0;
+  return 1;
+}
+
+/*==========================================*/
+/* compare with the previous u8log */
+
+static unsigned check_previous(void)
+{
+  unsigned i, mode, errors = 0;
+  uint8_t c;
+
+  for( mode = 0; mode < 2; mode++ )
+  {
+    u8log_Init(&log_new, LOG_W, LOG_H, buf_new);
+    u8log_SetCallback(&log_new, cb_new, NULL);
+    u8log_SetRedrawMode(&log_new, mode);
+    ref_u8log_Init(&log_ref, LOG_W, LOG_H, buf_ref);
+    ref_u8log_SetCallback(&log_ref, cb_ref, NULL);
+    ref_u8log_SetRedrawMode(&log_ref, mode);
+    cb_cnt_new = cb_cnt_ref = 0;
+    for( i = 0; i < 200000; i++ )
+    {
+      c = random_char();
+      u8log_WriteChar(&log_new, c);
+      ref_u8log_WriteChar(&log_ref, c);
+      if ( !same_screen() || cb_cnt_new != cb_cnt_ref || cb_all_new != cb_all_ref
+	  || ( !cb_all_new && cb_line_new != cb_line_ref ) )
+      {
+	if ( errors < 5 )
+	  printf("difference to previous u8log: mode %u, char %u\n", mode, i);
+	errors++;
+	break;
+      }
+    }
+  }
+  printf("previous u8log: %u differences\n", errors);
+  return errors;
+}
+
+static unsigned check_deferred(void)
+{
+  unsigned i, j, n, errors = 0;
+  uint8_t c;
+
+  u8log_Init(&log_new, LOG_W, LOG_H, buf_new);
+  u8log_SetRedrawDeferred(&log_new, 1);
+  ref_u8log_Init(&log_ref, LOG_W, LOG_H, buf_ref);
+  ref_u8log_SetCallback(&log_ref, cb_ref, NULL);
+  for( i = 0; i < 20000; i++ )
+  {
+    n = rand() % 200;
+    cb_cnt_ref = 0;
+    for( j = 0; j < n; j++ )
+    {
+      c = random_char();
+      u8log_WriteChar(&log_new, c);
+      ref_u8log_WriteChar(&log_ref, c);
+    }
+    if ( !same_screen() || u8log_Redraw(&log_new) != (cb_cnt_ref != 0) )
+    {
+      if ( errors < 5 )
+	printf("difference with deferred redraw: burst %u\n", i);
+      errors++;
+    }
+  }
+  printf("deferred redraw: %u differences\n", errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+static const char *lines[] =
+{
+  "I (12345) BT_AV: A2DP audio state: Started\n",
+  "I (12346) UI Cont: Dispatch\n",
+  "W (12400) BT_APP_CORE: bt_app_send_msg xQueue send failed\n",
+  "I (12410) BT_AV: AVRC metadata rsp: attribute id 0x1, Title\n",
+};
+
+/* draw the screen into the buffer, same as u8log_u8g2_cb() without sending */
+static void draw_ref_cb(u8log_t *u8log)
+{
+  u8g2_ClearBuffer(&u8g2);
+  ref_DrawLog(&u8g2, 0, u8g2_GetAscent(&u8g2), u8log);
+}
+
+static void draw_new(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawLog(&u8g2, 0, u8g2_GetAscent(&u8g2), &log_new);
+}
+
+/* best of 50 rounds */
+static double bench_line_ns(uint8_t is_ref, unsigned n)
+{
+  unsigned i = 0;
+  double ns;
+
+  if ( is_ref )
+    BENCH_NS(ns, 50, n, ref_u8log_WriteString(&log_ref, lines[i++ & 3]));
+  else
+    BENCH_NS(ns, 50, n, u8log_WriteString(&log_new, lines[i++ & 3]));
+  return ns;
+}
+
+static double bench_frame_ns(unsigned n)
+{
+  unsigned i = 0;
+  double ns;
+
+  BENCH_NS(ns, 50, n, 
+    u8log_WriteString(&log_new, lines[i++ & 3]);
+    u8log_Redraw(&log_new);
+    draw_new());
+  return ns;
+}
+
+int main(void)
+{
+  static const unsigned fps[] = { 10, 25 };
+  double ref_line, ref_scroll, new_line, new_frame;
+  unsigned errors = 0, i;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, W, H);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_SetFont(&u8g2, u8g2_font_5x7_tr);
+
+  errors += check_previous();
+  errors += check_deferred();
+
+  ref_u8log_Init(&log_ref, LOG_W, LOG_H, buf_ref);
+  ref_u8log_SetCallback(&log_ref, draw_ref_cb, NULL);
+  u8log_Init(&log_new, LOG_W, LOG_H, buf_new);
+  u8log_SetRedrawDeferred(&log_new, 1);
+
+  ref_line = bench_line_ns(1, 200);
+  ref_u8log_SetCallback(&log_ref, NULL, NULL);
+  ref_scroll = bench_line_ns(1, 200);
+  new_line = bench_line_ns(0, 200);
+  new_frame = bench_frame_ns(200) - new_line;
+
+  printf("\n%-34s %12s %12s\n", "", "previous", "deferred");
+  printf("%-34s %12.1f %12.1f\n", "ns per log line (no redraw)", ref_scroll, new_line);
+  printf("%-34s %12.1f %12.1f\n", "ns per log line (with redraws)", ref_line, new_line);
+  printf("%-34s %12s %12.1f\n", "ns per frame (draw 25x9 chars)", "-", new_frame);
+  for( i = 0; i < sizeof(fps)/sizeof(*fps); i++ )
+  {
+    /* the lines which fit into one second besides fps frames */
+    char name[40];
+    sprintf(name, "log lines/s at %u fps", fps[i]);
+    printf("%-34s %12.0f %12.0f\n", name, 1e9 / ref_line, (1e9 - fps[i]*new_frame) / new_line);
+  }
+
+  if ( errors != 0 )
+    return 1;
+  return 0;
+}
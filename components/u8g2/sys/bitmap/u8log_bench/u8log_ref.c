@@ -0,0 +1,216 @@
+/*
+
+  u8log_ref.c
+
+  u8log.c and u8g2_DrawLog() before the ring of lines and the deferred
+  redraw, reference for u8log_bench
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "u8g2.h"
+
+
+static void ref_u8log_clear_screen(u8log_t *u8log)
+{
+  uint8_t *dest = u8log->screen_buffer;
+  uint16_t cnt = u8log->height;
+  cnt *= u8log->width;
+  do
+  {
+    *dest++ = ' ';
+    cnt--;
+  } while( cnt > 0 );
+  
+}
+
+
+/* scroll the content of the complete buffer, set redraw_line to 255 */
+static void ref_u8log_scroll_up(u8log_t *u8log)
+{
+  uint8_t *dest = u8log->screen_buffer;
+  uint8_t *src = dest+u8log->width;
+  uint16_t cnt = u8log->height;
+  cnt--;
+  cnt *= u8log->width;
+  do
+  {
+    *dest++ = *src++;
+    cnt--;
+  } while( cnt > 0 );
+  cnt = u8log->width;
+  do
+  {
+    *dest++ = ' ';
+    cnt--;
+  } while(cnt > 0);
+  
+  if ( u8log->is_redraw_line_for_each_char )
+    u8log->is_redraw_all = 1;
+  else
+    u8log->is_redraw_all_required_for_next_nl = 1;
+}
+
+/*
+  Place the cursor on the screen. This will also scroll, if required 
+*/
+static void ref_u8log_cursor_on_screen(u8log_t *u8log)
+{
+  //printf("ref_u8log_cursor_on_screen, cursor_y=%d\n", u8log->cursor_y);
+  if ( u8log->cursor_x >= u8log->width )
+  {
+    u8log->cursor_x = 0;
+    u8log->cursor_y++;
+  }
+  while ( u8log->cursor_y >= u8log->height )
+  {
+    ref_u8log_scroll_up(u8log);
+    u8log->cursor_y--;
+  }
+}
+
+/*
+  Write a printable, single char on the screen, do any kind of scrolling
+*/
+static void ref_u8log_write_to_screen(u8log_t *u8log, uint8_t c)
+{
+  ref_u8log_cursor_on_screen(u8log);
+  u8log->screen_buffer[u8log->cursor_y * u8log->width + u8log->cursor_x] = c;
+  u8log->cursor_x++;
+  
+  if ( u8log->is_redraw_line_for_each_char )
+  {
+    u8log->is_redraw_line = 1;
+    u8log->redraw_line = u8log->cursor_y;
+  }
+}
+
+/*
+  Handle control codes or write the char to the screen.
+  Supported control codes are:
+  
+    \n		10		Goto first position of the next line. Line is marked for redraw.
+    \r		13		Goto first position in the same line. Line is marked for redraw.
+    \t		9		Jump to the next tab position
+    \f		12		Clear the screen and mark redraw for whole screen
+    any other char	Write char to screen. Line redraw mark depends on 
+				is_redraw_line_for_each_char flag.
+*/
+void ref_u8log_write_char(u8log_t *u8log, uint8_t c)
+{
+  switch(c)
+  {
+    case '\n':	// 10
+      u8log->is_redraw_line = 1;
+      u8log->redraw_line = u8log->cursor_y;
+      if ( u8log->is_redraw_all_required_for_next_nl )
+	u8log->is_redraw_all = 1;
+      u8log->is_redraw_all_required_for_next_nl = 0;
+      u8log->cursor_y++;
+      u8log->cursor_x = 0;
+      break;	
+    case '\r':	// 13
+      u8log->is_redraw_line = 1;
+      u8log->redraw_line = u8log->cursor_y;
+      u8log->cursor_x = 0;
+      break;
+    case '\t':	// 9
+      u8log->cursor_x = (u8log->cursor_x + 8) & 0xf8;
+      break;
+    case '\f':	// 12
+      ref_u8log_clear_screen(u8log);
+      u8log->is_redraw_all = 1;
+      u8log->cursor_x = 0;
+      u8log->cursor_y = 0;
+      break;
+    default:
+      ref_u8log_write_to_screen(u8log, c);
+      break;
+  }
+}
+
+void ref_u8log_Init(u8log_t *u8log, uint8_t width, uint8_t height, uint8_t *buf)
+{
+  memset(u8log, 0, sizeof(u8log_t));
+  u8log->width = width;
+  u8log->height = height;
+  u8log->screen_buffer = buf;
+  ref_u8log_clear_screen(u8log);
+}
+
+void ref_u8log_SetCallback(u8log_t *u8log, u8log_cb cb, void *aux_data)
+{
+  u8log->cb = cb;
+  u8log->aux_data = aux_data;
+}
+
+void ref_u8log_SetRedrawMode(u8log_t *u8log, uint8_t is_redraw_line_for_each_char)
+{
+  u8log->is_redraw_line_for_each_char = is_redraw_line_for_each_char;
+}
+
+/* offset can be negative or positive, it is 0 by default */
+void ref_u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
+{
+  u8log->line_height_offset = line_height_offset;
+}
+
+
+
+void ref_u8log_WriteChar(u8log_t *u8log, uint8_t c)
+{
+  ref_u8log_write_char(u8log, c);
+  if ( u8log->is_redraw_line || u8log->is_redraw_all )
+  {
+    if ( u8log->cb != 0 )
+    {
+      u8log->cb(u8log);
+    }
+    u8log->is_redraw_line = 0;
+    u8log->is_redraw_all = 0;
+  }
+}
+
+void ref_u8log_WriteString(u8log_t *u8log, const char *s)
+{
+  while( *s != '\0' )
+  {
+    ref_u8log_WriteChar(u8log, *s);
+    s++;
+  }
+}
+
+/*
+  Draw the u8log text at the specified x/y position.
+  x/y position is the reference position of the first char of the first line.
+  the line height is 
+    u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2) + line_height_offset;
+  line_height_offset can be set with ref_u8log_SetLineHeightOffset()
+  Use
+    u8g2_SetFontRefHeightText(u8g2_t *u8g2);
+    u8g2_SetFontRefHeightExtendedText(u8g2_t *u8g2);
+    u8g2_SetFontRefHeightAll(u8g2_t *u8g2);
+  to change the return values for u8g2_GetAscent and u8g2_GetDescent
+
+*/
+void ref_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
+{
+  u8g2_uint_t disp_x, disp_y;
+  uint8_t buf_x, buf_y;
+  uint8_t c;
+  
+  disp_y = y;  
+  u8g2_SetFontDirection(u8g2, 0);
+  for( buf_y = 0; buf_y < u8log->height; buf_y++ )
+  {
+    disp_x = x;
+    for( buf_x = 0; buf_x < u8log->width; buf_x++ )
+    {
+      c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
+      disp_x += u8g2_DrawGlyph(u8g2, disp_x, disp_y, c);
+    }
+    disp_y += u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
+    disp_y += u8log->line_height_offset;
+  }
+}
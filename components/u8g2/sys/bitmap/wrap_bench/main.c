@@ -0,0 +1,177 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Word wrapped track titles with u8g2_LayoutUTF8Box() and u8g2_DrawTextBox()
+ * on the Bitmap device (128x64, U8G2_R0), font: wenquanyi 13px subset.
+ * Checks for all titles, line counts and widths that the lines are in
+ * order, fit into the width and cover the title, and that titles cut
+ * inside a UTF-8 sequence keep only complete glyphs. Then prints the time of
+ * a new layout, of an unchanged layout and of drawing the box each frame,
+ * compared with measuring and drawing the title as one line.
+ */
+
+#include "wqy14_multi.c"
+
+u8g2_t u8g2;
+
+static const char *titles[] =
+{
+  "Symphony No. 9 in D minor, Op. 125 \xe2\x80\x9c" "Choral\xe2\x80\x9d: IV. Presto \xe2\x80\x93 Allegro assai",
+  "\xd0\x9f\xd1\x91\xd1\x82\xd1\x80 \xd0\x98\xd0\xbb\xd1\x8c\xd0\xb8\xd1\x87 \xd0\xa7\xd0\xb0\xd0\xb9\xd0\xba\xd0\xbe\xd0\xb2\xd1\x81\xd0\xba\xd0\xb8\xd0\xb9 \xe2\x80\x93 \xd0\xa9\xd0\xb5\xd0\xbb\xd0\xba\xd1\x83\xd0\xbd\xd1\x87\xd0\xb8\xd0\xba, \xd1\x81\xd0\xbe\xd1\x87. 71",
+  "\xce\x9c\xce\xaf\xce\xba\xce\xb7\xcf\x82 \xce\x98\xce\xb5\xce\xbf\xce\xb4\xcf\x89\xcf\x81\xce\xac\xce\xba\xce\xb7\xcf\x82 \xe2\x80\x93 \xce\xa4\xce\xbf \xcf\x84\xcf\x81\xce\xb1\xce\xb3\xce\xbf\xcf\x8d\xce\xb4\xce\xb9 \xcf\x84\xce\xbf\xcf\x85 \xce\xbd\xce\xb5\xce\xba\xcf\x81\xce\xbf\xcf\x8d",
+  "\xe4\xb9\x85\xe7\x9f\xb3\xe8\xad\xb2 \xe2\x80\x93 \xe5\x8d\x83\xe3\x81\xa8\xe5\x8d\x83\xe5\xb0\x8b\xe3\x81\xae\xe7\xa5\x9e\xe9\x9a\xa0\xe3\x81\x97 \xe3\x81\x82\xe3\x81\xae\xe5\xa4\x8f\xe3\x81\xb8 (Live at Budokan)",
+  "Sigur R\xc3\xb3s \xe2\x80\x93 \xc3\x81ra b\xc3\xa1tur",
+  "Antidisestablishmentarianismfloccinaucinihilipilification",
+};
+#define TITLE_CNT (sizeof(titles)/sizeof(*titles))
+
+static u8g2_text_box_t box;
+
+/* lines in order, only spaces between them, nothing left unless truncated */
+static unsigned check_box(const u8g2_text_box_t *b, u8g2_uint_t max_width, uint8_t max_lines)
+{
+  unsigned errors = 0;
+  uint8_t i, j, pos = 0;
+  const u8g2_text_line_t *l;
+  
+  if ( b->line_cnt > max_lines || b->line_cnt == 0 )
+    errors++;
+  for( i = 0; i < b->line_cnt; i++ )
+  {
+    l = b->line + i;
+    for( j = pos; j < l->start; j++ )
+      if ( b->glyph[j].encoding != ' ' )
+	errors++;
+    if ( l->cnt == 0 || l->width > max_width )
+      errors++;
+    if ( l->suffix == U8G2_TEXT_SUFFIX_ELLIPSIS && i+1 != b->line_cnt )
+      errors++;
+    pos = l->start + l->cnt;
+  }
+  if ( b->line_cnt > 0 && b->line[b->line_cnt-1].suffix != U8G2_TEXT_SUFFIX_ELLIPSIS && pos != b->glyph_cnt )
+    errors++;
+  return errors;
+}
+
+/*
+  titles longer than U8G2_TEXT_BOX_MAX_LEN bytes with the cut before, in
+  and after a UTF-8 sequence: the copy in the box ends before the cut
+  sequence, only complete glyphs are kept, and the same title again keeps
+  its layout
+*/
+static unsigned check_truncation(void)
+{
+  static const char *seqs[] = { "\xc3\xa4", "\xe2\x80\x93", "\xe4\xb9\x85" };	/* ä – 久 */
+  static const uint16_t encodings[] = { 0xe4, 0x2013, 0x4e45 };
+  char s[U8G2_TEXT_BOX_MAX_LEN+8];
+  unsigned errors = 0, i, pad, seq_len, cnt, bytes;
+  uint16_t last;
+
+  for( i = 0; i < sizeof(seqs)/sizeof(*seqs); i++ )
+  {
+    seq_len = strlen(seqs[i]);
+    for( pad = U8G2_TEXT_BOX_MAX_LEN - seq_len - 1; pad <= U8G2_TEXT_BOX_MAX_LEN; pad++ )
+    {
+      /* "aaa...a" seq "b" */
+      memset(s, 'a', pad);
+      strcpy(s + pad, seqs[i]);
+      strcat(s, "b");
+
+      cnt = pad < U8G2_TEXT_BOX_MAX_LEN ? pad : U8G2_TEXT_BOX_MAX_LEN;
+      bytes = cnt;
+      last = 'a';
+      if ( pad + seq_len <= U8G2_TEXT_BOX_MAX_LEN )
+	cnt++, bytes += seq_len, last = encodings[i];
+      if ( pad + seq_len + 1 <= U8G2_TEXT_BOX_MAX_LEN )
+	cnt++, bytes++, last = 'b';
+
+      u8g2_ClearTextBox(&box);
+      u8g2_LayoutUTF8Box(&u8g2, &box, s, 128, 3);
+      if ( strlen(box.str) != bytes || box.glyph_cnt != cnt || box.glyph[box.glyph_cnt-1].encoding != last )
+      {
+	printf("truncation: seq %u, pad %u: %u bytes, %u glyphs, last %04x, expected %u, %u, %04x\n",
+	  i, pad, (unsigned)strlen(box.str), box.glyph_cnt, box.glyph[box.glyph_cnt-1].encoding, bytes, cnt, last);
+	errors++;
+      }
+
+      /* unchanged: the layout is kept, not done again with 0 lines */
+      box.line_cnt = 0;
+      if ( u8g2_LayoutUTF8Box(&u8g2, &box, s, 128, 3) != 0 )
+	errors++;
+    }
+  }
+  return errors;
+}
+
+static void print_box(const u8g2_text_box_t *b)
+{
+  uint8_t i, j;
+  const u8g2_text_line_t *l;
+  for( i = 0; i < b->line_cnt; i++ )
+  {
+    l = b->line + i;
+    printf("  %3u |", l->width);
+    for( j = 0; j < l->cnt; j++ )
+    {
+      uint16_t e = b->glyph[l->start+j].encoding;
+      if ( e < 0x80 ) putchar(e);
+      else if ( e < 0x800 ) { putchar(0xc0 | (e >> 6)); putchar(0x80 | (e & 0x3f)); }
+      else { putchar(0xe0 | (e >> 12)); putchar(0x80 | ((e >> 6) & 0x3f)); putchar(0x80 | (e & 0x3f)); }
+    }
+    printf("%s|\n", l->suffix == U8G2_TEXT_SUFFIX_HYPHEN ? "-" : l->suffix == U8G2_TEXT_SUFFIX_ELLIPSIS ? "\xe2\x80\xa6" : "");
+  }
+}
+
+/* best of 20 rounds */
+#define BENCH(name, n, ...) \
+  do { \
+    double ns; \
+    BENCH_NS(ns, 20, n, __VA_ARGS__); \
+    printf("%-40s %10.1f\n", name, ns); \
+  } while(0)
+
+int main(void)
+{
+  unsigned t, errors = 0;
+  uint8_t lines;
+  u8g2_uint_t width;
+  volatile u8g2_uint_t sink;
+  
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, 128, 64);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_SetFont(&u8g2, wqy14_multi);
+  
+  for( t = 0; t < TITLE_CNT; t++ )
+    for( lines = 1; lines <= 4; lines++ )
+      for( width = 40; width <= 128; width += 4 )
+      {
+	u8g2_LayoutUTF8Box(&u8g2, &box, titles[t], width, lines);
+	errors += check_box(&box, width, lines);
+      }
+  
+  errors += check_truncation();
+  
+  for( t = 0; t < TITLE_CNT; t++ )
+  {
+    u8g2_LayoutUTF8Box(&u8g2, &box, titles[t], 128, 3);
+    print_box(&box);
+    printf("\n");
+  }
+  printf("%u errors\n\n", errors);
+  
+  printf("%-40s %10s\n", "ns, 128 pixel, 3 lines", "");
+  BENCH("new layout, 6 titles", 2000, 
+    for( t = 0; t < TITLE_CNT; t++ ) { u8g2_ClearTextBox(&box); u8g2_LayoutUTF8Box(&u8g2, &box, titles[t], 128, 3); });
+  BENCH("unchanged layout, 6 titles", 20000, 
+    for( t = 0; t < TITLE_CNT; t++ ) { u8g2_LayoutUTF8Box(&u8g2, &box, titles[3], 128, 3); });
+  u8g2_LayoutUTF8Box(&u8g2, &box, titles[0], 128, 3);
+  BENCH("DrawTextBox, 3 lines", 2000, 
+    u8g2_DrawTextBox(&u8g2, 0, 14, 16, &box, U8G2_TEXT_ALIGN_CENTER));
+  BENCH("GetUTF8Width + DrawUTF8, 1 line", 2000, 
+    sink = u8g2_GetUTF8Width(&u8g2, titles[0]); u8g2_DrawUTF8(&u8g2, (128 - sink) / 2, 14, titles[0]));
+  (void)sink;
+  return errors != 0;
+}
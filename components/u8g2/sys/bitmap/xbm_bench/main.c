@@ -0,0 +1,231 @@
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*
+ * Checks and benchmarks u8g2_DrawXBM, u8g2_DrawXBMP and u8g2_DrawTileBitmap
+ * on the Bitmap device (128x64, U8G2_R0, vertical top memory layout as
+ * used by the SSD1306).
+ *
+ * 1. Random bitmaps must give the same buffer as the previous pixel by
+ *    pixel u8g2_DrawXBM() (u8g2_DrawHXBM). The previous path is used if
+ *    ll_hvline is not u8g2_ll_hvline_vertical_top_lsb, so the reference
+ *    draws through a wrapper of it. Checked are XBM, XBMP and the same
+ *    bitmap in tile layout (band combine and pixel by pixel), draw colors
+ *    0/1/2, solid and transparent mode, with and without clip window,
+ *    positions partly outside of the display, full buffer and a one tile
+ *    row page buffer.
+ * 2. Pixels per microsecond for icon and splash sizes.
+ */
+
+#define W 128
+#define H 64
+#define CHECK_SCENES 50000
+#define MAX_BM_W 64
+#define MAX_BM_H 40
+
+u8g2_t u8g2;
+u8g2_t u8g2_page;
+uint8_t page_buf[W];
+
+static uint8_t bitmap[128*64/8];
+
+enum { DRAW_REF, DRAW_XBM, DRAW_XBMP, DRAW_TILE, DRAW_TILE_PIXEL, DRAW_CNT };
+static const char *draw_names[DRAW_CNT] = { "ref", "XBM", "XBMP", "tile", "tile pixel" };
+
+struct scene
+{
+  u8g2_uint_t x, y, w, h;
+  uint8_t color;
+  uint8_t is_transparent;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+};
+
+static uint8_t xbm[(MAX_BM_W+7)/8*MAX_BM_H];
+static uint8_t tile[(MAX_BM_H+7)/8*MAX_BM_W];
+static uint8_t background[H/8*W];
+static uint8_t expect[H/8*W];
+static uint8_t frame[H/8*W];
+
+static int rnd(int lo, int hi)
+{
+  return lo + rand() % (hi - lo + 1);
+}
+
+/* same pixels as u8g2_ll_hvline_vertical_top_lsb, but the bitmap blit is not used */
+static void ref_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_ll_hvline_vertical_top_lsb(u8g2, x, y, len, dir);
+}
+
+/* the XBM bitmap in tile layout: bit r&7 of byte (r/8)*w+c is pixel c,r */
+static void xbm_to_tile(u8g2_uint_t w, u8g2_uint_t h)
+{
+  unsigned r, c, blen = (w + 7) / 8;
+
+  memset(tile, 0, sizeof(tile));
+  for( r = 0; r < h; r++ )
+    for( c = 0; c < w; c++ )
+      if ( xbm[r*blen + c/8] & (1 << (c & 7)) )
+	tile[(r/8)*w + c] |= 1 << (r & 7);
+}
+
+static void random_scene(struct scene *s)
+{
+  unsigned i;
+
+  s->w = rnd(1, MAX_BM_W);
+  s->h = rnd(1, MAX_BM_H);
+  s->x = rnd(-MAX_BM_W-4, W+4);
+  s->y = rnd(-MAX_BM_H-4, H+4);
+  s->color = rand() % 3;
+  s->is_transparent = rand() % 2;
+  s->is_clip = rand() % 4 == 0;
+  s->clip_x0 = rnd(0, W-1); s->clip_x1 = rnd(s->clip_x0+1, W);
+  s->clip_y0 = rnd(0, H-1); s->clip_y1 = rnd(s->clip_y0+1, H);
+  for( i = 0; i < sizeof(xbm); i++ )
+    xbm[i] = rand();
+  xbm_to_tile(s->w, s->h);
+  for( i = 0; i < sizeof(background); i++ )
+    background[i] = rand();
+}
+
+static void draw(u8g2_t *u8g2, const struct scene *s, unsigned how)
+{
+  u8g2->ll_hvline = how == DRAW_REF || how == DRAW_TILE_PIXEL ? ref_hvline : u8g2_ll_hvline_vertical_top_lsb;
+  u8g2_SetDrawColor(u8g2, s->color);
+  u8g2_SetBitmapMode(u8g2, s->is_transparent);
+  if ( s->is_clip )
+    u8g2_SetClipWindow(u8g2, s->clip_x0, s->clip_y0, s->clip_x1, s->clip_y1);
+  else
+    u8g2_SetMaxClipWindow(u8g2);
+  if ( how == DRAW_REF || how == DRAW_XBM )
+    u8g2_DrawXBM(u8g2, s->x, s->y, s->w, s->h, xbm);
+  else if ( how == DRAW_XBMP )
+    u8g2_DrawXBMP(u8g2, s->x, s->y, s->w, s->h, xbm);
+  else
+    u8g2_DrawTileBitmap(u8g2, s->x, s->y, s->w, s->h, tile);
+}
+
+static void render_full(const struct scene *s, unsigned how)
+{
+  uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+
+  memcpy(buf, background, sizeof(background));
+  draw(&u8g2, s, how);
+  memcpy(frame, buf, sizeof(frame));
+}
+
+static void render_pages(const struct scene *s, unsigned how)
+{
+  int row;
+
+  for( row = 0; row < H/8; row++ )
+  {
+    u8g2_SetBufferCurrTileRow(&u8g2_page, row);
+    memcpy(page_buf, background + row*W, W);
+    draw(&u8g2_page, s, how);
+    memcpy(frame + row*W, page_buf, W);
+  }
+}
+
+static void render(const struct scene *s, unsigned how, unsigned is_page)
+{
+  if ( is_page )
+    render_pages(s, how);
+  else
+    render_full(s, how);
+}
+
+static unsigned check_previous(void)
+{
+  struct scene s;
+  unsigned i, how, is_page, errors = 0;
+
+  for( i = 0; i < CHECK_SCENES; i++ )
+  {
+    random_scene(&s);
+    for( is_page = 0; is_page < 2; is_page++ )
+    {
+      render(&s, DRAW_REF, is_page);
+      memcpy(expect, frame, sizeof(frame));
+      for( how = DRAW_XBM; how < DRAW_CNT; how++ )
+      {
+	render(&s, how, is_page);
+	if ( memcmp(frame, expect, sizeof(frame)) != 0 )
+	{
+	  if ( errors < 5 )
+	    printf("difference: scene %u, %s, %d,%d %ux%u, color %u, transparent %u, clip %u, page %u\n",
+	      i, draw_names[how], (int8_t)s.x, (int8_t)s.y, s.w, s.h, s.color, s.is_transparent, s.is_clip, is_page);
+	  errors++;
+	}
+      }
+    }
+  }
+  u8g2.ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+  u8g2_SetMaxClipWindow(&u8g2);
+  u8g2_SetDrawColor(&u8g2, 1);
+  printf("%u scenes, XBM, XBMP, tile, tile pixel, full and page buffer: %u differences\n\n", CHECK_SCENES, errors);
+  return errors;
+}
+
+/*==========================================*/
+/* benchmark */
+
+struct bench
+{
+  const char *name;
+  u8g2_uint_t x, y, w, h;
+  uint8_t is_tile;
+  uint8_t is_transparent;
+};
+
+static const struct bench benches[] =
+{
+  { "xbm splash 128x64", 0, 0, 128, 64, 0, 0 },
+  { "xbm icon 16x16 aligned", 40, 16, 16, 16, 0, 0 },
+  { "xbm icon 16x16 unaligned", 40, 19, 16, 16, 0, 0 },
+  { "xbm icon 16x16 transparent", 40, 19, 16, 16, 0, 1 },
+  { "xbm icon 12x10", 7, 3, 12, 10, 0, 0 },
+  { "tile splash 128x64", 0, 0, 128, 64, 1, 0 },
+  { "tile icon 16x16 aligned", 40, 16, 16, 16, 1, 0 },
+  { "tile icon 16x16 unaligned", 40, 19, 16, 16, 1, 0 },
+};
+
+int main(void)
+{
+  const struct bench *b;
+  unsigned i, n, errors = 0;
+  double ns;
+
+  u8g2_SetupBitmap(&u8g2, &u8g2_cb_r0, W, H);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_ClearBuffer(&u8g2);
+
+  u8x8_SetupBitmap(u8g2_GetU8x8(&u8g2_page), W, H);
+  u8g2_SetupBuffer(&u8g2_page, page_buf, 1, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2_page));
+
+  errors += check_previous();
+
+  u8g2_ClearBuffer(&u8g2);
+  for( i = 0; i < sizeof(bitmap); i++ )
+    bitmap[i] = rand();
+
+  printf("%-28s %12s %12s\n", "bitmap", "ns/call", "pixel/us");
+  for( b = benches; b < benches + sizeof(benches)/sizeof(*benches); b++ )
+  {
+    u8g2_SetBitmapMode(&u8g2, b->is_transparent);
+    n = 4000000 / (b->w * b->h) + 1000;
+    if ( b->is_tile )
+      BENCH_NS(ns, 5, n, u8g2_DrawTileBitmap(&u8g2, b->x, b->y, b->w, b->h, bitmap));
+    else
+      BENCH_NS(ns, 5, n, u8g2_DrawXBM(&u8g2, b->x, b->y, b->w, b->h, bitmap));
+    printf("%-28s %12.1f %12.1f\n", b->name, ns, b->w * b->h * 1e3 / ns);
+  }
+  u8g2_SetBitmapMode(&u8g2, 0);
+  return errors != 0;
+}
@@ -708,6 +708,7 @@ bf_t *bf_OpenFromFile(const char *bdf_filename, int is_verbose, int bbx_mode, co
   {
     bf->tile_h_size = th;
     bf->tile_v_size = tv;
+    bf->is_glyph_index = (font_format == 3);
     
     if ( bf_ParseFile(bf, bdf_filename) != 0 )
     {
@@ -734,7 +735,7 @@ bf_t *bf_OpenFromFile(const char *bdf_filename, int is_verbose, int bbx_mode, co
       bf_CalculateMaxBitFieldSize(bf);  
       
       
-      if ( font_format == 0 || font_format == 1 )
+      if ( font_format == 0 || font_format == 1 || font_format == 3 )
       {
 	bf_RLECompressAllGlyphs(bf);
       }
@@ -82,6 +82,8 @@ struct _bdf_font_struct
   int target_cnt;
   
 
+  int is_glyph_index;	/* font format 3: append a direct glyph index to the u8g2 font */
+
   int tile_h_size;	// new 2019 8x8 font format
   int tile_v_size;	// new 2019 8x8 font format
 };
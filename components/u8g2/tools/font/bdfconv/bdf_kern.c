@@ -6,6 +6,8 @@
 
 #include "bdf_font.h"
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define BDF_KERNING_MAX (1024*60)
 
@@ -73,6 +75,31 @@ static void bdf_write_uint8_array(FILE *fp, const char *pre, const char *post, u
 }
 
 
+/*
+  all pairs as one table for u8g2_DrawExtUTF8(): 
+  0x0fffe (U8G2_KERNING_SORTED_TABLE), number of pairs, 
+  triples sorted by first and second encoding, 0x0ffff
+*/
+static void bdf_write_sorted_kerning_table(FILE *fp, const char *name)
+{
+  uint16_t i1, i2, n;
+  
+  fprintf(fp, "const uint16_t %s_kt[%u] = {\n", name, bdf_second_table_cnt*3 + 3);
+  fprintf(fp, "  0x0fffe, %u,\n", bdf_second_table_cnt);
+  n = 0;
+  for( i1 = 0; i1+1 < bdf_first_table_cnt; i1++ )
+  {
+    for( i2 = bdf_index_to_second_table[i1]; i2 < bdf_index_to_second_table[i1+1]; i2++ )
+    {
+      fprintf(fp, "%s%u, %u, %u", n % 4 == 0 ? "  " : " ", 
+	bdf_first_encoding_table[i1], bdf_second_encoding_table[i2], bdf_kerning_values[i2]);
+      n++;
+      fprintf(fp, "%s", n % 4 == 0 ? ",\n" : ",");
+    }
+  }
+  fprintf(fp, "%s0x0ffff};\n\n", n % 4 == 0 ? "  " : " ");
+}
+
 void bdf_write_kerning_file(const char *kernfile, const char *name)
 {
   FILE *fp;
@@ -91,6 +118,8 @@ void bdf_write_kerning_file(const char *kernfile, const char *name)
   fprintf(fp, "  %s_%s,\n", name, "index_to_second_table");
   fprintf(fp, "  %s_%s,\n", name, "second_encoding_table");
   fprintf(fp, "  %s_%s};\n\n", name, "kerning_values");
+  
+  bdf_write_sorted_kerning_table(fp, name);
   fclose(fp);
 }
 
@@ -156,11 +185,23 @@ unsigned bdf_calculate_kerning(uint8_t *font, uint16_t e1, uint16_t e2, uint8_t
   return kerning;
 }
 
+static int bdf_kern_compare_encoding(const void *a, const void *b)
+{
+  const bg_t *ga = *(const bg_t **)a;
+  const bg_t *gb = *(const bg_t **)b;
+  if ( ga->encoding < gb->encoding )
+    return -1;
+  if ( ga->encoding > gb->encoding )
+    return 1;
+  return 0;
+}
+
 void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontname, uint8_t min_distance_in_per_cent_of_char_width)
 {
   int first, second;
   bg_t *bg_first;
   bg_t *bg_second;
+  bg_t **glyph_list;
   uint8_t kerning;
   int is_first_encoding_added;
 
@@ -168,15 +209,21 @@ void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontn
   bdf_first_table_cnt = 0;
   bdf_second_table_cnt = 0;
   
+  /* u8g2_GetKerning() does a binary search, so the tables are written in the order of the encoding */
+  glyph_list = (bg_t **)malloc(bf->glyph_cnt*sizeof(bg_t *));
+  assert(glyph_list != NULL);
+  memcpy(glyph_list, bf->glyph_list, bf->glyph_cnt*sizeof(bg_t *));
+  qsort(glyph_list, bf->glyph_cnt, sizeof(bg_t *), bdf_kern_compare_encoding);
+  
   for( first= 0; first < bf->glyph_cnt; first++ )
   {
     is_first_encoding_added = 0;
-    bg_first = bf->glyph_list[first];
+    bg_first = glyph_list[first];
     if ( bg_first->target_data != NULL && bg_first->is_excluded_from_kerning == 0 )
     {
       for( second= 0; second < bf->glyph_cnt; second++ )
       {
-        bg_second = bf->glyph_list[second];
+        bg_second = glyph_list[second];
         if ( bg_second->target_data != NULL && bg_second->is_excluded_from_kerning == 0 )
         {
           kerning = bdf_calculate_kerning(bf->target_data, bg_first->encoding, bg_second->encoding, min_distance_in_per_cent_of_char_width);
@@ -190,6 +237,7 @@ void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontn
 	      if (bdf_first_table_cnt > BDF_KERNING_MAX)
 	      {
 		      fprintf(stderr, "Kerning calculation aborted: bdf_first_table_cnt > BDF_KERNING_MAX\n");
+		      free(glyph_list);
 		      return;
 	      }
 	      is_first_encoding_added = 1;
@@ -200,6 +248,7 @@ void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontn
 	    if (bdf_second_table_cnt > BDF_KERNING_MAX)
 	    {
 		      fprintf(stderr, "Kerning calculation aborted: bdf_second_table_cnt > BDF_KERNING_MAX\n");
+		      free(glyph_list);
 		      return;
 	    }
 	  }
@@ -211,6 +260,7 @@ void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontn
   bdf_first_encoding_table[bdf_first_table_cnt] = 0x0ffff;
   bdf_index_to_second_table[bdf_first_table_cnt]  = bdf_second_table_cnt;
   bdf_first_table_cnt++;
+  free(glyph_list);
   
   bdf_write_kerning_file(filename, fontname);
 }
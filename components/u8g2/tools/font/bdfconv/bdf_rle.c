@@ -59,6 +59,25 @@
 
 #define UNICODE_GLYPHS_PER_LOOKUP_TABLE_ENTRY 100
 
+/*
+  font format 3: glyph index
+
+  bbx_mode (offset 1) has bit 7 set.
+  The first glyph record is a dummy record which is skipped by the linear search:
+    0		1		encoding 0
+    1		1		record size 5
+    2		3		position of the glyph index, relative to BDF_RLE_FONT_GLYPH_START, high byte first
+  The glyph index is appended after the unicode end marker:
+    0		1		first ASCII encoding
+    1		1		last ASCII encoding (smaller than first encoding if there are no ASCII glyphs)
+    2		2*n		position of each ASCII glyph record from first to last encoding, 0 if missing
+    ...		2		number of unicode glyphs m
+    ...		3*m		position of each unicode glyph record, sorted by encoding
+  All positions are relative to BDF_RLE_FONT_GLYPH_START, high byte first.
+*/
+#define BDF_RLE_BBX_MODE_GLYPH_INDEX 0x80
+#define BDF_RLE_GLYPH_INDEX_RECORD_SIZE 5
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -655,6 +674,12 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   unsigned unicode_lookup_table_pos;
   unsigned unicode_lookup_table_glyph_cnt;
   
+  unsigned ascii_glyph_pos[256];	/* glyph index: record positions, 0 if not available */
+  uint32_t *unicode_glyph_pos = NULL;
+  unsigned unicode_glyph_cnt = 0;
+  unsigned ascii_first, ascii_last;
+  uint32_t glyph_index_pos;
+  
   idx_cap_a_ascent = 0;
   idx_cap_a = bf_GetIndexByEncoding(bf, 'A');
   if ( idx_cap_a >= 0 )
@@ -729,7 +754,10 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   
   /* 0 */
   bf_AddTargetData(bf, bf->selected_glyphs);
-  bf_AddTargetData(bf, bf->bbx_mode);
+  if ( bf->is_glyph_index )
+    bf_AddTargetData(bf, bf->bbx_mode | BDF_RLE_BBX_MODE_GLYPH_INDEX);
+  else
+    bf_AddTargetData(bf, bf->bbx_mode);
   bf_AddTargetData(bf, best_rle_0);
   bf_AddTargetData(bf, best_rle_1);
 
@@ -769,6 +797,25 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   bf_AddTargetData(bf, 0);	/* start pos unicode, high/low */
   bf_AddTargetData(bf, 0);
 
+  if ( bf->is_glyph_index )
+  {
+    /* dummy record, the glyph index position is filled in later */
+    bf_AddTargetData(bf, 0);
+    bf_AddTargetData(bf, BDF_RLE_GLYPH_INDEX_RECORD_SIZE);
+    bf_AddTargetData(bf, 0);
+    bf_AddTargetData(bf, 0);
+    bf_AddTargetData(bf, 0);
+    
+    for( i = 0; i < 256; i++ )
+      ascii_glyph_pos[i] = 0;
+    unicode_glyph_pos = (uint32_t *)malloc(sizeof(uint32_t)*(bf->selected_glyphs+1));
+    if ( unicode_glyph_pos == NULL )
+    {
+      bf_Error(bf, "RLE Compress: Error, out of memory for the glyph index");
+      exit(1);
+    }
+  }
+
   /* assumes, that map_to is sorted */
 
   ascii_glyphs = 0;
@@ -786,6 +833,8 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
 	  exit(1);
 	}
 
+	if ( bf->is_glyph_index )
+	  ascii_glyph_pos[bg->map_to] = bf->target_cnt-BDF_RLE_FONT_GLYPH_START;
 	for( j = 0; j < bg->target_cnt; j++ )
 	{
 	  bf_AddTargetData(bf, bg->target_data[j]);
@@ -845,6 +894,8 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
 	  exit(1);
 	}
 
+	if ( bf->is_glyph_index )
+	  unicode_glyph_pos[unicode_glyph_cnt++] = bf->target_cnt-BDF_RLE_FONT_GLYPH_START;
 	for( j = 0; j < bg->target_cnt; j++ )
 	{
 	  bf_AddTargetData(bf, bg->target_data[j]);
@@ -910,6 +961,52 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   
   bf_Log(bf, "RLE Compress: 'A' pos = %u, 'a' pos = %u", bf_RLE_get_glyph_data(bf, 'A'), bf_RLE_get_glyph_data(bf, 'a'));
   
+  if ( bf->is_glyph_index )
+  {
+    glyph_index_pos = bf->target_cnt-BDF_RLE_FONT_GLYPH_START;
+    if ( glyph_index_pos > 0x0ffffffUL )
+    {
+      bf_Error(bf, "RLE Compress: Error, font too large for the glyph index");
+      exit(1);
+    }
+    bf->target_data[BDF_RLE_FONT_GLYPH_START+2] = glyph_index_pos >> 16;
+    bf->target_data[BDF_RLE_FONT_GLYPH_START+3] = (glyph_index_pos >> 8) & 255;
+    bf->target_data[BDF_RLE_FONT_GLYPH_START+4] = glyph_index_pos & 255;
+    
+    ascii_first = 1;
+    ascii_last = 0;
+    for( i = 0; i < 256; i++ )
+    {
+      if ( ascii_glyph_pos[i] != 0 )
+      {
+	if ( ascii_first > ascii_last )
+	  ascii_first = i;
+	ascii_last = i;
+      }
+    }
+    bf_AddTargetData(bf, ascii_first);
+    bf_AddTargetData(bf, ascii_last);
+    for( i = ascii_first; i <= (int)ascii_last; i++ )
+    {
+      bf_AddTargetData(bf, ascii_glyph_pos[i] >> 8);
+      bf_AddTargetData(bf, ascii_glyph_pos[i] & 255);
+    }
+    
+    bf_AddTargetData(bf, unicode_glyph_cnt >> 8);
+    bf_AddTargetData(bf, unicode_glyph_cnt & 255);
+    for( i = 0; i < (int)unicode_glyph_cnt; i++ )
+    {
+      bf_AddTargetData(bf, unicode_glyph_pos[i] >> 16);
+      bf_AddTargetData(bf, (unicode_glyph_pos[i] >> 8) & 255);
+      bf_AddTargetData(bf, unicode_glyph_pos[i] & 255);
+    }
+    free(unicode_glyph_pos);
+    
+    bf_Log(bf, "RLE Compress: Glyph index pos = %lu, ASCII %u-%u, unicode glyphs=%u, index size %lu", 
+      (unsigned long)glyph_index_pos, ascii_first, ascii_last, unicode_glyph_cnt, 
+      (unsigned long)(bf->target_cnt-BDF_RLE_FONT_GLYPH_START-glyph_index_pos));
+  }
+  
   bf_Log(bf, "RLE Compress: Font size %d", bf->target_cnt);
   
 }
@@ -131,7 +131,8 @@ void help(void)
   printf("-h          Display this help\n");
   printf("-v          Print log messages\n");
   printf("-b <n>      Font build mode, 0: proportional, 1: common height, 2: monospace, 3: multiple of 8\n");
-  printf("-f <n>      Font format, 0: ucglib font, 1: u8g2 font, 2: u8g2 uncompressed 8x8 font (enforces -b 3)\n");
+  printf("-f <n>      Font format, 0: ucglib font, 1: u8g2 font, 2: u8g2 uncompressed 8x8 font (enforces -b 3),\n");
+  printf("            3: u8g2 font with glyph index (faster glyph lookup, larger font)\n");
   printf("-m 'map'    Unicode ASCII mapping\n");
   printf("-M 'mapfile'    Read Unicode ASCII mapping from file 'mapname'\n");
   printf("-o <file>   C output font file\n");
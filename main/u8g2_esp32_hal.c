@@ -4,6 +4,9 @@
 #include "sdkconfig.h"
 #include "esp_log.h"
 
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -13,9 +16,27 @@ static const char *TAG = "u8g2_hal";
 static const unsigned int I2C_TIMEOUT_MS = 1000;
 
 static spi_device_handle_t handle_spi;      // SPI handle.
-static i2c_cmd_handle_t    handle_i2c;      // I2C handle.
 static u8g2_esp32_hal_t    u8g2_esp32_hal;  // HAL state data.
 
+// SPI transactions are queued, the bytes are copied to a DMA capable
+// staging buffer and the descriptors stay valid until the result is fetched.
+static spi_transaction_t   spi_trans[U8G2_ESP32_SPI_QUEUE_SIZE];
+static size_t              spi_trans_next;       // Descriptor for the next transaction
+static size_t              spi_trans_in_flight;  // Queued, result not fetched yet
+static uint8_t            *spi_staging;          // U8G2_ESP32_SPI_STAGING_SIZE bytes
+static size_t              spi_staging_used;     // Bytes of queued and collected transactions
+static size_t              spi_pending_start;    // First byte of the transaction being collected
+static int                 spi_dc;               // DC level of the transaction being collected
+
+// I2C transfers are collected here between START_TRANSFER and END_TRANSFER
+// and then written to the bus with a single multi-byte write.
+static uint8_t             i2c_transfer_buf[I2C_MASTER_TRANSFER_BUF_SIZE];
+static size_t              i2c_transfer_len;
+// U8X8_MSG_BYTE_SEND_LARGE data is not copied, it is written from the caller's
+// memory (e.g. the whole frame) after the collected bytes.
+static uint8_t            *i2c_large_ptr;
+static size_t              i2c_large_len;
+
 #undef ESP_ERROR_CHECK
 #define ESP_ERROR_CHECK(x)   do { esp_err_t rc = (x); if (rc != ESP_OK) { ESP_LOGE("err", "esp_err_t = %d", rc); assert(0 && #x);} } while(0);
 
@@ -26,16 +47,112 @@ void u8g2_esp32_hal_init(u8g2_esp32_hal_t u8g2_esp32_hal_param) {
 	u8g2_esp32_hal = u8g2_esp32_hal_param;
 } // u8g2_esp32_hal_init
 
+/*
+ * Runs in the SPI interrupt before each transaction, the DC level of the
+ * transaction is in its user field.
+ */
+static void IRAM_ATTR u8g2_esp32_spi_pre_transfer_cb(spi_transaction_t *trans) {
+	if (u8g2_esp32_hal.dc != U8G2_ESP32_HAL_UNDEFINED) {
+		gpio_set_level(u8g2_esp32_hal.dc, (int)(intptr_t)trans->user);
+	}
+} // u8g2_esp32_spi_pre_transfer_cb
+
+/*
+ * Fetch the result of the oldest queued transaction, waiting for it if
+ * block is set.  Returns false if it has not completed yet.
+ */
+static bool u8g2_esp32_spi_reclaim(bool block) {
+	spi_transaction_t *done;
+	if (spi_trans_in_flight == 0) {
+		return false;
+	}
+	if (spi_device_get_trans_result(handle_spi, &done, block ? portMAX_DELAY : 0) != ESP_OK) {
+		return false;
+	}
+	spi_trans_in_flight--;
+	return true;
+} // u8g2_esp32_spi_reclaim
+
+/*
+ * Nothing collected or queued any more: start over at the beginning of the staging buffer.
+ */
+static void u8g2_esp32_spi_rewind(void) {
+	if (spi_trans_in_flight == 0 && spi_pending_start == spi_staging_used) {
+		spi_staging_used = 0;
+		spi_pending_start = 0;
+	}
+} // u8g2_esp32_spi_rewind
+
+/*
+ * Queue the collected bytes as one transaction.
+ */
+static void u8g2_esp32_spi_queue_pending(void) {
+	size_t len = spi_staging_used - spi_pending_start;
+	spi_transaction_t *trans;
+
+	if (len == 0) {
+		return;
+	}
+	if (spi_trans_in_flight == U8G2_ESP32_SPI_QUEUE_SIZE) {
+		u8g2_esp32_spi_reclaim(true);
+	}
+	// Transactions complete in order, so the descriptor after the newest one is free
+	trans = &spi_trans[spi_trans_next];
+	spi_trans_next = (spi_trans_next + 1) % U8G2_ESP32_SPI_QUEUE_SIZE;
+	memset(trans, 0, sizeof(spi_transaction_t));
+	trans->length    = 8 * len; // Number of bits NOT number of bytes.
+	trans->tx_buffer = spi_staging + spi_pending_start;
+	trans->user      = (void *)(intptr_t)spi_dc;
+	ESP_ERROR_CHECK(spi_device_queue_trans(handle_spi, trans, portMAX_DELAY));
+	spi_trans_in_flight++;
+
+	// The next transaction starts word aligned for the DMA
+	spi_staging_used = (spi_staging_used + 3) & ~(size_t)3;
+	spi_pending_start = spi_staging_used;
+} // u8g2_esp32_spi_queue_pending
+
+/*
+ * Copy bytes to the staging buffer.  The caller's memory may be reused
+ * as soon as this returns, the queued copy stays untouched until sent.
+ */
+static void u8g2_esp32_spi_collect(const uint8_t *data, size_t len) {
+	size_t cnt;
+
+	while (spi_pending_start == spi_staging_used && u8g2_esp32_spi_reclaim(false)) {
+	}
+	u8g2_esp32_spi_rewind();
+	while (len > 0) {
+		if (spi_staging_used == U8G2_ESP32_SPI_STAGING_SIZE) {
+			// Full: queue what is collected and start over once the bus is idle
+			u8g2_esp32_spi_queue_pending();
+			while (u8g2_esp32_spi_reclaim(true)) {
+			}
+			u8g2_esp32_spi_rewind();
+		}
+		cnt = U8G2_ESP32_SPI_STAGING_SIZE - spi_staging_used;
+		if (cnt > len) {
+			cnt = len;
+		}
+		memcpy(spi_staging + spi_staging_used, data, cnt);
+		spi_staging_used += cnt;
+		data += cnt;
+		len -= cnt;
+	}
+} // u8g2_esp32_spi_collect
+
 /*
  * HAL callback function as prescribed by the U8G2 library.  This callback is invoked
- * to handle SPI communications.
+ * to handle SPI communications.  Bytes with the same DC level are collected and
+ * queued as one DMA transaction, the callback does not wait for the bus.
  */
 uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
 	ESP_LOGD(TAG, "spi_byte_cb: Received a msg: %d, arg_int: %d, arg_ptr: %p", msg, arg_int, arg_ptr);
 	switch(msg) {
 		case U8X8_MSG_BYTE_SET_DC:
-			if (u8g2_esp32_hal.dc != U8G2_ESP32_HAL_UNDEFINED) {
-				gpio_set_level(u8g2_esp32_hal.dc, arg_int);
+			// Applied by the pre transfer callback when the transaction starts
+			if (arg_int != spi_dc) {
+				u8g2_esp32_spi_queue_pending();
+				spi_dc = arg_int;
 			}
 			break;
 
@@ -46,6 +163,9 @@ uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 				break;
 			}
 
+			spi_staging = heap_caps_malloc(U8G2_ESP32_SPI_STAGING_SIZE, MALLOC_CAP_DMA);
+			assert(spi_staging != NULL);
+
 		  spi_bus_config_t bus_config;
                   memset(&bus_config, 0, sizeof(spi_bus_config_t));
 		  bus_config.sclk_io_num   = u8g2_esp32_hal.clk; // CLK
@@ -53,47 +173,86 @@ uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 		  bus_config.miso_io_num   = -1; // MISO
 		  bus_config.quadwp_io_num = -1; // Not used
 		  bus_config.quadhd_io_num = -1; // Not used
+		  bus_config.max_transfer_sz = U8G2_ESP32_SPI_STAGING_SIZE;
 		  //ESP_LOGI(TAG, "... Initializing bus.");
 		  ESP_ERROR_CHECK(spi_bus_initialize(HSPI_HOST, &bus_config, 1));
 
 		  spi_device_interface_config_t dev_config;
+		  memset(&dev_config, 0, sizeof(spi_device_interface_config_t));
 		  dev_config.address_bits     = 0;
 		  dev_config.command_bits     = 0;
 		  dev_config.dummy_bits       = 0;
-		  dev_config.mode             = 0;
+		  dev_config.mode             = u8x8->display_info->spi_mode;
 		  dev_config.duty_cycle_pos   = 0;
 		  dev_config.cs_ena_posttrans = 0;
 		  dev_config.cs_ena_pretrans  = 0;
-		  dev_config.clock_speed_hz   = 10000;
+		  dev_config.clock_speed_hz   = u8g2_esp32_hal.spi_clock_hz != 0 ? u8g2_esp32_hal.spi_clock_hz : u8x8->display_info->sck_clock_hz;
 		  dev_config.spics_io_num     = u8g2_esp32_hal.cs;
 		  dev_config.flags            = 0;
-		  dev_config.queue_size       = 200;
-		  dev_config.pre_cb           = NULL;
+		  dev_config.queue_size       = U8G2_ESP32_SPI_QUEUE_SIZE;
+		  dev_config.pre_cb           = u8g2_esp32_spi_pre_transfer_cb;
 		  dev_config.post_cb          = NULL;
 		  //ESP_LOGI(TAG, "... Adding device bus.");
 		  ESP_ERROR_CHECK(spi_bus_add_device(HSPI_HOST, &dev_config, &handle_spi));
+		  ESP_LOGI(TAG, "spi clock %d Hz", dev_config.clock_speed_hz);
 
+		  // Displays may send a whole frame with U8X8_MSG_BYTE_SEND_LARGE
+		  u8x8_SetByteMaxLargeTransfer(u8x8, U8G2_ESP32_SPI_STAGING_SIZE);
 		  break;
 		}
 
-		case U8X8_MSG_BYTE_SEND: {
-			spi_transaction_t trans_desc;
-			trans_desc.addr      = 0;
-			trans_desc.cmd   	 = 0;
-			trans_desc.flags     = 0;
-			trans_desc.length    = 8 * arg_int; // Number of bits NOT number of bytes.
-			trans_desc.rxlength  = 0;
-			trans_desc.tx_buffer = arg_ptr;
-			trans_desc.rx_buffer = NULL;
-
-			//ESP_LOGI(TAG, "... Transmitting %d bytes.", arg_int);
-			ESP_ERROR_CHECK(spi_device_transmit(handle_spi, &trans_desc));
+		case U8X8_MSG_BYTE_SEND:
+			u8g2_esp32_spi_collect((uint8_t *)arg_ptr, arg_int);
+			break;
+
+		case U8X8_MSG_BYTE_SEND_LARGE: {
+			u8x8_large_data_t* large = (u8x8_large_data_t*)arg_ptr;
+			u8g2_esp32_spi_collect(large->data, large->cnt);
 			break;
 		}
+
+		case U8X8_MSG_BYTE_END_TRANSFER:
+			u8g2_esp32_spi_queue_pending();
+			break;
 	}
 	return 0;
 } // u8g2_esp32_spi_byte_cb
 
+/*
+ * Wait until everything sent to the display has left the bus.
+ * I2C transfers are written synchronously, so only SPI has to wait.
+ */
+void u8g2_esp32_hal_wait_done(void) {
+	if (handle_spi == NULL) {
+		return;
+	}
+	u8g2_esp32_spi_queue_pending();
+	while (u8g2_esp32_spi_reclaim(true)) {
+	}
+	u8g2_esp32_spi_rewind();
+} // u8g2_esp32_hal_wait_done
+
+/*
+ * Write the collected transfer bytes to the display as one I2C write:
+ * start, address, data and stop.
+ */
+static void u8g2_esp32_i2c_flush(u8x8_t *u8x8) {
+	i2c_cmd_handle_t handle_i2c = i2c_cmd_link_create();
+	ESP_ERROR_CHECK(i2c_master_start(handle_i2c));
+	ESP_ERROR_CHECK(i2c_master_write_byte(handle_i2c, u8x8_GetI2CAddress(u8x8) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+	if (i2c_transfer_len > 0) {
+		ESP_ERROR_CHECK(i2c_master_write(handle_i2c, i2c_transfer_buf, i2c_transfer_len, ACK_CHECK_EN));
+	}
+	if (i2c_large_len > 0) {
+		ESP_ERROR_CHECK(i2c_master_write(handle_i2c, i2c_large_ptr, i2c_large_len, ACK_CHECK_EN));
+	}
+	ESP_ERROR_CHECK(i2c_master_stop(handle_i2c));
+	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_MASTER_NUM, handle_i2c, I2C_TIMEOUT_MS / portTICK_RATE_MS));
+	i2c_cmd_link_delete(handle_i2c);
+	i2c_transfer_len = 0;
+	i2c_large_len = 0;
+} // u8g2_esp32_i2c_flush
+
 /*
  * HAL callback function as prescribed by the U8G2 library.  This callback is invoked
  * to handle I2C communications.
@@ -129,6 +288,10 @@ uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 		    ESP_ERROR_CHECK(i2c_param_config(I2C_MASTER_NUM, &conf));
 			ESP_LOGI(TAG, "i2c_driver_install %d", I2C_MASTER_NUM);
 		    ESP_ERROR_CHECK(i2c_driver_install(I2C_MASTER_NUM, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0));
+			// Let the CAD layer send a whole tile row per transfer instead of 24 byte chunks
+			u8x8_SetByteMaxTransfer(u8x8, I2C_MASTER_TRANSFER_BUF_SIZE);
+			// and the SSD1306 send a whole frame with one transfer
+			u8x8_SetByteMaxLargeTransfer(u8x8, I2C_MASTER_LARGE_TRANSFER_SIZE);
 			break;
 		}
 
@@ -136,28 +299,35 @@ uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 			uint8_t* data_ptr = (uint8_t*)arg_ptr;
 			ESP_LOG_BUFFER_HEXDUMP(TAG, data_ptr, arg_int, ESP_LOG_VERBOSE);
 
-			while( arg_int > 0 ) {
-			   ESP_ERROR_CHECK(i2c_master_write_byte(handle_i2c, *data_ptr, ACK_CHECK_EN));
-			   data_ptr++;
-			   arg_int--;
-			}
+			// The CAD layer keeps a transfer within the size set with
+			// u8x8_SetByteMaxTransfer() and sends nothing after a large block.
+			// A transfer can not be split here: the SSD1306 would read the
+			// first byte after a repeated start as its control byte.
+			assert(i2c_transfer_len + arg_int <= sizeof(i2c_transfer_buf) && i2c_large_len == 0);
+			memcpy(&i2c_transfer_buf[i2c_transfer_len], data_ptr, arg_int);
+			i2c_transfer_len += arg_int;
+			break;
+		}
+
+		case U8X8_MSG_BYTE_SEND_LARGE: {
+			u8x8_large_data_t* large = (u8x8_large_data_t*)arg_ptr;
+			// One large block per transfer, after the control byte
+			assert(i2c_large_len == 0);
+			i2c_large_ptr = large->data;
+			i2c_large_len = large->cnt;
 			break;
 		}
 
 		case U8X8_MSG_BYTE_START_TRANSFER: {
-			uint8_t i2c_address = u8x8_GetI2CAddress(u8x8);
-			handle_i2c = i2c_cmd_link_create();
-			ESP_LOGD(TAG, "Start I2C transfer to %02X.", i2c_address>>1);
-			ESP_ERROR_CHECK(i2c_master_start(handle_i2c));
-			ESP_ERROR_CHECK(i2c_master_write_byte(handle_i2c, i2c_address | I2C_MASTER_WRITE, ACK_CHECK_EN));
+			ESP_LOGD(TAG, "Start I2C transfer to %02X.", u8x8_GetI2CAddress(u8x8)>>1);
+			i2c_transfer_len = 0;
+			i2c_large_len = 0;
 			break;
 		}
 
 		case U8X8_MSG_BYTE_END_TRANSFER: {
 			ESP_LOGD(TAG, "End I2C transfer.");
-			ESP_ERROR_CHECK(i2c_master_stop(handle_i2c));
-			ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_MASTER_NUM, handle_i2c, I2C_TIMEOUT_MS / portTICK_RATE_MS));
-			i2c_cmd_link_delete(handle_i2c);
+			u8g2_esp32_i2c_flush(u8x8);
 			break;
 		}
 	}
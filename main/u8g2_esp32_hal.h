@@ -19,6 +19,10 @@
 #define I2C_MASTER_TX_BUF_DISABLE   0      //  I2C master do not need buffer
 #define I2C_MASTER_RX_BUF_DISABLE   0      //  I2C master do not need buffer
 #define I2C_MASTER_FREQ_HZ          50000  //  I2C master clock frequency
+#define I2C_MASTER_TRANSFER_BUF_SIZE 255   //  Max bytes collected per I2C transfer (u8x8 limit)
+#define I2C_MASTER_LARGE_TRANSFER_SIZE 1025 //  Max bytes per I2C transfer with U8X8_MSG_BYTE_SEND_LARGE (control byte and 1 KB frame)
+#define U8G2_ESP32_SPI_QUEUE_SIZE   16     //  SPI transactions queued before the HAL waits for the bus
+#define U8G2_ESP32_SPI_STAGING_SIZE 2048   //  DMA capable bytes for queued SPI transactions, a frame and its commands
 #define ACK_CHECK_EN   0x1                 //  I2C master will check ack from slave
 #define ACK_CHECK_DIS  0x0                 //  I2C master will not check ack from slave
 
@@ -30,12 +34,15 @@ typedef struct {
 	gpio_num_t cs;
 	gpio_num_t reset;
 	gpio_num_t dc;
+	int spi_clock_hz; // 0: the SPI clock of the display (sck_clock_hz)
 } u8g2_esp32_hal_t ;
 
-#define U8G2_ESP32_HAL_DEFAULT {U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED }
+#define U8G2_ESP32_HAL_DEFAULT {U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, 0 }
 
 void u8g2_esp32_hal_init(u8g2_esp32_hal_t u8g2_esp32_hal_param);
 uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+// Returns once all queued display transfers are complete, e.g. before the frame buffer is reused
+void u8g2_esp32_hal_wait_done(void);
 #endif /* U8G2_ESP32_HAL_H_ */
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+#include "esp_log.h"
+#include "ui_console.h"
+#include "ui_flush.h"
+#include "ui_task.h"
+
+#define UI_CONSOLE_TAG "UI Console"
+
+// Defaults for builds without the console enabled in menuconfig
+#ifndef CONFIG_DISPLAY_LOG_CONSOLE_FPS
+#define CONFIG_DISPLAY_LOG_CONSOLE_FPS 10
+#endif
+#ifndef CONFIG_DISPLAY_LOG_CONSOLE_BUFFER_SIZE
+#define CONFIG_DISPLAY_LOG_CONSOLE_BUFFER_SIZE 2048
+#endif
+
+// Lines shown on the display, only touched by the drawing task.
+// u8log scrolls by moving its first line index, not the characters.
+static u8log_t s_log;
+static uint8_t s_log_buf[UI_CONSOLE_WIDTH * UI_CONSOLE_HEIGHT];
+
+// Log output from any task, waiting to be drawn
+static RingbufHandle_t s_log_ring = NULL;
+
+// The vprintf that was installed before us, sends to the UART
+static vprintf_like_t s_uart_vprintf = NULL;
+
+// Messages that did not fit into the ring buffer. Counted without a lock
+// from several tasks, an increment may get lost, it is only for display.
+static volatile uint32_t s_dropped;
+static uint32_t s_dropped_shown;
+
+static bool s_in_escape;        // Skipping an ANSI colour sequence of the log output
+static bool s_redraw;           // Last frame was dropped by the flush task, draw it again
+static TickType_t s_last_frame; // When the console was last drawn
+
+// Calls the UART vprintf with arguments of our own
+static int ui_console_uart_printf(vprintf_like_t uart, const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = uart(fmt, args);
+    va_end(args);
+    return len;
+}
+
+// Log hook, runs in the logging task. Formats the message once, hands a
+// copy to the console without waiting for the drawing task and passes the
+// formatted text on to the UART. Only messages longer than the console
+// buffer are formatted again, so the UART still gets all of them.
+static int ui_console_vprintf(const char *fmt, va_list args)
+{
+    // ui_console_shut_down() may clear these while a task is logging
+    RingbufHandle_t ring = s_log_ring;
+    vprintf_like_t uart = s_uart_vprintf;
+    char msg[UI_CONSOLE_MAX_MSG_LENGTH];
+    va_list copy;
+    int len;
+
+    if (uart == NULL)
+    {
+        uart = vprintf;
+    }
+    // Output of the drawing and flush tasks (UI Flush, the display
+    // transport of the HAL) only goes to the UART. On the console each
+    // line would wake the next frame, which logs again, and the console
+    // would never go idle.
+    if (ring == NULL || ui_task_is_draw_task() || ui_flush_is_flush_task())
+    {
+        return uart(fmt, args);
+    }
+
+    va_copy(copy, args);
+    len = vsnprintf(msg, sizeof(msg), fmt, copy);
+    va_end(copy);
+
+    if (len > 0)
+    {
+        if (xRingbufferSend(ring, msg, (size_t)len < sizeof(msg) ? (size_t)len : sizeof(msg) - 1, 0) == pdTRUE)
+        {
+            ui_task_request_redraw();
+        }
+        else
+        {
+            s_dropped++;
+        }
+    }
+
+    if (len >= 0 && (size_t)len < sizeof(msg))
+    {
+        return ui_console_uart_printf(uart, "%s", msg);
+    }
+    return uart(fmt, args);
+}
+
+static void ui_console_put(char c)
+{
+    if (s_in_escape)
+    {
+        // Colour sequences end with a letter, e.g. "\033[0;32m"
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+        {
+            s_in_escape = false;
+        }
+        return;
+    }
+    if (c == '\033')
+    {
+        s_in_escape = true;
+        return;
+    }
+    u8log_WriteChar(&s_log, c);
+}
+
+// Moves the waiting log output into the console lines. Takes at most one
+// ring buffer full, so a task logging without pause can't keep us here.
+static void ui_console_take_log(void)
+{
+    size_t taken = 0;
+    size_t len;
+    char *data;
+
+    while (taken < CONFIG_DISPLAY_LOG_CONSOLE_BUFFER_SIZE &&
+           (data = xRingbufferReceiveUpTo(s_log_ring, &len, 0, UI_CONSOLE_MAX_MSG_LENGTH)) != NULL)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            ui_console_put(data[i]);
+        }
+        vRingbufferReturnItem(s_log_ring, data);
+        taken += len;
+    }
+
+    uint32_t dropped = s_dropped;
+    if (dropped != s_dropped_shown)
+    {
+        char note[32];
+        snprintf(note, sizeof(note), "-- %u dropped --\n", (unsigned)(dropped - s_dropped_shown));
+        u8log_WriteString(&s_log, note);
+        s_dropped_shown = dropped;
+    }
+}
+
+TickType_t ui_console_refresh(u8g2_t *u8g2)
+{
+    TickType_t frameTicks = pdMS_TO_TICKS(1000 / CONFIG_DISPLAY_LOG_CONSOLE_FPS);
+    TickType_t sinceLast = xTaskGetTickCount() - s_last_frame;
+
+    if (s_log_ring == NULL)
+    {
+        return portMAX_DELAY;
+    }
+
+    // Lines logged faster than the frame rate wait and are drawn together
+    if (sinceLast < frameTicks)
+    {
+        return frameTicks - sinceLast;
+    }
+
+    ui_console_take_log();
+    if (!u8log_Redraw(&s_log) && !s_redraw)
+    {
+        // Nothing new, the log hook wakes us for the next line
+        return portMAX_DELAY;
+    }
+    s_last_frame = xTaskGetTickCount();
+
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SetFont(u8g2, u8g2_font_5x7_tr);
+    u8g2_DrawLog(u8g2, 0, u8g2_GetAscent(u8g2), &s_log);
+    s_redraw = !ui_flush_submit(u8g2);
+
+    return portMAX_DELAY;
+}
+
+void ui_console_start_up(void)
+{
+    u8log_Init(&s_log, UI_CONSOLE_WIDTH, UI_CONSOLE_HEIGHT, s_log_buf);
+    // Lines are only marked as changed, ui_console_refresh draws them at the frame rate
+    u8log_SetRedrawDeferred(&s_log, 1);
+
+    s_log_ring = xRingbufferCreate(CONFIG_DISPLAY_LOG_CONSOLE_BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF);
+    if (s_log_ring == NULL)
+    {
+        ESP_LOGE(UI_CONSOLE_TAG, "%s ring buffer create failed", __func__);
+        return;
+    }
+    s_uart_vprintf = esp_log_set_vprintf(ui_console_vprintf);
+    ESP_LOGI(UI_CONSOLE_TAG, "Log console started");
+}
+
+void ui_console_shut_down(void)
+{
+    RingbufHandle_t ring = s_log_ring;
+
+    // Remove the hook before the ring buffer it writes to
+    if (s_uart_vprintf)
+    {
+        esp_log_set_vprintf(s_uart_vprintf);
+        s_uart_vprintf = NULL;
+    }
+    s_log_ring = NULL;
+    if (ring)
+    {
+        vRingbufferDelete(ring);
+    }
+}
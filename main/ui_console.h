@@ -0,0 +1,35 @@
+/*
+    Field diagnostics console. Mirrors ESP_LOG
+    output onto the display through u8log, in
+    place of the normal screens.
+*/
+
+#ifndef __UI_CONSOLE_H__
+#define __UI_CONSOLE_H__
+
+#include "freertos/FreeRTOS.h"
+#include <u8g2.h>
+
+// 25 columns by 9 lines of the 5x7 font on the 128x64 display
+#define UI_CONSOLE_WIDTH 25
+#define UI_CONSOLE_HEIGHT 9
+
+// Longest log message copied to the console, longer ones are cut short
+#define UI_CONSOLE_MAX_MSG_LENGTH 128
+
+// Installs the log hook. Log output still goes to the UART, a copy is
+// queued for the console without ever blocking the logging task. Output
+// of the drawing and flush tasks is not copied, drawing the console
+// would otherwise log more lines for it.
+void ui_console_start_up(void);
+
+// Removes the log hook
+void ui_console_shut_down(void);
+
+// Takes the queued log output and, if the console changed, draws it and
+// submits the frame. Redraws are limited to CONFIG_DISPLAY_LOG_CONSOLE_FPS
+// however often this is called. Returns ticks until it should be called
+// again (portMAX_DELAY if no log output is waiting)
+TickType_t ui_console_refresh(u8g2_t *u8g2);
+
+#endif /* __UI_CONSOLE_H__ */
@@ -9,11 +9,37 @@
 #include "esp_ota_ops.h"
 #include "u8g2_esp32_hal.h"
 #include "bt_app_core.h"
+#include "ui_task.h"
+#include "ui_flush.h"
+#include "ui_scroll.h"
+#include "ui_console.h"
 
 #define UI_CONTROLLER_TAG "UI Cont"
 
 u8g2_t u8g2; // a structure which will contain all the data for one display
 
+// Copy of the last frame sent to the display, lets refresh only send changed tiles
+static uint8_t shadow_buf[UI_FRAME_BUFFER_SIZE];
+
+// Decoded glyphs, our screens keep drawing the same few dozen characters.
+// An entry is 48 bytes on the ESP32, the cache takes about 3 KB.
+#define UI_GLYPH_CACHE_ENTRIES 64
+static u8g2_glyph_cache_t glyph_cache;
+static u8g2_glyph_cache_entry_t glyph_cache_entries[UI_GLYPH_CACHE_ENTRIES];
+
+// Laid out centred labels, the n-th label of a screen keeps slot n so a
+// label is only measured again when its text or font changes
+#define UI_TEXT_SLOTS 4
+static u8g2_text_t text_slots[UI_TEXT_SLOTS];
+static uint8_t next_text_slot;
+
+#ifdef CONFIG_DISPLAY_WRAP_TRACK_TEXT
+// Artist, title and album wrapped into lines, laid out again only when they change
+#define UI_TRACK_TEXT_LINES 3
+#define UI_TRACK_BOXES 3
+static u8g2_text_box_t track_boxes[UI_TRACK_BOXES];
+#endif
+
 // mutex around the state structure
 static portMUX_TYPE state_mutex = portMUX_INITIALIZER_UNLOCKED;
 
@@ -39,81 +65,52 @@ typedef struct ui_current_state
 
 ui_current_state_t current_state;
 
-void ui_controller_refresh();
-
-/*********************
- * Screen drawing functions
- * *******************/
-
-/** Scrolling Text **/
-
-// Represents a single line of text that scrolls
-// if it's longer than the display.
-typedef struct ui_scrolling_text
-{
-    uint8_t *font;                      // font used to draw text
-    char str[MAX_STR_ATTRIBUTE_LENGTH]; // text to draw
-    u8g2_uint_t y;                      // bottom of the text line in pixels
-    uint16_t strWidth;                  // Calculated width of string in pixels
-    uint16_t x;                         // current x pos of start of text line
-} ui_scrolling_text_t;
-
-// Just one line for testing
+// Private copy of the model the screen is drawn from, taken under state_mutex
+// so rendering runs with interrupts enabled and never sees a half written update
+static ui_current_state_t drawn_state;
+static ui_rcvr_state_t drawn_rcvr_state;
 
-ui_scrolling_text_t scrollLine;
+TickType_t ui_controller_refresh();
 
-// TODO: will probably need to add delay at start and end of scroll
+// Ticks until the screen being drawn wants its next frame
+static TickType_t next_frame_delay;
 
-void ui_controller_scroll_line(ui_scrolling_text_t line)
+// Called by animated screens to ask for another frame, the earliest request wins
+static void ui_request_frame(TickType_t delay)
 {
-    //const uint8_t *origFont = u8g2.font;
-    //    u8g2_SetFont(&u8g2, line.font);
-
-    // Move left or reset x to 0?
-    if (line.strWidth - line.x == u8g2_GetDisplayWidth(&u8g2))
-    {
-        line.x = 0;
-    }
-    else
+    if (delay < next_frame_delay)
     {
-        line.x++;
+        next_frame_delay = delay;
     }
-
-    u8g2_DrawStr(&u8g2, -line.x, line.y, line.str);
-    //   u8g2_SetFont(&u8g2, origFont);
 }
 
-// Scrolls any scrolling text (just one line for testing)
-void ui_controller_scroll_text()
+/*********************
+ * Screen drawing functions
+ * *******************/
+
+/** Drawing helpers **/
+
+void drawStrCentered(u8g2_uint_t y, const char *str)
 {
-    if (strnlen(scrollLine.str, MAX_STR_ATTRIBUTE_LENGTH) > 0)
+    if (next_text_slot >= UI_TEXT_SLOTS)
     {
-        ui_controller_scroll_line(scrollLine);
+        uint16_t strWidth = u8g2_GetStrWidth(&u8g2, str);
+        int16_t x = (u8g2_GetDisplayWidth(&u8g2) - strWidth) / 2;
+        u8g2_DrawStr(&u8g2, x, y, str);
+        return;
     }
-}
 
-//
-void drawScrollingText(u8g2_uint_t y, const char *str)
-{
-    scrollLine.font = (uint8_t *)u8g2.font;
-    strlcpy(str, scrollLine.str, MAX_STR_ATTRIBUTE_LENGTH);
-    scrollLine.y = y;
-    scrollLine.strWidth = u8g2_GetStrWidth(&u8g2, str);
-    scrollLine.x = 0;
+    u8g2_text_t *text = &text_slots[next_text_slot++];
+    uint16_t strWidth = u8g2_LayoutStr(&u8g2, text, str);
+    int16_t x = (u8g2_GetDisplayWidth(&u8g2) - strWidth) / 2;
+    u8g2_DrawText(&u8g2, x, y, text);
 }
 
-void stopScrollingText()
+// Centres str if it fits across the display, otherwise scrolls it.
+// line is the scrolling slot, each line on screen needs its own.
+void drawStrScrolling(uint8_t line, u8g2_uint_t y, const char *str)
 {
-    scrollLine.str[0] = NULL;
-}
-
-/** Drawing helpers **/
-
-void drawStrCentered(u8g2_uint_t y, const char *str)
-{
-    uint16_t strWidth = u8g2_GetStrWidth(&u8g2, str);
-    int16_t x = (u8g2_GetDisplayWidth(&u8g2) - strWidth) / 2;
-    u8g2_DrawStr(&u8g2, x, y, str);
+    ui_request_frame(ui_scroll_draw(&u8g2, line, y, str));
 }
 
 // Draws a narrow progress bar at bottom of display, 4 pixels high
@@ -148,19 +145,21 @@ void ui_show_discoverable()
 
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2), "Discoverable as");
     //drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, "as");
-    //drawScrollingText(u8g2_GetMaxCharHeight(&u8g2) * 3, current_state.hostName);
-    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, current_state.hostName);
+    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, drawn_state.hostName);
 
-    if (strnlen(current_state.pairingPINnum, 7) > (size_t)0)
+    if (strnlen(drawn_state.pairingPINnum, 7) > (size_t)0)
     {
-        drawStrCentered(u8g2_GetDisplayHeight(&u8g2) * 3, current_state.pairingPINnum);
+        drawStrCentered(u8g2_GetDisplayHeight(&u8g2) * 3, drawn_state.pairingPINnum);
     }
 
     // Show countdown to timeout of discovery mode
-    TickType_t ellapsedTicks = (xTaskGetTickCount() - current_state.changedAt);
+    TickType_t ellapsedTicks = (xTaskGetTickCount() - drawn_state.changedAt);
     TickType_t totalTicks = pdMS_TO_TICKS(CONFIG_DISCOVERY_MODE_DURATION * 1000);
     uint8_t percentLeft = (uint8_t)((totalTicks - ellapsedTicks) / (totalTicks / 100));
     ui_show_progress_bar(percentLeft);
+
+    // Redraw when the bar is due to shrink by a pixel
+    ui_request_frame(totalTicks / u8g2_GetDisplayWidth(&u8g2));
 }
 
 void ui_show_connected()
@@ -168,7 +167,7 @@ void ui_show_connected()
     u8g2_SetFont(&u8g2, u8g2_font_unifont_t_symbols);
 
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2), "Connected to");
-    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, current_state.connectedTo);
+    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, drawn_state.connectedTo);
 }
 
 void ui_show_disconnected()
@@ -187,25 +186,49 @@ void ui_show_disconnected()
     drawStrCentered(u8g2_GetDisplayHeight(&u8g2), "24:36");
 }
 
+#ifdef CONFIG_DISPLAY_WRAP_TRACK_TEXT
+// Title gets up to two lines, artist one, album whatever is left
+void drawTrackWrapped()
+{
+    u8g2_uint_t lineHeight = u8g2_GetMaxCharHeight(&u8g2);
+    u8g2_uint_t width = u8g2_GetDisplayWidth(&u8g2);
+    uint8_t row = 1;
+
+    uint8_t artistLines = u8g2_LayoutUTF8Box(&u8g2, &track_boxes[0], drawn_state.artist, width, 1);
+    uint8_t titleLines = u8g2_LayoutUTF8Box(&u8g2, &track_boxes[1], drawn_state.title, width, UI_TRACK_TEXT_LINES - 1);
+    u8g2_LayoutUTF8Box(&u8g2, &track_boxes[2], drawn_state.album, width, UI_TRACK_TEXT_LINES - artistLines - titleLines);
+
+    for (int i = 0; i < UI_TRACK_BOXES; i++)
+    {
+        u8g2_DrawTextBox(&u8g2, 0, lineHeight * row, lineHeight, &track_boxes[i], U8G2_TEXT_ALIGN_CENTER);
+        row += track_boxes[i].line_cnt;
+    }
+}
+#endif
+
 void ui_show_track()
 {
     u8g2_SetFont(&u8g2, u8g2_font_unifont_t_symbols);
 
-    if (strcmp(current_state.title, "") == 0)
+    if (strcmp(drawn_state.title, "") == 0)
     {
         drawStrCentered(u8g2_GetMaxCharHeight(&u8g2), "Playing...");
     }
     else
     {
-        drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 1, current_state.artist);
-        drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, current_state.title);
-        drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 3, current_state.album);
+#ifdef CONFIG_DISPLAY_WRAP_TRACK_TEXT
+        drawTrackWrapped();
+#else
+        drawStrScrolling(0, u8g2_GetMaxCharHeight(&u8g2) * 1, drawn_state.artist);
+        drawStrScrolling(1, u8g2_GetMaxCharHeight(&u8g2) * 2, drawn_state.title);
+        drawStrScrolling(2, u8g2_GetMaxCharHeight(&u8g2) * 3, drawn_state.album);
+#endif
 
         // Avoid divide by zero (no guarantee duration is set)
-        if (current_state.trackDuration > (uint32_t)100)
+        if (drawn_state.trackDuration > (uint32_t)100)
         {
             // Times in ms, don't need this resolution, rather than mul numerator by 100, divide denominator by 100
-            uint8_t progress = current_state.trackPosition / (current_state.trackDuration / (uint32_t)100);
+            uint8_t progress = drawn_state.trackPosition / (drawn_state.trackDuration / (uint32_t)100);
             ui_show_progress_bar(progress);
         }
     }
@@ -225,10 +248,10 @@ void ui_show_pairing()
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 1, "Pairing");
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, "PIN");
 
-    if (strnlen(current_state.pairingPINnum, 7) > (size_t)0)
+    if (strnlen(drawn_state.pairingPINnum, 7) > (size_t)0)
     {
         u8g2_SetFont(&u8g2, u8g2_font_osr21_tn);
-        drawStrCentered(u8g2_GetDisplayHeight(&u8g2), current_state.pairingPINnum);
+        drawStrCentered(u8g2_GetDisplayHeight(&u8g2), drawn_state.pairingPINnum);
     }
 }
 
@@ -239,18 +262,29 @@ void ui_show_paired()
 
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 1, "Paired");
     drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 2, "with");
-    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 3, current_state.pairedWith);
+    drawStrCentered(u8g2_GetMaxCharHeight(&u8g2) * 3, drawn_state.pairedWith);
 }
 
 // Draws screen, driven by current state
-void ui_controller_refresh()
+TickType_t ui_controller_refresh()
 {
-    u8g2_ClearBuffer(&u8g2);
+#ifdef CONFIG_DISPLAY_LOG_CONSOLE
+    // Field diagnostics, the log replaces the normal screens
+    return ui_console_refresh(&u8g2);
+#endif
 
-    // Lock the state model
+    next_frame_delay = portMAX_DELAY;
+
+    // Lock the state model just long enough to take a copy
     portENTER_CRITICAL(&state_mutex);
+    drawn_state = current_state;
+    drawn_rcvr_state = rcvr_state;
+    portEXIT_CRITICAL(&state_mutex);
 
-    switch (rcvr_state)
+    u8g2_ClearBuffer(&u8g2);
+    next_text_slot = 0;
+
+    switch (drawn_rcvr_state)
     {
     case RCVR_STATE_CONNECTED:
         ui_show_connected();
@@ -281,11 +315,10 @@ void ui_controller_refresh()
         break;
     }
 
-    // ui_controller_scroll_text();
-
-    portEXIT_CRITICAL(&state_mutex);
+    // Sent by the flush task while the next frame is drawn
+    ui_flush_submit(&u8g2);
 
-    u8g2_SendBuffer(&u8g2);
+    return next_frame_delay;
 }
 
 // Turns off discovery mode when called from timer
@@ -301,7 +334,6 @@ void discovery_off_timer_cb(xTimerHandle timer)
 void ui_controller_dispatch(ui_msg_t *msg)
 {
     TimerHandle_t timer;
-    uint8_t copyOffset;
 
     ESP_LOGI(UI_CONTROLLER_TAG, "Dispatch");
 
@@ -332,17 +364,7 @@ void ui_controller_dispatch(ui_msg_t *msg)
         break;
     case UI_EVT_DISCOVERABLE:
         rcvr_state = RCVR_STATE_DISCOVERABLE;
-        strlcpy(current_state.pairingPINnum, (char *)param->text_rsp.evt_text, MAX_STR_ATTRIBUTE_LENGTH);
-        // Start timer to stop discoverable after the period
-        // defined in the config file.
-        timer = xTimerCreate(
-            "timer",
-            // Config duration is in seconds
-            pdMS_TO_TICKS(CONFIG_DISCOVERY_MODE_DURATION * 1000),
-            pdFALSE,                 // single shot
-            (void *)1,               // timer ID
-            discovery_off_timer_cb); // callback
-        xTimerStart(timer, 0);       // block time = 0
+        strlcpy(current_state.pairingPINnum, (char *)param->text_rsp.evt_text, 7);
         break;
     case UI_EVT_CONNECTED:
         rcvr_state = RCVR_STATE_CONNECTED;
@@ -350,11 +372,11 @@ void ui_controller_dispatch(ui_msg_t *msg)
         break;
     case UI_EVT_DISCONNECTED:
         rcvr_state = RCVR_STATE_DISCONNECTED;
-        current_state.connectedTo[0] = NULL;
+        current_state.connectedTo[0] = '\0';
         break;
     case UI_EVT_PAIRED_FAIL:
         rcvr_state = RCVR_STATE_PAIRED_FAIL;
-        current_state.pairingPINnum[0] = NULL;
+        current_state.pairingPINnum[0] = '\0';
         break;
     case UI_EVT_PAIRED_OK:
         rcvr_state = RCVR_STATE_PAIRED;
@@ -366,7 +388,7 @@ void ui_controller_dispatch(ui_msg_t *msg)
         // {
         //     strlcpy(current_state.pairedWith, "No Name", MAX_STR_ATTRIBUTE_LENGTH);
         // }
-        current_state.pairingPINnum[0] = NULL;
+        current_state.pairingPINnum[0] = '\0';
         break;
     case UI_EVT_PAIRING_AUTH:
         rcvr_state = RCVR_STATE_PARING;
@@ -396,12 +418,29 @@ void ui_controller_dispatch(ui_msg_t *msg)
         strlcpy(current_state.title, (char *)param->text_rsp.evt_text, MAX_STR_ATTRIBUTE_LENGTH);
         break;
     default:
-        ui_show_about();
         break;
     }
 
     portEXIT_CRITICAL(&state_mutex);
 
+    if (msg->event == UI_EVT_DISCOVERABLE)
+    {
+        // Start timer to stop discoverable after the period
+        // defined in the config file. Created outside the critical
+        // section, the timer API may block.
+        timer = xTimerCreate(
+            "timer",
+            // Config duration is in seconds
+            pdMS_TO_TICKS(CONFIG_DISCOVERY_MODE_DURATION * 1000),
+            pdFALSE,                 // single shot
+            (void *)1,               // timer ID
+            discovery_off_timer_cb); // callback
+        xTimerStart(timer, 0);       // block time = 0
+    }
+
+    // Model has changed, get it drawn
+    ui_task_request_redraw();
+
     // if(msg->event == UI_EVT_DISCOVERABLE)
     // {
     //     vTaskStartScheduler();
@@ -433,4 +472,15 @@ void ui_controller_init()
     u8g2_SetPowerSave(&u8g2, 0); // wake up display
     // Initialise lowish brightness
     u8g2_SetContrast(&u8g2, 64);
+
+    // Enable dirty tile tracking, first refresh sends the whole frame
+    u8g2_SetShadowBufferPtr(&u8g2, shadow_buf);
+
+    u8g2_SetGlyphCache(&u8g2, &glyph_cache, glyph_cache_entries, UI_GLYPH_CACHE_ENTRIES);
+
+    ui_flush_start_up(&u8g2);
+
+#ifdef CONFIG_DISPLAY_LOG_CONSOLE
+    ui_console_start_up();
+#endif
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #ifndef __UI_CONTROLLER_H__
 #define __UI_CONTROLLER_H__
 
+#include "freertos/FreeRTOS.h"
 #include "ui_events.h"
 
 void ui_controller_init();
@@ -13,7 +14,8 @@ void ui_controller_init();
 // Updates the model in response to events
 void ui_controller_dispatch(ui_msg_t *msg);
 
-// Writes the model to the display
-void ui_controller_refresh();
+// Writes the model to the display, returns ticks until the
+// screen needs redrawing again (portMAX_DELAY if static)
+TickType_t ui_controller_refresh();
 
 #endif /* __UI_CONTROLLER_H__*/
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "u8g2_esp32_hal.h"
+#include "ui_flush.h"
+#include "ui_task.h"
+
+#define UI_FLUSH_TAG "UI Flush"
+
+// Second frame buffer, used alongside the u8g2 tile buffer
+static uint8_t spare_buf[UI_FRAME_BUFFER_SIZE];
+
+static xTaskHandle s_flush_task_handle = NULL;
+static u8g2_t *s_u8g2 = NULL;
+
+// Buffer that is not being drawn into or sent, the next frame is drawn here
+static uint8_t *s_idle_frame = spare_buf;
+
+// Guards the hand over between drawing and flush tasks, only held for a few instructions
+static portMUX_TYPE flush_mutex = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t *s_flush_frame = NULL; // Frame owned by the flush task, NULL when idle
+static bool s_frame_dropped = false;  // A frame was submitted while the flush task was busy
+
+// Sends each frame handed over by ui_flush_submit
+static void ui_flush_handler(void *arg)
+{
+    uint8_t *frame;
+    bool redraw;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        portENTER_CRITICAL(&flush_mutex);
+        frame = s_flush_frame;
+        portEXIT_CRITICAL(&flush_mutex);
+
+        if (frame == NULL)
+        {
+            continue;
+        }
+
+        // Only changed 8x8 tiles go over the display bus
+        uint16_t tiles = u8g2_SendFrameChanged(s_u8g2, frame);
+        // The SPI transport queues its transfers, the flush is only reported done once they are on the display
+        u8g2_esp32_hal_wait_done();
+        ESP_LOGV(UI_FLUSH_TAG, "Flush sent %d bytes", tiles * 8);
+
+        portENTER_CRITICAL(&flush_mutex);
+        s_flush_frame = NULL;
+        redraw = s_frame_dropped;
+        s_frame_dropped = false;
+        portEXIT_CRITICAL(&flush_mutex);
+
+        // A newer frame was dropped while sending, get it drawn again
+        if (redraw)
+        {
+            ui_task_request_redraw();
+        }
+    }
+}
+
+bool ui_flush_submit(u8g2_t *u8g2)
+{
+    bool busy;
+    uint8_t *frame = u8g2_GetBufferPtr(u8g2);
+
+    portENTER_CRITICAL(&flush_mutex);
+    busy = (s_flush_frame != NULL);
+    if (busy)
+    {
+        s_frame_dropped = true;
+    }
+    else
+    {
+        s_flush_frame = frame;
+    }
+    portEXIT_CRITICAL(&flush_mutex);
+
+    if (busy)
+    {
+        ESP_LOGD(UI_FLUSH_TAG, "Frame dropped, flush in progress");
+        return false;
+    }
+
+    // The flush task is idle so the buffer it sent last is free to draw into
+    u8g2_SwapBufferPtr(u8g2, s_idle_frame);
+    s_idle_frame = frame;
+
+    xTaskNotifyGive(s_flush_task_handle);
+    return true;
+}
+
+bool ui_flush_is_flush_task(void)
+{
+    return s_flush_task_handle != NULL && xTaskGetCurrentTaskHandle() == s_flush_task_handle;
+}
+
+void ui_flush_start_up(u8g2_t *u8g2)
+{
+    s_u8g2 = u8g2;
+    xTaskCreate(ui_flush_handler, "UI_Flush_Screen", 2048, NULL, configMAX_PRIORITIES - 5, &s_flush_task_handle);
+}
+
+void ui_flush_shut_down(void)
+{
+    if (s_flush_task_handle)
+    {
+        vTaskDelete(s_flush_task_handle);
+        s_flush_task_handle = NULL;
+    }
+}
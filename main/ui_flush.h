@@ -0,0 +1,30 @@
+/*
+    Sends completed frames to the display from
+    its own task, so drawing the next frame does
+    not wait for the display bus.
+*/
+
+#ifndef __UI_FLUSH_H__
+#define __UI_FLUSH_H__
+
+#include <stdbool.h>
+#include <u8g2.h>
+
+// Size of one frame for the 128x64 display
+#define UI_FRAME_BUFFER_SIZE (128 * 64 / 8)
+
+// Creates the flush task, the display must already be initialised
+void ui_flush_start_up(u8g2_t *u8g2);
+
+void ui_flush_shut_down(void);
+
+// Hands the frame in the u8g2 tile buffer to the flush task and gives
+// u8g2 a free buffer to draw the next frame into. If the previous frame
+// is still being sent the new frame is dropped and a redraw is requested
+// once the display bus is free. Returns false if the frame was dropped.
+bool ui_flush_submit(u8g2_t *u8g2);
+
+// True when called from the flush task
+bool ui_flush_is_flush_task(void);
+
+#endif /* __UI_FLUSH_H__ */
@@ -0,0 +1,109 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "ui_scroll.h"
+
+#define UI_SCROLL_TAG "UI Scroll"
+
+typedef struct ui_scroll_line
+{
+    const uint8_t *font;               // font the strip was rendered with
+    char str[UI_SCROLL_MAX_STR_LENGTH]; // string held in the strip
+    u8g2_strip_t strip;                // rendered string
+    TickType_t startedAt;              // when the line started scrolling
+    uint8_t speed;                     // pixels per second
+    uint16_t pauseMs;                  // wait at each end in ms
+    uint8_t buf[UI_SCROLL_STRIP_SIZE]; // strip memory
+} ui_scroll_line_t;
+
+static ui_scroll_line_t lines[UI_SCROLL_MAX_LINES];
+
+// Works out the strip offset for the time elapsed, and ms until it changes
+static uint16_t ui_scroll_offset(const ui_scroll_line_t *line, uint16_t travel, uint32_t *nextMs)
+{
+    uint32_t travelMs = (uint32_t)travel * 1000 / line->speed;
+    uint32_t cycleMs = 2 * (uint32_t)line->pauseMs + travelMs;
+    uint32_t t = ((xTaskGetTickCount() - line->startedAt) * portTICK_PERIOD_MS) % cycleMs;
+    uint16_t offset;
+
+    if (t < line->pauseMs)
+    {
+        // Waiting at the start
+        *nextMs = line->pauseMs - t;
+        return 0;
+    }
+
+    t -= line->pauseMs;
+    if (t < travelMs)
+    {
+        // Moving, next frame when the text has moved another pixel
+        offset = t * line->speed / 1000;
+        *nextMs = ((uint32_t)(offset + 1) * 1000 + line->speed - 1) / line->speed - t;
+        return offset;
+    }
+
+    // Waiting at the end
+    *nextMs = cycleMs - line->pauseMs - t;
+    return travel;
+}
+
+TickType_t ui_scroll_draw(u8g2_t *u8g2, uint8_t line, u8g2_uint_t y, const char *str)
+{
+    if (line >= UI_SCROLL_MAX_LINES)
+    {
+        return portMAX_DELAY;
+    }
+
+    ui_scroll_line_t *l = &lines[line];
+    uint16_t dw = u8g2_GetDisplayWidth(u8g2);
+
+    // Only decode the glyphs again when the text changes
+    if (l->font != u8g2->font || strncmp(l->str, str, UI_SCROLL_MAX_STR_LENGTH) != 0)
+    {
+        l->font = u8g2->font;
+        strlcpy(l->str, str, UI_SCROLL_MAX_STR_LENGTH);
+        u8g2_DrawStrStrip(u8g2, &l->strip, l->buf, UI_SCROLL_STRIP_SIZE, l->str);
+        l->startedAt = xTaskGetTickCount();
+        ESP_LOGD(UI_SCROLL_TAG, "Line %d rendered, %d pixels", line, l->strip.width);
+    }
+
+    u8g2_uint_t top = y - l->strip.ascent;
+
+    if (l->strip.width <= dw)
+    {
+        u8g2_DrawStrip(u8g2, (dw - l->strip.width) / 2, top, l->strip.width, &l->strip, 0);
+        return portMAX_DELAY;
+    }
+
+    if (l->speed == 0)
+    {
+        l->speed = UI_SCROLL_DEFAULT_SPEED;
+        l->pauseMs = UI_SCROLL_DEFAULT_PAUSE_MS;
+    }
+
+    uint32_t nextMs;
+    uint16_t offset = ui_scroll_offset(l, l->strip.width - dw, &nextMs);
+    u8g2_DrawStrip(u8g2, 0, top, dw, &l->strip, offset);
+
+    TickType_t delay = pdMS_TO_TICKS(nextMs);
+    return delay > 0 ? delay : 1;
+}
+
+void ui_scroll_set_speed(uint8_t line, uint8_t pixelsPerSecond, uint16_t pauseMs)
+{
+    if (line < UI_SCROLL_MAX_LINES && pixelsPerSecond > 0)
+    {
+        lines[line].speed = pixelsPerSecond;
+        lines[line].pauseMs = pauseMs;
+    }
+}
+
+void ui_scroll_reset(void)
+{
+    for (uint8_t i = 0; i < UI_SCROLL_MAX_LINES; i++)
+    {
+        lines[i].font = NULL;
+        lines[i].str[0] = '\0';
+    }
+}
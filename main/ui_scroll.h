@@ -0,0 +1,38 @@
+/*
+    Scrolling text lines. Each line's string is
+    rendered once into an off-screen strip, each
+    frame then only copies the visible window of
+    the strip into the frame buffer.
+*/
+
+#ifndef __UI_SCROLL_H__
+#define __UI_SCROLL_H__
+
+#include "freertos/FreeRTOS.h"
+#include <u8g2.h>
+
+// Number of lines that can scroll at the same time
+#define UI_SCROLL_MAX_LINES 3
+
+#define UI_SCROLL_MAX_STR_LENGTH 80
+
+// Room for 80 unifont chars, 6 display widths by 2 tile rows
+#define UI_SCROLL_STRIP_SIZE (6 * 2 * 128)
+
+#define UI_SCROLL_DEFAULT_SPEED 24     // pixels per second
+#define UI_SCROLL_DEFAULT_PAUSE_MS 1500 // time spent at each end
+
+// Draws str with the current font and its baseline at y. Text that fits
+// is centred, wider text scrolls back and forth, pausing at each end.
+// line selects the slot (0 to UI_SCROLL_MAX_LINES - 1) that keeps the
+// rendered strip, it is only re-rendered when the string or font changes.
+// Returns ticks until the line needs drawing again (portMAX_DELAY if static)
+TickType_t ui_scroll_draw(u8g2_t *u8g2, uint8_t line, u8g2_uint_t y, const char *str);
+
+// Sets how fast a line scrolls and how long it waits at each end
+void ui_scroll_set_speed(uint8_t line, uint8_t pixelsPerSecond, uint16_t pauseMs);
+
+// Forgets all lines, they restart from the beginning when next drawn
+void ui_scroll_reset(void);
+
+#endif /* __UI_SCROLL_H__ */
@@ -11,6 +11,8 @@
 #include "esp_log.h"
 #include "ui_task.h"
 #include "ui_controller.h"
+#include "ui_flush.h"
+#include "ui_console.h"
 
 // Update display in response to message
 static bool ui_send_msg(ui_msg_t *msg);
@@ -18,6 +20,7 @@ static void ui_work_dispatched(ui_msg_t *msg);
 
 static xQueueHandle s_ui_task_queue = NULL;
 static xTaskHandle s_ui_task_handle = NULL;
+static xTaskHandle s_ui_draw_task_handle = NULL;
 
 /***************************************************************
  * Screen drawing tasks
@@ -25,16 +28,32 @@ static xTaskHandle s_ui_task_handle = NULL;
  * These call the ui controller as necessary.
  * *************************************************************/
 
-// Draw the screen every 50ms
+// Draw the screen when the model changes or when an
+// animated screen's next frame is due
 static void ui_draw_handler(void *arg)
 {
+    TickType_t frameDelay = 0; // Draw the first frame straight away
+
     for (;;)
     {
-        ui_controller_refresh();
-        vTaskDelay(50 / portTICK_PERIOD_MS);
+        ulTaskNotifyTake(pdTRUE, frameDelay);
+        frameDelay = ui_controller_refresh();
+    }
+}
+
+void ui_task_request_redraw(void)
+{
+    if (s_ui_draw_task_handle)
+    {
+        xTaskNotifyGive(s_ui_draw_task_handle);
     }
 }
 
+bool ui_task_is_draw_task(void)
+{
+    return s_ui_draw_task_handle != NULL && xTaskGetCurrentTaskHandle() == s_ui_draw_task_handle;
+}
+
 /***************************************************************
  * Dispatcher functions for UI update events.
  * 
@@ -83,11 +102,18 @@ void ui_task_start_up(void)
 
     s_ui_task_queue = xQueueCreate(10, sizeof(ui_msg_t));
     xTaskCreate(ui_model_update_handler, "UI_Model_Update", 2048, NULL, configMAX_PRIORITIES - 5, &s_ui_task_handle);
-    xTaskCreate(ui_draw_handler, "UI_Draw_Screen", 2048, NULL, configMAX_PRIORITIES - 5, NULL);
+    xTaskCreate(ui_draw_handler, "UI_Draw_Screen", 2048, NULL, configMAX_PRIORITIES - 5, &s_ui_draw_task_handle);
 }
 
 void ui_task_shut_down(void)
 {
+    ui_console_shut_down();
+    ui_flush_shut_down();
+    if (s_ui_draw_task_handle)
+    {
+        vTaskDelete(s_ui_draw_task_handle);
+        s_ui_draw_task_handle = NULL;
+    }
     if (s_ui_task_handle)
     {
         vTaskDelete(s_ui_task_handle);
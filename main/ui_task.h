@@ -38,6 +38,16 @@ void ui_task_start_up(void);
 
 void ui_task_shut_down(void);
 
+/**
+ * @brief     wakes the drawing task to redraw the screen
+ */
+void ui_task_request_redraw(void);
+
+/**
+ * @brief     true when called from the drawing task
+ */
+bool ui_task_is_draw_task(void);
+
 void ui_copyStrToTextParam(esp_ui_param_t *params, const uint8_t *str);
 
 #endif /* __UI_TASK_H__ */